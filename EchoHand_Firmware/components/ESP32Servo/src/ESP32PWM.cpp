@@ -209,6 +209,14 @@ void ESP32PWM::write(uint32_t duty) {
 	ledcWrite(getChannel(), duty);
 #endif
 }
+void ESP32PWM::writeFast(uint32_t duty) {
+	myDuty = duty;
+	// LEDC channels are numbered 8 per speed mode group, same split ledcWrite does after its pin lookup
+	ledc_mode_t group = (ledc_mode_t) (pwmChannel / 8);
+	ledc_channel_t channel = (ledc_channel_t) (pwmChannel % 8);
+	ledc_set_duty(group, channel, duty);
+	ledc_update_duty(group, channel);
+}
 void ESP32PWM::adjustFrequencyLocal(double freq, double dutyScaled) {
 	timerFreqSet[getTimer()] = (long) freq;
 	myFreq = freq;
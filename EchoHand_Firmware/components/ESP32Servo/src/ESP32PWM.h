@@ -11,6 +11,7 @@
 #if defined(ARDUINO)
 	#include "Arduino.h"
 #endif
+#include "driver/ledc.h"
 
 #if defined(CONFIG_IDF_TARGET_ESP32C3)
 #define NUM_PWM 6
@@ -69,6 +70,8 @@ public:
 
 	// write raw duty cycle
 	void write(uint32_t duty);
+	// write raw duty cycle straight to the LEDC channel, no pin lookup and no floating point
+	void writeFast(uint32_t duty);
 	// Write a duty cycle to the PWM using a unit vector from 0.0-1.0
 	void writeScaled(double duty);
 	//Adjust frequency
@@ -93,9 +93,8 @@ int Servo::attach(int pin, int min, int max)
             // OK to proceed; first check for new/reuse
             if (this->pinNumber < 0) // we are attaching to a new or previously detached pin; we need to initialize/reinitialize
             {
+                // Keep the timer width, a setTimerWidth() before attach is how a non default width is asked for
                 this->ticks = DEFAULT_PULSE_WIDTH_TICKS;
-                this->timer_width = DEFAULT_TIMER_WIDTH;
-                this->timer_width_ticks = pow(2,this->timer_width);
             }
             this->pinNumber = pin;
 #ifdef ENFORCE_PINS
@@ -131,6 +130,7 @@ if(
         // if you want anything other than default timer width, you must call setTimerWidth() before attach
 
         pwm.attachPin(this->pinNumber,REFRESH_CPS, this->timer_width );   // GPIO pin assigned to channel
+        buildTickTable();
         ESP_LOGW(TAG, "Success to Attach servo : %d on PWM %d",pin,pwm.getChannel());
 
         return pwm.getChannel();
@@ -182,6 +182,42 @@ void Servo::writeTicks(int value)
     }
 }
 
+void Servo::writeAngleFast(int angle)
+{
+    if (angle < 0)
+        angle = 0;
+    else if (angle > 180)
+        angle = 180;
+    writeTicksFast(this->angleTicks[angle]);
+}
+
+void Servo::writeTicksFast(int value)
+{
+    if (this->attached())   // ensure channel is valid
+    {
+        if (value < this->minTicks)      // ensure ticks are in range
+            value = this->minTicks;
+        else if (value > this->maxTicks)
+            value = this->maxTicks;
+        this->ticks = value;
+        pwm.writeFast(this->ticks);
+    }
+}
+
+void Servo::buildTickTable()
+{
+    // Same rounding as usToTicks, done once here in 64 bit integers so the fast path never converts
+    // ticks = usec * timer_width_ticks * REFRESH_CPS / 1000000
+    uint64_t scale = (uint64_t)this->timer_width_ticks * (uint64_t)REFRESH_CPS;
+    this->minTicks = (uint16_t)(((uint64_t)this->min * scale) / 1000000);
+    this->maxTicks = (uint16_t)(((uint64_t)this->max * scale) / 1000000);
+    for (int angle = 0; angle <= 180; angle++)
+    {
+        uint64_t usec = this->min + ((this->max - this->min) * angle) / 180;   // same as map()
+        this->angleTicks[angle] = (uint16_t)((usec * scale) / 1000000);
+    }
+}
+
 void Servo::release()
 {
     if (this->attached())   // ensure channel is valid
@@ -244,12 +280,14 @@ void Servo::setTimerWidth(int value)
     this->timer_width_ticks = pow(2,this->timer_width);
     
     // If this is an attached servo, clean up
+    // Not attached yet the width is just stored, attach() sets the timer up and builds the tick table with it
     if (this->attached())
     {
         // detach, setup and attach again to reflect new timer width
     	pwm.detachPin(this->pinNumber);
     	pwm.attachPin(this->pinNumber, REFRESH_CPS, this->timer_width);
-    }        
+        buildTickTable();
+    }
 }
 
 int Servo::readTimerWidth()
@@ -58,8 +58,17 @@
 
  *** ESP32-specific functions **
  setTimerWidth(value) - Sets the PWM timer width (must be 16-20) (ESP32 ONLY);
- as a side effect, the pulse width is recomputed.
+ as a side effect, the pulse width is recomputed. Call it before attach(), on an
+ attached servo it detaches and reattaches the channel, glitching the servo that
+ shares its timer.
  int readTimerWidth() - Gets the PWM timer width (ESP32 ONLY)
+
+ *** Fast path (integer only) **
+ void writeAngleFast(int angle) - Sets the servo angle in degrees (clamped to 0-180)
+ from a tick table built at attach(), writes the LEDC duty directly.
+ void writeTicksFast(int ticks) - Sets the pulse width in ticks, clamped to the
+ min/max ticks precomputed at attach().
+ Both skip the double precision us<->ticks conversions and the pin lookup of write().
  */
 
 #ifndef ESP32_Servo_h
@@ -137,6 +146,8 @@ public:
 	void write(int value); // if value is < MIN_PULSE_WIDTH its treated as an angle, otherwise as pulse width in microseconds
 	void writeMicroseconds(int value);     // Write pulse width in microseconds
 	void writeTicks(int value);     // Write ticks, the smallest increment the servo can handle
+	void writeAngleFast(int angle); // Write degrees through the precomputed tick table, integer only
+	void writeTicksFast(int value); // Write ticks clamped to the precomputed min/max, integer only
 	void release();
 	int read(); // returns current pulse width as an angle between 0 and 180 degrees
 	int readMicroseconds(); // returns current pulse width in microseconds for this servo
@@ -153,6 +164,7 @@ public:
 private:
 	int usToTicks(int usec);
 	int ticksToUs(int ticks);
+	void buildTickTable();
 //   static int ServoCount;                             // the total number of attached servos
 //   static int ChannelUsed[];                          // used to track whether a channel is in service
 //   int servoChannel = 0;                              // channel number for this servo
@@ -166,6 +178,9 @@ private:
 	ESP32PWM * getPwm(); // get the PWM object
 	ESP32PWM pwm;
 	int REFRESH_CPS = 50;
+	uint16_t angleTicks[181];               // ticks for every whole degree, rebuilt on attach and timer width changes
+	uint16_t minTicks = 0;                  // ticks for min, fast path lower clamp
+	uint16_t maxTicks = 0;                  // ticks for max, fast path upper clamp
 
 };
 #endif
@@ -0,0 +1,301 @@
+// Host side mock of the glove's native BLE transport(main/BleTransport.cpp).
+// Runs the real OpenGlovesCodec and BleFlowControl code against a connection event model of the
+// controller in virtual time: inputs are encoded, chunked to MTU-3 and queued as notifications,
+// the mock central reassembles them and checks every line byte for byte against what was encoded.
+// Haptic lines go the other way as write without response and are checked after parsing.
+// Exits non-zero if the paced transport ever delivers a corrupted line or a wrong haptic command.
+//
+// Build and run from EchoHand_Firmware/host:
+//   g++ -std=c++17 -O2 -I ../main BleTransportMock.cpp ../main/OpenGlovesCodec.cpp -o BleTransportMock && ./BleTransportMock
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "OpenGlovesCodec.h"
+#include "BleFlowControl.h"
+
+// Small deterministic PRNG so results don't depend on the host's std library
+struct XorShift32
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+// One notification sitting in the controller, tagged with the line it belongs to
+struct Packet
+{
+    std::string bytes;
+    uint32_t lineIndex;
+};
+
+struct LinkScenario
+{
+    uint16_t mtu;
+    uint32_t intervalUs;
+};
+
+struct MockResult
+{
+    uint32_t linesEncoded = 0;
+    uint32_t linesSent = 0;
+    uint32_t linesDelivered = 0;
+    uint32_t linesCorrupt = 0;
+    uint32_t packetsRejected = 0;
+    uint32_t hapticsSent = 0;
+    uint32_t hapticsApplied = 0;
+    uint32_t hapticsWrong = 0;
+    size_t maxQueue = 0;
+    double meanAgeMs = 0;
+    double p99AgeMs = 0;
+};
+
+// Tunables shared by every scenario
+static const uint32_t SIMULATION_US = 10000000;     // 10 s of virtual time
+static const uint32_t LOOP_US = 1000;               // task loop period(vTaskDelay(1) at 1kHz tick)
+static const size_t CONTROLLER_BUFFERS = 10;        // esp_ble_get_cur_sendable_packets_num when idle
+static const size_t PACKETS_PER_EVENT = 4;          // notifications the central accepts per connection event
+static const uint32_t HAPTIC_PERIOD_US = 11111;     // OpenGloves FFB at 90Hz
+
+// Description: Runs one MTU/interval scenario, paced by BleNotifyPacer or sending on every change
+// Parameters: scenario link parameters, paced selects the pacer vs the naive transport
+// Return: counters and the central's data age
+MockResult runScenario(const LinkScenario &scenario, bool paced)
+{
+    XorShift32 rng = {0x9E3779B9u};
+    MockResult result;
+    BleNotifyPacer pacer;
+    pacer.setMtu(scenario.mtu);
+    pacer.setConnIntervalUs(scenario.intervalUs);
+
+    std::deque<Packet> controller;
+    std::vector<std::string> encodedLines;
+    std::vector<uint32_t> encodedUs;
+
+    // Central side reassembly, what arrives must match the encoded line it started with
+    BleLineAssembler<OPENGLOVES_MAX_LINE> centralLine;
+    std::string centralBytes;
+    uint32_t centralLineIndex = UINT32_MAX;
+    bool receivedAny = false;
+    uint32_t newestEncodedUs = 0;
+    std::vector<uint32_t> ages;
+
+    // Haptics: writes queued by the central, applied through the real parser on the glove side
+    std::deque<std::string> hapticWrites;
+    std::deque<OpenGlovesCommand> hapticExpected;
+    BleLineAssembler<OPENGLOVES_MAX_LINE> gloveLine;
+
+    InputsPayload in = {};
+    bool dirty = false;
+    uint32_t nextEventUs = scenario.intervalUs;
+    uint32_t nextHapticUs = 0;
+
+    for (uint32_t now = 0; now < SIMULATION_US; now += LOOP_US)
+    {
+        // Sensor task changes the inputs every ms
+        for (int i = 0; i < 5; i++)
+        {
+            in.fingerAngles[i] = rng.next() % 4096;
+        }
+        in.joystickXY[0] = rng.next() % 4096;
+        in.joystickXY[1] = rng.next() % 4096;
+        in.buttonsBitmask = rng.next() & 0x0F;
+        dirty = true;
+
+        // Central sends an FFB line, split into MTU-3 writes
+        if (now >= nextHapticUs)
+        {
+            nextHapticUs += HAPTIC_PERIOD_US;
+            OpenGlovesCommand expected = {};
+            char line[OPENGLOVES_MAX_LINE];
+            int length = 0;
+            for (int i = 0; i < 5; i++)
+            {
+                int value = rng.next() % 1001;
+                expected.hasServo[i] = true;
+                expected.servoTargetAngles[i] = (180 * value) / 1000;
+                length += snprintf(line + length, sizeof(line) - length, "%c%d", 'A' + i, value);
+            }
+            int hertz = rng.next() % 200;
+            expected.hasVibration = true;
+            expected.vibrationRPM = hertz * 60;
+            length += snprintf(line + length, sizeof(line) - length, "F%d.0\n", hertz);
+
+            size_t payload = bleChunkPayload(scenario.mtu);
+            for (int offset = 0; offset < length; offset += payload)
+            {
+                hapticWrites.push_back(std::string(line + offset, std::min<size_t>(payload, length - offset)));
+            }
+            hapticExpected.push_back(expected);
+            result.hapticsSent++;
+        }
+
+        // Connection event: controller hands notifications to the central, central's writes arrive
+        if (now >= nextEventUs)
+        {
+            nextEventUs += scenario.intervalUs;
+            for (size_t p = 0; p < PACKETS_PER_EVENT && !controller.empty(); p++)
+            {
+                Packet packet = controller.front();
+                controller.pop_front();
+
+                // A line is judged against the one its first packet came from, lost chunks splice lines together
+                if (centralBytes.empty())
+                {
+                    centralLineIndex = packet.lineIndex;
+                }
+                centralBytes += packet.bytes;
+
+                for (char byte : packet.bytes)
+                {
+                    // Spliced lines can overflow the assembler, that still counts as a corrupt line
+                    bool complete = centralLine.push(byte);
+                    if (byte != '\n')
+                    {
+                        continue;
+                    }
+                    std::string expected = encodedLines[centralLineIndex];
+                    std::string got = std::string(centralLine.line()) + "\n";
+                    if (complete && got == expected && centralBytes == expected)
+                    {
+                        result.linesDelivered++;
+                        receivedAny = true;
+                        newestEncodedUs = encodedUs[centralLineIndex];
+                    }
+                    else
+                    {
+                        result.linesCorrupt++;
+                    }
+                    centralBytes.clear();
+                }
+            }
+            for (size_t p = 0; p < PACKETS_PER_EVENT && !hapticWrites.empty(); p++)
+            {
+                for (char byte : hapticWrites.front())
+                {
+                    if (!gloveLine.push(byte))
+                    {
+                        continue;
+                    }
+                    OpenGlovesCommand command;
+                    parseOpenGlovesCommand(gloveLine.line(), command);
+                    OpenGlovesCommand expected = hapticExpected.front();
+                    hapticExpected.pop_front();
+                    bool same = command.hasVibration && command.vibrationRPM == expected.vibrationRPM;
+                    for (int i = 0; i < 5; i++)
+                    {
+                        same = same && command.hasServo[i] && command.servoTargetAngles[i] == expected.servoTargetAngles[i];
+                    }
+                    result.hapticsApplied++;
+                    result.hapticsWrong += same ? 0 : 1;
+                }
+                hapticWrites.pop_front();
+            }
+        }
+
+        // Glove task loop, mirrors TaskCommunication<BleTransport>
+        if (dirty)
+        {
+            char line[OPENGLOVES_MAX_LINE];
+            size_t length = encodeOpenGlovesInputs(in, true, line, sizeof(line));
+            uint16_t sendable = CONTROLLER_BUFFERS - controller.size();
+            bool send = paced ? pacer.readyToSend(now, sendable, length) : true;
+            if (send)
+            {
+                uint32_t lineIndex = encodedLines.size();
+                encodedLines.push_back(std::string(line, length));
+                encodedUs.push_back(now);
+                result.linesEncoded++;
+
+                // Naive transport notifies every chunk and loses whatever the controller has no room for
+                size_t payload = bleChunkPayload(scenario.mtu);
+                bool complete = true;
+                for (size_t offset = 0; offset < length; offset += payload)
+                {
+                    if (controller.size() >= CONTROLLER_BUFFERS)
+                    {
+                        result.packetsRejected++;
+                        complete = false;
+                        continue;
+                    }
+                    controller.push_back({std::string(line + offset, std::min(payload, length - offset)), lineIndex});
+                }
+                result.linesSent += complete ? 1 : 0;
+                if (paced)
+                {
+                    pacer.onSend(now);
+                }
+                dirty = false;
+            }
+        }
+        result.maxQueue = std::max(result.maxQueue, controller.size());
+
+        // Sample how stale the central's newest line is once per ms
+        if (receivedAny)
+        {
+            ages.push_back(now - newestEncodedUs);
+        }
+    }
+
+    if (!ages.empty())
+    {
+        double sum = 0;
+        for (uint32_t age : ages)
+        {
+            sum += age;
+        }
+        result.meanAgeMs = sum / ages.size() / 1000.0;
+        std::sort(ages.begin(), ages.end());
+        result.p99AgeMs = ages[(ages.size() * 99) / 100] / 1000.0;
+    }
+    return result;
+}
+
+int main()
+{
+    const LinkScenario scenarios[] = {
+        {23, 7500},
+        {23, 15000},
+        {23, 30000},
+        {185, 7500},
+        {185, 15000},
+        {185, 30000},
+    };
+
+    bool failed = false;
+    printf("%5s %9s %-6s %8s %8s %8s %8s %9s %8s %9s %8s %8s\n",
+           "mtu", "interval", "mode", "encoded", "deliv", "corrupt", "rejected", "maxQueue", "meanAge", "p99Age", "haptics", "wrong");
+    for (const LinkScenario &scenario : scenarios)
+    {
+        for (int paced = 0; paced <= 1; paced++)
+        {
+            MockResult r = runScenario(scenario, paced);
+            printf("%5u %7.1fms %-6s %8u %8u %8u %8u %9zu %6.2fms %7.2fms %8u %8u\n",
+                   scenario.mtu, scenario.intervalUs / 1000.0, paced ? "paced" : "naive",
+                   r.linesEncoded, r.linesDelivered, r.linesCorrupt, r.packetsRejected, r.maxQueue,
+                   r.meanAgeMs, r.p99AgeMs, r.hapticsApplied, r.hapticsWrong);
+
+            // Haptics must always survive chunking, inputs only when flow control is on
+            if (r.hapticsWrong != 0 || r.hapticsApplied == 0 || (paced && (r.linesCorrupt != 0 || r.linesDelivered == 0)))
+            {
+                failed = true;
+            }
+        }
+    }
+
+    if (failed)
+    {
+        printf("FAILED: corrupted lines or wrong haptic commands with flow control on\n");
+        return 1;
+    }
+    return 0;
+}
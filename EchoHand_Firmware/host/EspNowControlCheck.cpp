@@ -0,0 +1,99 @@
+// Check of the lines the glove's ESP-NOW link keeps to itself against the ones it hands on. Runs the real
+// Communication task over EspNowTransport in virtual time and delivers one line at a time from the receiver's side:
+// the trace dump command and OpenGloves lines have to reach the Communication task, radio probes and loss reports
+// must not, and a radio command has to be acked with RADIO_ACK_PREFIX without reaching it either.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j && ./build/EspNowControlCheck
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "HostHal.h"
+#include "config.h"
+#include "TaskTable.h"
+#include "Communication_task.h"
+#include "EspNowTransport.h"
+#include "DataBroker.h"
+
+TaskHandle_t xServoTaskHandle = NULL;
+TaskHandle_t xVibrationTaskHandle = NULL;
+
+static EspNowTransport transport;
+
+static constexpr TaskSpec tasks[] = {
+    {TaskCommunication<EspNowTransport>, "Communication", 8192, 0, 0, 0, &transport, NULL, true, false},
+};
+
+// Time each line gets to reach the Communication task
+static const uint32_t LINE_WAIT_MS = 50;
+
+// Last radio ack the glove sent, only touched by the radio thread under the lockstep scheduler
+static std::string lastAck;
+
+// Description: Keeps the glove's radio acks, its probes and input frames are ignored
+// Parameters: frame, its length, unused context
+// Return: true, the receiver acknowledges every frame
+static bool onGloveFrame(const uint8_t *data, size_t length, void *context)
+{
+    (void)context;
+    if (length > 2 && data[0] == RADIO_ACK_PREFIX)
+    {
+        lastAck.assign((const char *)data, strnlen((const char *)data, length));
+    }
+    return true;
+}
+
+// Description: Delivers a line as the receiver sends it(null terminated) and checks whether the Communication task
+// got it
+// Parameters: line, whether it should reach the task, time to deliver it at in milliseconds(advanced)
+// Return: true if the line went where it should
+static bool checkLine(const char *line, bool reaches, uint32_t &nowMs)
+{
+    uint32_t before = transport.stats.linesReceived;
+    hostSleepUntilUs(nowMs * 1000ull);
+    hostEspNowReceive((const uint8_t *)line, strlen(line) + 1);
+    nowMs += LINE_WAIT_MS;
+    hostSleepUntilUs(nowMs * 1000ull);
+
+    bool reached = transport.stats.linesReceived != before;
+    printf("%-14s %-22s %s\n", line, reached ? "reached the task" : "kept by the link", reached == reaches ? "ok" : "FAILED");
+    return reached == reaches;
+}
+
+int main()
+{
+    // Lockstep virtual time before anything starts a thread
+    hostUseVirtualTime();
+    hostSetSerialOutput(NULL);
+    hostEspNowSetSendHandler(onGloveFrame, NULL);
+    startTasks(tasks, sizeof(tasks) / sizeof(tasks[0]));
+
+    const char dumpCommand[] = {TRACE_DUMP_COMMAND, '\0'};
+    const char probe[] = {RADIO_ACK_PREFIX, '\0'};
+    char feedback[8];
+    snprintf(feedback, sizeof(feedback), "%cL25", LINK_FEEDBACK_PREFIX);
+    char radioCommand[16];
+    snprintf(radioCommand, sizeof(radioCommand), "%cC%uR%uL%u", RADIO_COMMAND_PREFIX, (unsigned)ESPNOW_CHANNEL,
+             (unsigned)ESPNOW_PHY_RATE, (unsigned)(ESPNOW_LONG_RANGE != 0));
+
+    uint32_t nowMs = 100;
+    int failures = 0;
+    failures += !checkLine(dumpCommand, true, nowMs);
+    failures += !checkLine(probe, false, nowMs);
+    failures += !checkLine(feedback, false, nowMs);
+    failures += !checkLine("A0B500C0D0E0", true, nowMs);
+    failures += !checkLine(radioCommand, false, nowMs);
+
+    // The OpenGloves line has to have been parsed too, the radio command acked on the old settings
+    bool limitApplied = DataBroker::instance().getServoTargetAngle(1) > 0;
+    bool acked = lastAck == std::string(1, RADIO_ACK_PREFIX) + (radioCommand + 1);
+    printf("Index limit applied: %s, radio command acked: %s(\"%s\")\n", limitApplied ? "ok" : "FAILED",
+           acked ? "ok" : "FAILED", lastAck.c_str());
+    failures += !limitApplied + !acked;
+
+    // The task never returns, leave without running static destructors under it
+    fflush(stdout);
+    std::_Exit(failures == 0 ? 0 : 1);
+}
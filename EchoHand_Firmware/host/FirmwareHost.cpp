@@ -0,0 +1,127 @@
+// The glove's firmware tasks running on the host through the HAL shims in hal/.
+// Host counterpart of main/main.cpp with the ESP-NOW transport: the flex sensors follow a scripted hand
+// (open and closed for the two calibration phases, then curling and opening), the PC side sends an
+// FFB line every 20 ms and the lines the glove sends are counted and spot printed.
+// With HOT_PATH_TRACE the trace dumps go to stdout for TraceDecode like the glove's USB Serial.
+// Runs in real time, calibration alone takes 10 s.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j && ./build/FirmwareHost [seconds]
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "HostHal.h"
+#include "config.h"
+#include "TaskTable.h"
+#include "AnalogRead_task.h"
+#include "ServoControl_task.h"
+#include "VibrationControl_task.h"
+#include "Communication_task.h"
+#include "EspNowTransport.h"
+#include "TraceRing.h"
+
+TaskHandle_t xServoTaskHandle = NULL;
+TaskHandle_t xVibrationTaskHandle = NULL;
+
+static EspNowTransport mainTransport;
+
+// Same tasks, stacks and priorities as main.cpp for the ESP-NOW build
+static constexpr TaskSpec tasks[] = {
+    {TaskAnalogRead, "AnalogRead", 8192, 0, 1, 20, NULL, NULL, true, true},
+    {TaskCommunication<EspNowTransport>, "Communication", 8192, 0, 0, 0, &mainTransport, NULL, true, false},
+    {TaskVibrationControl, "VibrationControl", 4096, 1, 1, 1000 / VIBRATION_CONTROL_HZ, NULL, &xVibrationTaskHandle, VIBRATION_ENABLE, true},
+    {TaskServoControl, "ServoControl", 8192, 1, 1, 1000 / SERVO_CONTROL_HZ, NULL, &xServoTaskHandle, true, true},
+    {TaskTraceDump, "TraceDump", 4096, 0, 0, TRACE_DUMP_PERIOD_MS, NULL, &xTraceDumpTaskHandle, HOT_PATH_TRACE, false},
+};
+
+// Flex sensor voltage of a fully open and fully closed finger
+static const uint32_t OPEN_MV = 2800;
+static const uint32_t CLOSED_MV = 600;
+
+// Lines the glove sent, counted by the ESP-NOW send handler on the radio thread
+static std::atomic<uint32_t> linesSent{0};
+
+// Description: Receives the glove's ESP-NOW frames, prints one line a second
+// Parameters: frame, its length, unused context
+// Return: true, the PC side acknowledges every frame
+static bool onGloveFrame(const uint8_t *data, size_t length, void *context)
+{
+    (void)context;
+    static uint32_t lastPrintMs = 0;
+    uint32_t count = ++linesSent;
+    if (millis() - lastPrintMs >= 1000)
+    {
+        lastPrintMs = millis();
+        printf("[%6.2f s] line %5u: %.*s", millis() / 1000.0, count, (int)strnlen((const char *)data, length), (const char *)data);
+    }
+    return true;
+}
+
+// Description: Flex sensor voltage of the scripted hand
+// Parameters: finger index, time since start in milliseconds
+// Return: voltage in mV
+static uint32_t fingerMilliVolts(uint8_t finger, uint32_t nowMs)
+{
+    // Open for the first calibration phase, closed for the second
+    if (nowMs < 5000)
+    {
+        return OPEN_MV;
+    }
+    if (nowMs < 10500)
+    {
+        return CLOSED_MV;
+    }
+
+    // Curling and opening at 0.5 Hz, each finger a little behind the previous one
+    float phase = 2.0f * 3.14159f * (0.5f * (nowMs - 10500) / 1000.0f) - finger * 0.3f;
+    float curl = 0.5f - 0.5f * cosf(phase);
+    return OPEN_MV - (uint32_t)(curl * (OPEN_MV - CLOSED_MV));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runMs = (argc > 1 ? atoi(argv[1]) : 15) * 1000;
+    const uint8_t potPins[5] = {THUMB_POT, INDEX_POT, MIDDLE_POT, RING_POT, PINKIE_POT};
+    const uint8_t servoPins[5] = {THUMB_SERVO, INDEX_SERVO, MIDDLE_SERVO, RING_SERVO, PINKIE_SERVO};
+
+    hostEspNowSetSendHandler(onGloveFrame, NULL);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        hostSetAnalogMilliVolts(potPins[i], OPEN_MV);
+    }
+
+    if (VIBRATION_ENABLE)
+    {
+        setupVibrationMotors();
+    }
+    startTasks(tasks, sizeof(tasks) / sizeof(tasks[0]));
+
+    // PC side: move the hand and send a force feedback line every 20 ms
+    uint32_t startMs = millis();
+    for (uint32_t nowMs = 0; nowMs < runMs; nowMs = millis() - startMs)
+    {
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            hostSetAnalogMilliVolts(potPins[i], fingerMilliVolts(i, nowMs));
+        }
+
+        // Block the index finger half way and buzz once a second after calibration
+        char line[32];
+        int length = snprintf(line, sizeof(line), "A0B500C0D0E0%s\n", nowMs > 10500 && nowMs % 1000 < 20 ? "F150" : "");
+        hostEspNowReceive((const uint8_t *)line, length + 1);
+        delay(20);
+    }
+
+    printf("Sent %u lines in %.1f s\n", linesSent.load(), runMs / 1000.0);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        printf("Servo %u pulse %d us\n", i, hostServoPulseUs(servoPins[i]));
+    }
+
+    // The tasks never return, leave without running static destructors under them
+    fflush(stdout);
+    std::_Exit(0);
+}
@@ -0,0 +1,438 @@
+// Deterministic simulation of the glove's firmware in virtual time, the local alternative to the Wokwi project.
+// Runs the real acquisition, ESP-NOW comms, vibration and servo tasks from main/ on the HAL shims with the
+// lockstep scheduler(hal/HostScheduler.h): the flex sensors follow a scripted hand, the PC side sends an FFB
+// line every 20 ms over a simulated ESP-NOW link(airtime and optional loss) and every frame and servo write is
+// traced. The same inputs give the same trace byte for byte, and a minute of glove time runs in seconds.
+//
+// The hand opens and closes for the two calibration phases, then curls index to pinkie at 0.5 Hz while the thumb
+// snaps open/closed every 250 ms. Thumb steps give the sensor to wire latency, changes of the PC's index limit
+// give the FFB line to servo write latency.
+//
+// With a raw sensor recording(SensorRecorder, RecordingFile.h) the ADC serves the recorded session instead of
+// the scripted hand: the recorded calibration end points held through the two calibration phases, then every
+// recorded run pass burst by burst. Each pass' finger values in the DataBroker are compared with the ones the
+// glove computed, joystick and buttons stay at rest.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j
+//   ./build/FirmwareSimulation [seconds] [trace.csv] [loss per mille] [recording.ehr]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "HostHal.h"
+#include "config.h"
+#include "TaskTable.h"
+#include "AnalogRead_task.h"
+#include "ServoControl_task.h"
+#include "VibrationControl_task.h"
+#include "Communication_task.h"
+#include "EspNowTransport.h"
+#include "DataBroker.h"
+#include "RecordingFile.h"
+
+TaskHandle_t xServoTaskHandle = NULL;
+TaskHandle_t xVibrationTaskHandle = NULL;
+
+static EspNowTransport mainTransport;
+
+// Same tasks, stacks and priorities as main.cpp for the ESP-NOW build
+static constexpr TaskSpec tasks[] = {
+    {TaskAnalogRead, "AnalogRead", 8192, 0, 1, 20, NULL, NULL, true, true},
+    {TaskCommunication<EspNowTransport>, "Communication", 8192, 0, 0, 0, &mainTransport, NULL, true, false},
+    {TaskVibrationControl, "VibrationControl", 4096, 1, 1, 1000 / VIBRATION_CONTROL_HZ, NULL, &xVibrationTaskHandle, VIBRATION_ENABLE, true},
+    {TaskServoControl, "ServoControl", 8192, 1, 1, 1000 / SERVO_CONTROL_HZ, NULL, &xServoTaskHandle, true, true},
+};
+
+// Flex sensor voltage of a fully open and fully closed finger
+static const uint32_t OPEN_MV = 2800;
+static const uint32_t CLOSED_MV = 600;
+
+// Calibration ends and the scripted motion starts
+static const uint32_t MOTION_START_MS = 10500;
+
+// Thumb step period and PC line period
+static const uint32_t THUMB_STEP_MS = 250;
+static const uint32_t FFB_PERIOD_MS = 20;
+
+// Index limit the PC toggles between, in OpenGloves A-E units
+static const int FFB_LIMITS[2] = {0, 500};
+static const uint32_t FFB_TOGGLE_MS = 300;
+
+// Small deterministic PRNG so results don't depend on the host's std library
+struct XorShift32
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    // Returns true with the given probability(per mille)
+    bool chance(uint32_t permille) { return next() % 1000 < permille; }
+};
+
+// Everything the handlers record, only touched by one thread at a time under the lockstep scheduler
+struct SimulationState
+{
+    FILE *trace;
+    XorShift32 rng;
+    uint32_t lossPermille;
+
+    // Frames from the glove
+    uint32_t framesSent = 0;
+    uint32_t framesDelivered = 0;
+    uint32_t motionFrames = 0;
+    uint64_t lastFrameUs = 0;
+    uint64_t sumGapUs = 0;
+    uint64_t maxGapUs = 0;
+
+    // Thumb steps waiting for the first frame that shows them
+    bool thumbClosed = false;
+    bool thumbStepPending = false;
+    uint64_t thumbStepUs = 0;
+    std::vector<uint64_t> sensorLatencies;
+
+    // Index limit changes waiting for the first index servo write after them
+    int ffbLimit = -1;
+    bool ffbPending = false;
+    uint64_t ffbChangeUs = 0;
+    std::vector<uint64_t> ffbLatencies;
+
+    uint32_t servoWrites[5] = {0, 0, 0, 0, 0};
+};
+
+static SimulationState sim;
+
+// Recorded session the ADC serves, only touched by the acquisition task once the simulation runs
+struct ReplayState
+{
+    bool active = false;
+    SensorCalibration calibration;
+    std::vector<SensorPass> passes;
+    size_t nextPass = 0;
+    const SensorPass *current = NULL;
+    uint8_t lastPin = 0xFF;
+    uint8_t sampleIndex[HOST_PIN_COUNT] = {};
+
+    // Passes whose finger values were compared with the glove's and those that matched
+    uint32_t compared = 0;
+    uint32_t matching = 0;
+    int maxDifference = 0;
+};
+
+static ReplayState replay;
+
+static const uint8_t potPins[5] = {THUMB_POT, INDEX_POT, MIDDLE_POT, RING_POT, PINKIE_POT};
+static const uint8_t servoPins[5] = {THUMB_SERVO, INDEX_SERVO, MIDDLE_SERVO, RING_SERVO, PINKIE_SERVO};
+
+// Description: Receives the glove's ESP-NOW frames on the radio thread, traces them and drops the lost ones
+// Parameters: frame(line, null terminator, sequence number), its length, unused context
+// Return: true if the PC side acknowledged the frame
+static bool onGloveFrame(const uint8_t *data, size_t length, void *context)
+{
+    (void)context;
+    uint64_t now = hostMicros();
+    size_t lineLength = strnlen((const char *)data, length);
+    uint16_t sequence = lineLength + 2 < length ? data[lineLength + 1] | (data[lineLength + 2] << 8) : 0;
+    bool delivered = !sim.rng.chance(sim.lossPermille);
+
+    // Trace the line without its '\n'
+    int printed = lineLength > 0 && data[lineLength - 1] == '\n' ? (int)lineLength - 1 : (int)lineLength;
+    fprintf(sim.trace, "%llu,frame,%u,%s,%.*s\n", (unsigned long long)now, sequence, delivered ? "ack" : "lost",
+            printed, (const char *)data);
+
+    sim.framesSent++;
+    if (!delivered)
+    {
+        return false;
+    }
+    sim.framesDelivered++;
+    sim.motionFrames += now >= MOTION_START_MS * 1000ull;
+    if (sim.lastFrameUs != 0)
+    {
+        uint64_t gap = now - sim.lastFrameUs;
+        sim.sumGapUs += gap;
+        sim.maxGapUs = gap > sim.maxGapUs ? gap : sim.maxGapUs;
+    }
+    sim.lastFrameUs = now;
+
+    // First frame whose thumb value crossed half way since the step
+    if (sim.thumbStepPending && data[0] == 'A')
+    {
+        long thumb = strtol((const char *)data + 1, NULL, 10);
+        if ((thumb > 2048) == sim.thumbClosed)
+        {
+            sim.sensorLatencies.push_back(now - sim.thumbStepUs);
+            sim.thumbStepPending = false;
+        }
+    }
+    return true;
+}
+
+// Description: Traces every servo write, the first index write after a limit change ends its latency
+// Parameters: servo pin, pulse in microseconds(0 released), unused context
+// Return: none
+static void onServoWrite(uint8_t pin, int pulseUs, void *context)
+{
+    (void)context;
+    uint64_t now = hostMicros();
+    fprintf(sim.trace, "%llu,servo,%u,%d\n", (unsigned long long)now, pin, pulseUs);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        if (servoPins[i] == pin)
+        {
+            sim.servoWrites[i]++;
+        }
+    }
+    if (sim.ffbPending && pin == INDEX_SERVO)
+    {
+        sim.ffbLatencies.push_back(now - sim.ffbChangeUs);
+        sim.ffbPending = false;
+    }
+}
+
+// Description: Flex sensor voltage of the scripted hand
+// Parameters: finger index, time since start in milliseconds
+// Return: voltage in mV
+static uint32_t fingerMilliVolts(uint8_t finger, uint32_t nowMs)
+{
+    // Open for the first calibration phase, closed for the second
+    if (nowMs < 5000)
+    {
+        return OPEN_MV;
+    }
+    if (nowMs < MOTION_START_MS)
+    {
+        return CLOSED_MV;
+    }
+
+    // Thumb snaps between open and closed
+    if (finger == 0)
+    {
+        return ((nowMs - MOTION_START_MS) / THUMB_STEP_MS) & 1 ? CLOSED_MV : OPEN_MV;
+    }
+
+    // Curling and opening at 0.5 Hz, each finger a little behind the previous one
+    float phase = 2.0f * 3.14159f * (0.5f * (nowMs - MOTION_START_MS) / 1000.0f) - finger * 0.3f;
+    float curl = 0.5f - 0.5f * cosf(phase);
+    return OPEN_MV - (uint32_t)(curl * (OPEN_MV - CLOSED_MV));
+}
+
+// Description: Loads the calibration and the run passes of a recording
+// Parameters: path
+// Return: false if it can't be read or has no calibration or run passes
+static bool loadRecording(const char *path)
+{
+    RecordingReader reader;
+    std::vector<uint8_t> record;
+    SensorPass pass;
+    bool haveCalibration = false;
+    if (!reader.open(path))
+    {
+        return false;
+    }
+    while (reader.next(record))
+    {
+        if (!haveCalibration && decodeSensorCalibration(record.data(), record.size(), replay.calibration))
+        {
+            haveCalibration = true;
+        }
+        else if (decodeSensorPass(record.data(), record.size(), pass) && pass.phase == SENSOR_PHASE_RUN && pass.burstCount >= 5)
+        {
+            replay.passes.push_back(pass);
+        }
+    }
+    replay.active = haveCalibration && !replay.passes.empty();
+    return replay.active;
+}
+
+// Description: Moves the replay on to the next recorded pass, comparing the finger values the firmware computed
+// from the last one with the glove's
+// Parameters: none
+// Return: none
+static void nextReplayPass()
+{
+    if (replay.current != NULL)
+    {
+        EchoStateSnapshot s;
+        DataBroker::instance().takeSnapshot(s);
+        bool same = true;
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            int difference = abs(s.fingerAngles[i] - replay.current->fingerAngles[i]);
+            replay.maxDifference = difference > replay.maxDifference ? difference : replay.maxDifference;
+            same = same && difference == 0;
+        }
+        replay.compared++;
+        replay.matching += same;
+    }
+    replay.current = replay.nextPass < replay.passes.size() ? &replay.passes[replay.nextPass++] : NULL;
+    memset(replay.sampleIndex, 0, sizeof(replay.sampleIndex));
+}
+
+// Description: Serves the recorded session to the firmware's ADC reads, on the acquisition task
+// Parameters: pin, unused context
+// Return: reading in mV, 0 for pins the recording doesn't have
+static uint32_t onReplayAnalogRead(uint8_t pin, void *context)
+{
+    (void)context;
+    uint64_t nowMs = hostMicros() / 1000;
+    int finger = -1;
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        finger = potPins[i] == pin ? i : finger;
+    }
+
+    // Calibration end points through the open and closed phases and their LED blinks
+    if (!SIMULATION && nowMs < MOTION_START_MS - 200)
+    {
+        if (finger < 0)
+        {
+            return 0;
+        }
+        return nowMs < 5100 ? replay.calibration.openValues[finger] : replay.calibration.closedValues[finger];
+    }
+
+    // The thumb is read first in every pass
+    if (pin == potPins[0] && replay.lastPin != potPins[0])
+    {
+        nextReplayPass();
+    }
+    replay.lastPin = pin;
+    for (uint8_t b = 0; replay.current != NULL && b < replay.current->burstCount; b++)
+    {
+        const SensorBurst &burst = replay.current->bursts[b];
+        if (burst.pin == pin && burst.count > 0)
+        {
+            return burst.samples[replay.sampleIndex[pin]++ % burst.count];
+        }
+    }
+    return 0;
+}
+
+// Description: Prints mean and max of a latency list
+// Parameters: label, latencies in microseconds
+// Return: none
+static void printLatencies(const char *label, const std::vector<uint64_t> &latencies)
+{
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    for (uint64_t latency : latencies)
+    {
+        sum += latency;
+        max = latency > max ? latency : max;
+    }
+    printf("%-22s %5zu samples  mean %7.2f ms  max %7.2f ms\n", label, latencies.size(),
+           latencies.empty() ? 0.0 : sum / 1000.0 / latencies.size(), max / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    // Lockstep virtual time before anything starts a thread
+    hostUseVirtualTime();
+
+    uint32_t runMs = (argc > 1 ? atoi(argv[1]) : 30) * 1000;
+    const char *tracePath = argc > 2 ? argv[2] : "firmware_trace.csv";
+    sim.lossPermille = argc > 3 ? atoi(argv[3]) : 0;
+    if (argc > 4 && !loadRecording(argv[4]))
+    {
+        fprintf(stderr, "Can't replay %s, it needs a calibration record and run passes\n", argv[4]);
+        return 1;
+    }
+    sim.rng = {0x2545F491u};
+    sim.trace = fopen(tracePath, "w");
+    if (sim.trace == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", tracePath);
+        return 1;
+    }
+    fprintf(sim.trace, "time_us,event,fields\n");
+
+    // Boot messages would interleave with nothing useful, keep stdout for the summary
+    hostSetSerialOutput(NULL);
+    hostEspNowSetSendHandler(onGloveFrame, NULL);
+    hostSetServoWriteHandler(onServoWrite, NULL);
+    if (replay.active)
+    {
+        hostSetAnalogReadHandler(onReplayAnalogRead, NULL);
+    }
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        hostSetAnalogMilliVolts(potPins[i], OPEN_MV);
+    }
+
+    if (VIBRATION_ENABLE)
+    {
+        setupVibrationMotors();
+    }
+    startTasks(tasks, sizeof(tasks) / sizeof(tasks[0]));
+
+    // PC side: move the hand every millisecond and send a force feedback line every 20 ms
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    for (uint32_t nowMs = 0; nowMs < runMs; nowMs++)
+    {
+        hostSleepUntilUs(nowMs * 1000ull);
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            hostSetAnalogMilliVolts(potPins[i], fingerMilliVolts(i, nowMs));
+        }
+
+        bool thumbClosed = fingerMilliVolts(0, nowMs) == CLOSED_MV;
+        if (!replay.active && nowMs >= MOTION_START_MS && thumbClosed != sim.thumbClosed)
+        {
+            sim.thumbClosed = thumbClosed;
+            sim.thumbStepPending = true;
+            sim.thumbStepUs = hostMicros();
+            fprintf(sim.trace, "%llu,thumb,%s\n", (unsigned long long)sim.thumbStepUs, thumbClosed ? "closed" : "open");
+        }
+
+        if (nowMs % FFB_PERIOD_MS == 0)
+        {
+            // Toggle the index limit after calibration and buzz once a second
+            int limit = nowMs >= MOTION_START_MS ? FFB_LIMITS[(nowMs / FFB_TOGGLE_MS) & 1] : 0;
+            char line[32];
+            int length = snprintf(line, sizeof(line), "A0B%dC0D0E0%s\n", limit, nowMs >= MOTION_START_MS && nowMs % 1000 == 0 ? "F150" : "");
+            if (limit != sim.ffbLimit)
+            {
+                sim.ffbPending = sim.ffbLimit >= 0;
+                sim.ffbLimit = limit;
+                sim.ffbChangeUs = hostMicros();
+            }
+            fprintf(sim.trace, "%llu,ffb,%.*s\n", (unsigned long long)hostMicros(), length - 1, line);
+            hostEspNowReceive((const uint8_t *)line, length + 1);
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    fclose(sim.trace);
+
+    double motionSeconds = (runMs > MOTION_START_MS ? runMs - MOTION_START_MS : 0) / 1000.0;
+    printf("Simulated %.1f s in %.2f s(%.0fx real time), trace in %s\n", runMs / 1000.0, wallSeconds,
+           runMs / 1000.0 / wallSeconds, tracePath);
+    printf("Frames %u sent, %u delivered, %.1f/s after calibration\n", sim.framesSent, sim.framesDelivered,
+           motionSeconds > 0 ? sim.motionFrames / motionSeconds : 0.0);
+    printf("Frame gap              mean %7.2f ms  max %7.2f ms\n",
+           sim.framesDelivered > 1 ? sim.sumGapUs / 1000.0 / (sim.framesDelivered - 1) : 0.0, sim.maxGapUs / 1000.0);
+    printLatencies("Thumb step -> frame", sim.sensorLatencies);
+    printLatencies("FFB limit -> servo", sim.ffbLatencies);
+    if (replay.active)
+    {
+        printf("Replayed %zu of %zu recorded passes, %u of %u match the glove's fingers(max difference %d)\n",
+               replay.nextPass, replay.passes.size(), replay.matching, replay.compared, replay.maxDifference);
+    }
+    printf("Servo writes:");
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        printf(" %u", sim.servoWrites[i]);
+    }
+    printf("\n");
+
+    // The tasks never return, leave without running static destructors under them
+    fflush(stdout);
+    std::_Exit(0);
+}
@@ -0,0 +1,136 @@
+// Host run of the sensor->wire hot path microbenchmarks(main/HotPathBenchmarks.cpp) plus the simulator's
+// OpenGloves payload parser against its previous version(LegacyOpenGlovesParser.h), timed with the host's
+// nanosecond clock.
+// Prints a table and writes the results as Google Benchmark JSON for Testing/bench_compare.py, the glove runs the
+// same benchmarks with HOT_PATH_BENCHMARK in config.h and prints the same JSON with cycle counts.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j && ./build/HotPathBench [results.json] [seconds per run]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "MicroBench.h"
+#include "HotPathBenchmarks.h"
+#include "OpenGlovesCodec.h"
+#include "opengloves.h"
+#include "LegacyOpenGlovesParser.h"
+
+// Lines the simulator receives, encoded by the firmware's own encoder
+#define PAYLOAD_COUNT 64
+static char payloads[PAYLOAD_COUNT][OPENGLOVES_MAX_LINE];
+
+// Description: Host clock for the harness
+// Parameters: none
+// Return: nanoseconds on the steady clock
+static uint64_t steadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Description: Fills the payload table with lines from a fixed seed
+// Parameters: none
+// Return: none
+static void makePayloads()
+{
+    uint32_t state = 0x2545F491u;
+    for (int n = 0; n < PAYLOAD_COUNT; n++)
+    {
+        InputsPayload in{};
+        for (int i = 0; i < 5; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            in.fingerAngles[i] = state % 4096;
+        }
+        in.joystickXY[0] = 2048;
+        in.joystickXY[1] = 2048;
+        in.buttonsBitmask = n & 0xF;
+        encodeOpenGlovesInputs(in, n & 1, payloads[n], sizeof(payloads[n]));
+    }
+}
+
+// Description: The simulator's single pass parser as its I/O thread calls it
+// Parameters: iteration loop
+// Return: none
+static void benchSimulatorParse(BenchState &state)
+{
+    OpenGlovesData data;
+    while (state.keepRunning())
+    {
+        parseOpenGlovesPayload(payloads[state.index() & (PAYLOAD_COUNT - 1)], data);
+        benchKeep(data);
+    }
+}
+
+// Description: The parser before the rewrite, per packet logging included
+// (std::cout goes to /dev/null so the flushes are timed without filling the terminal)
+// Parameters: iteration loop
+// Return: none
+static void benchSimulatorParseLegacy(BenchState &state)
+{
+    OpenGlovesData data;
+    while (state.keepRunning())
+    {
+        parseOpenGlovesPayloadLegacy(payloads[state.index() & (PAYLOAD_COUNT - 1)], data);
+        benchKeep(data);
+    }
+}
+
+static const BenchSpec simulatorBenchmarks[] = {
+    {"simulator/parseOpenGlovesPayload", benchSimulatorParse},
+    {"simulator/parseOpenGlovesPayload_legacy", benchSimulatorParseLegacy},
+};
+
+// Description: Appends JSON text to the results file
+// Parameters: text, output file
+// Return: none
+static void writeFile(const char *text, void *context)
+{
+    fputs(text, (FILE *)context);
+}
+
+int main(int argc, char **argv)
+{
+    const char *outputPath = argc > 1 ? argv[1] : "bench_hotpath.json";
+    double minSeconds = argc > 2 ? atof(argv[2]) : 0.05;
+    const BenchClock clock = {steadyNs, 1e9, "steady_clock_ns"};
+
+    makePayloads();
+    std::ofstream devNull("/dev/null");
+    std::streambuf *coutBuffer = std::cout.rdbuf(devNull.rdbuf());
+
+    std::vector<BenchSpec> specs(hotPathBenchmarks, hotPathBenchmarks + hotPathBenchmarkCount);
+    specs.insert(specs.end(), std::begin(simulatorBenchmarks), std::end(simulatorBenchmarks));
+
+    std::vector<BenchResult> results;
+    printf("%-40s %12s %12s %12s\n", "benchmark", "best ns", "mean ns", "iterations");
+    for (const BenchSpec &spec : specs)
+    {
+        BenchResult result = runBenchmark(spec, clock, minSeconds, 5);
+        results.push_back(result);
+        printf("%-40s %12.1f %12.1f %12lu\n", result.name, result.bestNs, result.meanNs, (unsigned long)result.iterations);
+    }
+    std::cout.rdbuf(coutBuffer);
+
+    // The parsers in packets/s, the rate the simulator's I/O thread can take
+    const BenchResult &parse = results[results.size() - 2];
+    const BenchResult &legacy = results[results.size() - 1];
+    printf("Simulator parser %.0f packets/s, %.0f packets/s before the rewrite(%.1fx)\n", 1e9 / parse.bestNs,
+           1e9 / legacy.bestNs, legacy.bestNs / parse.bestNs);
+
+    FILE *output = fopen(outputPath, "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", outputPath);
+        return 1;
+    }
+    writeBenchJson(results.data(), results.size(), clock, "host", writeFile, output);
+    fclose(output);
+    printf("Results in %s\n", outputPath);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "opengloves.h"
+
+// The simulator's OpenGloves parser as it was before the single pass rewrite(EchoHand_Simulator/src/opengloves.cpp),
+// kept verbatim as the reference for OpenGlovesParseCheck and the before numbers of HotPathBench.
+// Copies the line, logs it with a flush and converts every field through a substr and strtof().
+
+inline void parseOpenGlovesPayloadLegacy(const char *payload, OpenGlovesData &data)
+{
+    if (!payload || strlen(payload) == 0) return;
+
+    std::string payloadStr(payload);
+
+    std::cout << "Received payload: " << payloadStr << std::endl;
+    
+    // Reset buttons to false before parsing
+    data.joystickButton = false;
+    data.buttonTrigger = false;
+    data.buttonA = false;
+    data.buttonB = false;
+    data.buttonGrab = false;
+    data.buttonSystem = false;
+    data.buttonCalibrate = false;
+    
+    size_t pos = 0;
+    while (pos < payloadStr.length())
+    {
+        while (pos < payloadStr.length() && !isalpha(payloadStr[pos])) pos++;
+        if (pos >= payloadStr.length()) break;
+
+        char key = payloadStr[pos++];
+        
+        size_t valueStart = pos;
+        while (pos < payloadStr.length() && (isdigit(payloadStr[pos]) || payloadStr[pos] == '.')) pos++;
+        
+        float value = 0;
+        if (valueStart < pos)
+        {
+            std::string sub = payloadStr.substr(valueStart, pos - valueStart);
+            char* endPtr;
+            value = strtof(sub.c_str(), &endPtr);
+        }
+
+        switch (key)
+        {
+        case 'A': data.fingerCurl[0] = value / 4095.0f; break;
+        case 'B': data.fingerCurl[1] = value / 4095.0f; break;
+        case 'C': data.fingerCurl[2] = value / 4095.0f; break;
+        case 'D': data.fingerCurl[3] = value / 4095.0f; break;
+        case 'E': data.fingerCurl[4] = value / 4095.0f; break;
+        case 'F': data.joystickX = value / 4095.0f * 2.0f - 1.0f; break;
+        case 'G': data.joystickY = value / 4095.0f * 2.0f - 1.0f; break;
+        case 'H': data.joystickButton = value > 0 || valueStart == pos; break;
+        case 'I': data.buttonTrigger = value > 0 || valueStart == pos; break;
+        case 'J': data.buttonA = value > 0 || valueStart == pos; break;
+        case 'K': data.buttonB = value > 0 || valueStart == pos; break;
+        case 'L': data.buttonGrab = value > 0 || valueStart == pos; break;
+        case 'N': data.buttonSystem = value > 0 || valueStart == pos; break;
+        case 'O': data.buttonCalibrate = value > 0 || valueStart == pos; break;
+        case 'P': data.triggerAnalog = value / 4095.0f; break;
+        default: break;
+        }
+    }
+}
@@ -0,0 +1,247 @@
+// Deterministic host simulation of the glove's ESP-NOW send scheduler against a lossy link model.
+// Runs the real SendRateController from main/ in virtual time, so every run prints the same numbers.
+//
+// Build and run from EchoHand_Firmware/host:
+//   g++ -std=c++17 -O2 -I ../main LinkSimulation.cpp -o LinkSimulation && ./LinkSimulation
+
+#include <cstdio>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include "SendRateController.h"
+
+// Small deterministic PRNG so results don't depend on the host's std library
+struct XorShift32
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    // Returns true with the given probability(per mille)
+    bool chance(uint32_t permille) { return next() % 1000 < permille; }
+};
+
+// Link model: a FIFO driver queue in front of a Gilbert-Elliott channel with MAC retries
+struct LinkScenario
+{
+    const char *name;
+    uint32_t airtimeUs;         // time on air for one attempt incl. ACK wait
+    uint32_t goodLossPermille;  // per attempt loss in the good state
+    uint32_t badLossPermille;   // per attempt loss in the bad state(interference burst)
+    uint32_t goodToBadPermille; // chance per attempt of entering a burst
+    uint32_t badToGoodPermille; // chance per attempt of leaving a burst
+};
+
+// Frames the glove generates, only generation time matters for latency
+struct Frame
+{
+    uint32_t generatedUs;
+    uint16_t sequence;
+};
+
+struct SimulationResult
+{
+    uint32_t generated = 0;
+    uint32_t sent = 0;
+    uint32_t delivered = 0;
+    uint32_t dropped = 0;
+    size_t maxQueue = 0;
+    double meanAgeMs = 0;
+    double p99AgeMs = 0;
+    uint32_t finalIntervalUs = 0;
+};
+
+// Tunables of the glove and receiver side that every scenario shares
+static const uint32_t SIMULATION_US = 20000000;     // 20 s of virtual time
+static const uint32_t STEP_US = 50;                 // glove loop granularity
+static const uint32_t SENSOR_PERIOD_US = 1000;      // DataBroker changes every ms
+static const uint32_t MAC_RETRIES = 3;              // attempts after the first
+static const size_t DRIVER_QUEUE_DEPTH = 16;        // esp_now_send fails once this many frames are queued
+static const uint32_t FEEDBACK_PERIOD_US = 200000;  // LINK_FEEDBACK_PERIOD_MS on the receiver
+static const uint32_t FEEDBACK_DELAY_US = 3000;     // time for the loss report to reach the glove
+
+// Description: Runs one scenario with or without the adaptive scheduler
+// Parameters: scenario link model, adaptive selects SendRateController vs send on every change
+// Return: aggregated counters and receiver side data age
+SimulationResult runScenario(const LinkScenario &scenario, bool adaptive)
+{
+    XorShift32 rng = {0x2545F491u};
+    SendRateController controller;
+    SimulationResult result;
+
+    std::deque<Frame> driverQueue;
+    bool channelBad = false;
+    uint32_t attemptsLeft = 0;
+    uint32_t attemptEndUs = 0;
+    bool transmitting = false;
+
+    // Send callback delivered to the glove loop on the next step
+    bool callbackPending = false;
+    bool callbackSuccess = false;
+
+    // Receiver side bookkeeping
+    bool receivedAny = false;
+    uint32_t newestGeneratedUs = 0;
+    uint16_t lastSequence = 0;
+    uint32_t windowReceived = 0;
+    uint32_t windowLost = 0;
+    uint32_t nextFeedbackUs = FEEDBACK_PERIOD_US;
+    bool feedbackPending = false;
+    uint16_t feedbackPermille = 0;
+    uint32_t feedbackArrivalUs = 0;
+
+    uint32_t lastRevisionUs = 0;
+    uint32_t sentRevisionUs = UINT32_MAX;
+    uint16_t sequence = 0;
+    std::vector<uint32_t> ages;
+    ages.reserve(SIMULATION_US / 1000);
+
+    for (uint32_t now = 0; now < SIMULATION_US; now += STEP_US)
+    {
+        // Sensor task bumps the revision
+        if (now % SENSOR_PERIOD_US == 0)
+        {
+            lastRevisionUs = now;
+            result.generated++;
+        }
+
+        // Radio: finish the current attempt, then retry or move on to the next queued frame
+        if (transmitting && now >= attemptEndUs)
+        {
+            channelBad = channelBad ? !rng.chance(scenario.badToGoodPermille) : rng.chance(scenario.goodToBadPermille);
+            bool lost = rng.chance(channelBad ? scenario.badLossPermille : scenario.goodLossPermille);
+
+            if (!lost || attemptsLeft == 0)
+            {
+                Frame frame = driverQueue.front();
+                driverQueue.pop_front();
+                transmitting = false;
+                callbackPending = true;
+                callbackSuccess = !lost;
+
+                if (!lost)
+                {
+                    uint16_t gap = frame.sequence - lastSequence - 1;
+                    if (receivedAny)
+                    {
+                        windowLost += gap;
+                    }
+                    lastSequence = frame.sequence;
+                    receivedAny = true;
+                    windowReceived++;
+                    result.delivered++;
+                    newestGeneratedUs = std::max(newestGeneratedUs, frame.generatedUs);
+                }
+            }
+            else
+            {
+                attemptsLeft--;
+                attemptEndUs = now + scenario.airtimeUs;
+            }
+        }
+        if (!transmitting && !driverQueue.empty())
+        {
+            transmitting = true;
+            attemptsLeft = MAC_RETRIES;
+            attemptEndUs = now + scenario.airtimeUs;
+        }
+
+        // Receiver reports loss back every feedback period
+        if (now >= nextFeedbackUs)
+        {
+            nextFeedbackUs += FEEDBACK_PERIOD_US;
+            if (windowReceived + windowLost > 0)
+            {
+                feedbackPending = true;
+                feedbackPermille = (windowLost * 1000) / (windowReceived + windowLost);
+                feedbackArrivalUs = now + FEEDBACK_DELAY_US;
+            }
+            windowReceived = 0;
+            windowLost = 0;
+        }
+
+        // Glove loop, mirrors TaskCommunication<EspNowTransport>
+        if (callbackPending)
+        {
+            callbackPending = false;
+            controller.onSendComplete(callbackSuccess);
+        }
+        if (feedbackPending && now >= feedbackArrivalUs)
+        {
+            feedbackPending = false;
+            controller.onLossReport(feedbackPermille);
+        }
+        bool mayRead = !adaptive || controller.readyToSend(now);
+        if (mayRead && sentRevisionUs != lastRevisionUs)
+        {
+            sentRevisionUs = lastRevisionUs;
+            Frame frame = {lastRevisionUs, sequence++};
+            if (driverQueue.size() < DRIVER_QUEUE_DEPTH)
+            {
+                driverQueue.push_back(frame);
+                result.sent++;
+                if (adaptive)
+                {
+                    controller.onSend(now);
+                }
+            }
+            else
+            {
+                result.dropped++;
+            }
+        }
+        result.maxQueue = std::max(result.maxQueue, driverQueue.size());
+
+        // Sample how stale the receiver's newest data is once per ms
+        if (receivedAny && now % 1000 == 0)
+        {
+            ages.push_back(now - newestGeneratedUs);
+        }
+    }
+
+    if (!ages.empty())
+    {
+        double sum = 0;
+        for (uint32_t age : ages)
+        {
+            sum += age;
+        }
+        result.meanAgeMs = sum / ages.size() / 1000.0;
+        std::sort(ages.begin(), ages.end());
+        result.p99AgeMs = ages[(ages.size() * 99) / 100] / 1000.0;
+    }
+    result.finalIntervalUs = adaptive ? controller.intervalUs() : SENSOR_PERIOD_US;
+    return result;
+}
+
+int main()
+{
+    // Airtime is roughly a 60 byte frame plus ACK at the given PHY rate
+    const LinkScenario scenarios[] = {
+        {"clean 1Mbps", 900, 5, 5, 0, 1000},
+        {"clean LR 500K", 1900, 5, 5, 0, 1000},
+        {"busy 1Mbps", 1400, 150, 150, 0, 1000},
+        {"bursty 1Mbps", 900, 10, 700, 20, 100},
+        {"bursty LR 500K", 1900, 10, 700, 20, 100},
+    };
+
+    printf("%-16s %-9s %8s %8s %9s %8s %9s %9s %8s %10s\n",
+           "scenario", "mode", "sent", "deliv", "deliv%", "dropped", "maxQueue", "meanAge", "p99Age", "interval");
+    for (const LinkScenario &scenario : scenarios)
+    {
+        for (int adaptive = 0; adaptive <= 1; adaptive++)
+        {
+            SimulationResult r = runScenario(scenario, adaptive);
+            printf("%-16s %-9s %8u %8u %8.1f%% %8u %9zu %7.2fms %6.2fms %8uus\n",
+                   scenario.name, adaptive ? "adaptive" : "every",
+                   r.sent, r.delivered, r.sent ? (100.0 * r.delivered) / r.sent : 0.0,
+                   r.dropped, r.maxQueue, r.meanAgeMs, r.p99AgeMs, r.finalIntervalUs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Equivalence check of the simulator's single pass OpenGloves parser(EchoHand_Simulator/src/opengloves.cpp)
+// against the parser it replaced(LegacyOpenGlovesParser.h). Lines from the firmware's encoder, the same lines with
+// bytes changed, dropped or repeated and random text over letters, digits, dots and separators(long numbers and
+// decimals included) go through both from the same prior state, every field has to come out bit for bit the same.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j && ./build/OpenGlovesParseCheck [lines per kind] [seed]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include "OpenGlovesCodec.h"
+#include "opengloves.h"
+#include "LegacyOpenGlovesParser.h"
+
+// Characters random lines are made of, every key the parser knows plus ones it skips
+static const char lineAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefgxyz0123456789012345678901234567890123456789....,;: -+e\t";
+
+// Description: Line the glove could send, random fingers, joystick and buttons
+// Parameters: random generator
+// Return: line without its '\n'
+static std::string encodedLine(std::mt19937 &rng)
+{
+    InputsPayload in{};
+    for (int i = 0; i < 5; i++)
+    {
+        in.fingerAngles[i] = rng() % 4096;
+    }
+    in.joystickXY[0] = rng() % 4096;
+    in.joystickXY[1] = rng() % 4096;
+    in.buttonsBitmask = rng() & 0xF;
+    char line[OPENGLOVES_MAX_LINE];
+    size_t length = encodeOpenGlovesInputs(in, rng() & 1, line, sizeof(line));
+    return std::string(line, length - 1);
+}
+
+// Description: Changes, drops or repeats a few bytes of a line
+// Parameters: random generator, line to change
+// Return: changed line
+static std::string mutatedLine(std::mt19937 &rng, std::string line)
+{
+    int edits = 1 + rng() % 4;
+    for (int i = 0; i < edits && !line.empty(); i++)
+    {
+        size_t at = rng() % line.size();
+        switch (rng() % 3)
+        {
+        case 0: line[at] = lineAlphabet[rng() % (sizeof(lineAlphabet) - 1)]; break;
+        case 1: line.erase(at, 1); break;
+        default: line.insert(at, rng() % 8 + 1, line[at]); break;
+        }
+    }
+    return line;
+}
+
+// Description: Random text, now and then with a number too long or too precise for the fast path
+// Parameters: random generator
+// Return: line
+static std::string randomLine(std::mt19937 &rng)
+{
+    std::string line;
+    size_t length = rng() % 48;
+    for (size_t i = 0; i < length; i++)
+    {
+        line += lineAlphabet[rng() % (sizeof(lineAlphabet) - 1)];
+        if (rng() % 16 == 0)
+        {
+            // Run of digits with or without a dot, up to past the parser's 64 byte stack copy
+            size_t digits = rng() % 80;
+            size_t dot = rng() % (digits + 2);
+            for (size_t d = 0; d < digits; d++)
+            {
+                line += d == dot ? '.' : char('0' + rng() % 10);
+            }
+        }
+    }
+    return line;
+}
+
+// Description: Float fields compared by their bits, so -0 against 0 or a NaN count as a difference
+// Parameters: the two values
+// Return: true if identical
+static bool sameBits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Description: Compares every field of two parse results
+// Parameters: the two results
+// Return: true if identical
+static bool sameData(const OpenGlovesData &a, const OpenGlovesData &b)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        if (!sameBits(a.fingerCurl[i], b.fingerCurl[i]) || !sameBits(a.splay[i], b.splay[i])) return false;
+        for (int j = 0; j < 4; j++)
+        {
+            if (!sameBits(a.jointCurl[i][j], b.jointCurl[i][j])) return false;
+        }
+    }
+    return sameBits(a.joystickX, b.joystickX) && sameBits(a.joystickY, b.joystickY) && sameBits(a.triggerAnalog, b.triggerAnalog) &&
+           a.joystickButton == b.joystickButton && a.buttonTrigger == b.buttonTrigger && a.buttonA == b.buttonA &&
+           a.buttonB == b.buttonB && a.buttonGrab == b.buttonGrab && a.buttonSystem == b.buttonSystem &&
+           a.buttonCalibrate == b.buttonCalibrate;
+}
+
+struct CheckCounts
+{
+    unsigned long lines = 0;
+    unsigned long mismatches = 0;
+};
+
+// Description: Parses a line with both parsers from the same prior state and compares the results
+// Parameters: counts to update, line, state both parsers start from(carries over to the next line)
+// Return: none
+static void checkLine(CheckCounts &counts, const std::string &line, OpenGlovesData &state)
+{
+    OpenGlovesData legacy = state;
+    OpenGlovesData fromView = state;
+    OpenGlovesData fromString = state;
+    parseOpenGlovesPayloadLegacy(line.c_str(), legacy);
+    parseOpenGlovesPayload(std::string_view(line), fromView);
+    parseOpenGlovesPayload(line.c_str(), fromString);
+    counts.lines++;
+    if (!sameData(legacy, fromView) || !sameData(legacy, fromString))
+    {
+        if (counts.mismatches++ < 10)
+        {
+            fprintf(stderr, "Mismatch on \"%s\"\n", line.c_str());
+        }
+    }
+    state = legacy;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long perKind = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    unsigned int seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1;
+    std::mt19937 rng(seed);
+
+    // The legacy parser logs every line
+    std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+    CheckCounts encoded, mutated, random;
+    OpenGlovesData state;
+    for (unsigned long i = 0; i < perKind; i++)
+    {
+        checkLine(encoded, encodedLine(rng), state);
+        checkLine(mutated, mutatedLine(rng, encodedLine(rng)), state);
+        checkLine(random, randomLine(rng), state);
+    }
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    printf("%-14s %10lu lines %8lu mismatches\n", "encoder", encoded.lines, encoded.mismatches);
+    printf("%-14s %10lu lines %8lu mismatches\n", "mutated", mutated.lines, mutated.mismatches);
+    printf("%-14s %10lu lines %8lu mismatches\n", "random", random.lines, random.mismatches);
+    return encoded.mismatches + mutated.mismatches + random.mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "SensorRecording.h"
+
+// Sensor recording file(.ehr) written by SensorRecorder and read by SensorReplay and FirmwareSimulation.
+// "EHSR" and a u32 file version, then chunks of a fourcc, a u32 length and that many bytes(little endian).
+// A "RECS" chunk holds records as the glove sent them(SensorRecording.h) each behind a u16 length, readers skip
+// chunks they don't know so later versions can add some. The recorder closes a chunk every few dozen passes, a
+// recording cut short by a crash or unplugged glove loses at most the open chunk.
+
+#define RECORDING_MAGIC "EHSR"
+#define RECORDING_FILE_VERSION 1
+#define RECORDING_CHUNK_RECORDS "RECS"
+
+// Description: Writes a u32 little endian
+// Parameters: file, value
+// Return: none
+static inline void recordingPut32(FILE *file, uint32_t value)
+{
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    fwrite(bytes, 1, 4, file);
+}
+
+// Description: Reads a u32 little endian
+// Parameters: file, value to fill
+// Return: false at the end of the file
+static inline bool recordingGet32(FILE *file, uint32_t &value)
+{
+    uint8_t bytes[4];
+    if (fread(bytes, 1, 4, file) != 4)
+    {
+        return false;
+    }
+    value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+    return true;
+}
+
+class RecordingWriter
+{
+public:
+    ~RecordingWriter() { close(); }
+
+    // Description: Creates the file and writes its header
+    // Parameters: path
+    // Return: false if the file can't be created
+    bool open(const char *path)
+    {
+        file_ = fopen(path, "wb");
+        if (file_ == NULL)
+        {
+            return false;
+        }
+        fwrite(RECORDING_MAGIC, 1, 4, file_);
+        recordingPut32(file_, RECORDING_FILE_VERSION);
+        return true;
+    }
+
+    // Description: Adds a record to the open chunk
+    // Parameters: record and its length
+    // Return: none
+    void add(const uint8_t *record, size_t length)
+    {
+        chunk_.push_back(length & 0xFF);
+        chunk_.push_back(length >> 8);
+        chunk_.insert(chunk_.end(), record, record + length);
+    }
+
+    // Description: Writes the open chunk out and flushes the file
+    // Parameters: none
+    // Return: none
+    void flush()
+    {
+        if (file_ == NULL || chunk_.empty())
+        {
+            return;
+        }
+        fwrite(RECORDING_CHUNK_RECORDS, 1, 4, file_);
+        recordingPut32(file_, chunk_.size());
+        fwrite(chunk_.data(), 1, chunk_.size(), file_);
+        fflush(file_);
+        chunk_.clear();
+    }
+
+    void close()
+    {
+        flush();
+        if (file_ != NULL)
+        {
+            fclose(file_);
+            file_ = NULL;
+        }
+    }
+
+private:
+    FILE *file_ = NULL;
+    std::vector<uint8_t> chunk_;
+};
+
+class RecordingReader
+{
+public:
+    ~RecordingReader()
+    {
+        if (file_ != NULL)
+        {
+            fclose(file_);
+        }
+    }
+
+    // Description: Opens a recording and checks its header
+    // Parameters: path
+    // Return: false if it can't be opened or isn't a recording of a version this build reads
+    bool open(const char *path)
+    {
+        file_ = fopen(path, "rb");
+        char magic[4];
+        uint32_t version;
+        return file_ != NULL && fread(magic, 1, 4, file_) == 4 && memcmp(magic, RECORDING_MAGIC, 4) == 0 &&
+               recordingGet32(file_, version) && version == RECORDING_FILE_VERSION;
+    }
+
+    // Description: Reads the next record
+    // Parameters: record to fill and its length
+    // Return: false at the end of the recording(or where a cut short chunk starts)
+    bool next(std::vector<uint8_t> &record)
+    {
+        while (position_ + 2 > chunk_.size() || position_ + 2 + (chunk_[position_] | chunk_[position_ + 1] << 8) > chunk_.size())
+        {
+            if (!readChunk())
+            {
+                return false;
+            }
+        }
+        size_t length = chunk_[position_] | chunk_[position_ + 1] << 8;
+        record.assign(chunk_.begin() + position_ + 2, chunk_.begin() + position_ + 2 + length);
+        position_ += 2 + length;
+        return true;
+    }
+
+private:
+    // Description: Loads the next records chunk, skipping chunks of other kinds
+    // Parameters: none
+    // Return: false at the end of the file
+    bool readChunk()
+    {
+        char fourcc[4];
+        uint32_t length;
+        while (file_ != NULL && fread(fourcc, 1, 4, file_) == 4 && recordingGet32(file_, length))
+        {
+            if (memcmp(fourcc, RECORDING_CHUNK_RECORDS, 4) != 0)
+            {
+                fseek(file_, length, SEEK_CUR);
+                continue;
+            }
+            chunk_.resize(length);
+            position_ = 0;
+            return fread(chunk_.data(), 1, length, file_) == length;
+        }
+        return false;
+    }
+
+    FILE *file_ = NULL;
+    std::vector<uint8_t> chunk_;
+    size_t position_ = 0;
+};
@@ -0,0 +1,165 @@
+// Records the raw sensor session the glove streams on the USB Serial with RAW_SENSOR_CAPTURE
+// (main/SensorRecording.h) into a recording file(RecordingFile.h) for SensorReplay and FirmwareSimulation.
+// Stops at the end of the input or on Ctrl+C. Text other tasks print between records(boot messages) goes to
+// stderr, the summary counts passes per phase, passes lost on the glove or the link(sequence gaps) and corrupt
+// blocks.
+//
+// Record from the port, from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j
+//   stty -F /dev/ttyACM0 115200 raw && ./build/SensorRecorder /dev/ttyACM0 session.ehr
+//   ./build/SensorRecorder <port | capture | -> <recording.ehr>
+
+#include <csignal>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "RecordingFile.h"
+#include "SensorRecording.h"
+
+// Passes per chunk of the file
+#define PASSES_PER_CHUNK 50
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    stopRequested = 1;
+}
+
+// Description: Whether bytes between records are text printed by the firmware
+// Parameters: bytes and their count
+// Return: true if nearly all of them are printable
+static bool isText(const uint8_t *data, size_t length)
+{
+    size_t printable = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        printable += isprint(data[i]) || data[i] == '\n' || data[i] == '\r' || data[i] == '\t';
+    }
+    return printable * 10 >= length * 9;
+}
+
+// Description: Finds the record in a block, text printed right before a record ends up in front of it in the
+// same block and always ends with a new line
+// Parameters: block, record output(SENSOR_FRAME_MAX_BYTES), record length to fill
+// Return: length of the text in front of the record, the whole block if it holds no record
+static size_t splitBlock(const std::vector<uint8_t> &block, uint8_t *record, size_t &recordLength)
+{
+    for (size_t start = 0; start < block.size(); start++)
+    {
+        if (start > 0 && block[start - 1] != '\n')
+        {
+            continue;
+        }
+        recordLength = unframeSensorRecord(block.data() + start, block.size() - start, record);
+        if (recordLength > 0)
+        {
+            return start;
+        }
+    }
+    recordLength = 0;
+    return block.size();
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <port | capture | -> <recording.ehr>\n", argv[0]);
+        return 1;
+    }
+    FILE *input = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (input == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+    RecordingWriter writer;
+    if (!writer.open(argv[2]))
+    {
+        fprintf(stderr, "Can't create %s\n", argv[2]);
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+
+    std::vector<uint8_t> block;
+    uint8_t record[SENSOR_FRAME_MAX_BYTES];
+    uint8_t lastCalibration[SENSOR_CALIBRATION_BYTES];
+    bool haveCalibration = false;
+    uint32_t calibrations = 0;
+    uint32_t passes[3] = {0, 0, 0};
+    uint32_t chunkPasses = 0;
+    uint32_t lost = 0;
+    uint32_t corrupt = 0;
+    bool haveSequence = false;
+    uint16_t nextSequence = 0;
+    SensorPass pass;
+
+    // Unbuffered reads so the file keeps up with the glove when reading a port
+    int byte;
+    while (!stopRequested && (byte = fgetc(input)) != EOF)
+    {
+        if (byte != 0)
+        {
+            block.push_back(byte);
+            continue;
+        }
+
+        size_t length;
+        size_t textLength = splitBlock(block, record, length);
+        if (textLength > 0 && isText(block.data(), textLength))
+        {
+            fwrite(block.data(), 1, textLength, stderr);
+        }
+        else if (textLength > 0)
+        {
+            corrupt++;
+        }
+        block.clear();
+        if (length == 0)
+        {
+            continue;
+        }
+
+        // The glove repeats its calibration every few seconds, keep it once per change
+        SensorCalibration calibration;
+        if (decodeSensorCalibration(record, length, calibration))
+        {
+            if (!haveCalibration || memcmp(lastCalibration, record, length) != 0)
+            {
+                memcpy(lastCalibration, record, length);
+                haveCalibration = true;
+                calibrations++;
+                writer.add(record, length);
+            }
+            continue;
+        }
+        if (!decodeSensorPass(record, length, pass) || pass.phase > SENSOR_PHASE_RUN)
+        {
+            corrupt++;
+            continue;
+        }
+
+        passes[pass.phase]++;
+        lost += haveSequence ? (uint16_t)(pass.sequence - nextSequence) : 0;
+        haveSequence = true;
+        nextSequence = pass.sequence + 1;
+        writer.add(record, length);
+        if (++chunkPasses == PASSES_PER_CHUNK)
+        {
+            writer.flush();
+            chunkPasses = 0;
+        }
+    }
+    writer.close();
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+
+    fprintf(stderr, "%u open, %u closed and %u run passes, %u calibrations, %u passes lost, %u corrupt blocks\n",
+            passes[SENSOR_PHASE_OPEN], passes[SENSOR_PHASE_CLOSED], passes[SENSOR_PHASE_RUN], calibrations, lost, corrupt);
+    return passes[SENSOR_PHASE_RUN] > 0 ? 0 : 1;
+}
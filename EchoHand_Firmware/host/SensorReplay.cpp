@@ -0,0 +1,232 @@
+// Replays a raw sensor recording(SensorRecorder, RecordingFile.h) through this build's filter, calibration,
+// finger mapping, trigger and OpenGloves encoding(main/SensorFilter.h, main/OpenGlovesCodec.h), the acquisition
+// and comms path of the glove without the hardware. Every run pass is compared with the finger values and
+// buttons the glove computed when it was recorded, so a change to POLL_METHOD, CALIBRATION_METHOD or the filters
+// shows which passes it changes and by how much. The OpenGloves lines go to a file or stdout, with --realtime
+// paced like the recording so they can be piped into the visual simulator.
+//
+// By default the run passes use the calibration the glove recorded: calibration reads faster than the link, most
+// calibration passes never make it into the recording. --recalibrate recomputes it from the calibration passes
+// that did, with this build's POLL_METHOD and CALIBRATION_METHOD.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j
+//   ./build/SensorReplay <recording.ehr> [lines.txt | -] [--realtime] [--recalibrate]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "config.h"
+#include "OpenGlovesCodec.h"
+#include "RecordingFile.h"
+#include "SensorFilter.h"
+#include "SensorRecording.h"
+
+// Flex sensors are the first five bursts of every pass, in finger order
+#define FLEX_BURSTS 5
+
+// Description: Filters one recorded burst the way readSmooth() does
+// Parameters: burst
+// Return: filtered reading in mV
+static int filterBurst(const SensorBurst &burst)
+{
+    int samples[SENSOR_BURST_MAX_SAMPLES];
+    for (uint8_t i = 0; i < burst.count; i++)
+    {
+        samples[i] = burst.samples[i];
+    }
+    return burst.count > 0 ? filterSamples(samples, burst.count, POLL_METHOD) : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *recordingPath = NULL;
+    const char *linesPath = NULL;
+    bool realtime = false;
+    bool recalibrate = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--realtime") == 0)
+        {
+            realtime = true;
+        }
+        else if (strcmp(argv[i], "--recalibrate") == 0)
+        {
+            recalibrate = true;
+        }
+        else if (recordingPath == NULL)
+        {
+            recordingPath = argv[i];
+        }
+        else
+        {
+            linesPath = argv[i];
+        }
+    }
+    if (recordingPath == NULL)
+    {
+        fprintf(stderr, "Usage: %s <recording.ehr> [lines.txt | -] [--realtime] [--recalibrate]\n", argv[0]);
+        return 1;
+    }
+
+    RecordingReader reader;
+    if (!reader.open(recordingPath))
+    {
+        fprintf(stderr, "Can't read %s\n", recordingPath);
+        return 1;
+    }
+    FILE *lines = NULL;
+    if (linesPath != NULL)
+    {
+        lines = strcmp(linesPath, "-") == 0 ? stdout : fopen(linesPath, "w");
+        if (lines == NULL)
+        {
+            fprintf(stderr, "Can't open %s\n", linesPath);
+            return 1;
+        }
+    }
+
+    // The summary goes to stderr when the lines go to stdout
+    FILE *report = lines == stdout ? stderr : stdout;
+
+    FlexCalibrator calibrators[5];
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        calibrators[i].begin(CALIBRATION_METHOD);
+    }
+    uint32_t calibrationPasses[2] = {0, 0};
+    bool haveCalibration = false;
+    long long openValues[5];
+    long long closedValues[5];
+
+    uint32_t runPasses = 0;
+    uint32_t matching = 0;
+    uint32_t buttonMismatches = 0;
+    uint32_t fingerMismatches[5] = {0, 0, 0, 0, 0};
+    int maxDifference[5] = {0, 0, 0, 0, 0};
+    uint32_t firstRunUs = 0;
+    std::chrono::steady_clock::time_point wallStart;
+
+    std::vector<uint8_t> record;
+    SensorPass pass;
+    SensorCalibration calibration;
+    while (reader.next(record))
+    {
+        if (decodeSensorCalibration(record.data(), record.size(), calibration))
+        {
+            if (!haveCalibration)
+            {
+                fprintf(report, "Recorded with POLL_METHOD %u, CALIBRATION_METHOD %u, POT_SAMPLE_RATE %u%s\n",
+                        calibration.pollMethod, calibration.calibrationMethod, calibration.sampleRate,
+                        (calibration.flags & SENSOR_FLAG_SIMULATION) ? ", calibration skipped(SIMULATION)" : "");
+                if (calibration.pollMethod != POLL_METHOD || calibration.calibrationMethod != CALIBRATION_METHOD)
+                {
+                    fprintf(report, "This build uses POLL_METHOD %d, CALIBRATION_METHOD %d, mismatches are expected\n",
+                            POLL_METHOD, CALIBRATION_METHOD);
+                }
+            }
+
+            // The recalibrated end points stay once computed, the glove repeats its record unchanged
+            bool recomputed = recalibrate && !(calibration.flags & SENSOR_FLAG_SIMULATION) && calibrationPasses[0] > 0 &&
+                              calibrationPasses[1] > 0;
+            for (uint8_t i = 0; !haveCalibration && i < 5; i++)
+            {
+                openValues[i] = recomputed ? calibrators[i].openValue() : calibration.openValues[i];
+                closedValues[i] = recomputed ? calibrators[i].closedValue() : calibration.closedValues[i];
+            }
+            if (recalibrate && !haveCalibration)
+            {
+                fprintf(report, recomputed ? "Recalibrated from %u open and %u closed passes\n"
+                                           : "No calibration passes to recalibrate from(%u open, %u closed), using the recorded one\n",
+                        calibrationPasses[0], calibrationPasses[1]);
+            }
+            haveCalibration = true;
+            continue;
+        }
+        if (!decodeSensorPass(record.data(), record.size(), pass) || pass.burstCount < FLEX_BURSTS)
+        {
+            continue;
+        }
+
+        if (pass.phase == SENSOR_PHASE_OPEN || pass.phase == SENSOR_PHASE_CLOSED)
+        {
+            calibrationPasses[pass.phase]++;
+            for (uint8_t i = 0; i < 5; i++)
+            {
+                int reading = filterBurst(pass.bursts[i]);
+                pass.phase == SENSOR_PHASE_OPEN ? calibrators[i].addOpen(reading) : calibrators[i].addClosed(reading);
+            }
+            continue;
+        }
+        if (!haveCalibration)
+        {
+            // Run passes before the first calibration record can't be mapped
+            continue;
+        }
+
+        // Acquisition task: filter, map, trigger
+        InputsPayload in;
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            in.fingerAngles[i] = flexToFinger(filterBurst(pass.bursts[i]), closedValues[i], openValues[i], CALIBRATION_METHOD == 1);
+        }
+        in.joystickXY[0] = pass.joystickXY[0];
+        in.joystickXY[1] = pass.joystickXY[1];
+        in.buttonsBitmask = pass.buttonsBitmask & (JOYSTICK_BUTTON_BITMASK | A_BUTTON_BITMASK | B_BUTTON_BITMASK);
+        if (in.fingerAngles[0] + in.fingerAngles[1] + in.fingerAngles[2] + in.fingerAngles[3] + in.fingerAngles[4] >= 4095 * 2)
+        {
+            in.buttonsBitmask |= TRIGGER_BUTTON_BITMASK;
+        }
+
+        // Against what the glove computed
+        runPasses++;
+        bool same = in.buttonsBitmask == pass.buttonsBitmask;
+        buttonMismatches += !same;
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            int difference = abs(in.fingerAngles[i] - pass.fingerAngles[i]);
+            fingerMismatches[i] += difference != 0;
+            maxDifference[i] = difference > maxDifference[i] ? difference : maxDifference[i];
+            same = same && difference == 0;
+        }
+        matching += same;
+
+        if (lines != NULL)
+        {
+            if (realtime)
+            {
+                // Pace the lines like the glove sampled them
+                if (runPasses == 1)
+                {
+                    firstRunUs = pass.timeUs;
+                    wallStart = std::chrono::steady_clock::now();
+                }
+                std::this_thread::sleep_until(wallStart + std::chrono::microseconds(pass.timeUs - firstRunUs));
+            }
+            char line[OPENGLOVES_MAX_LINE];
+            size_t length = encodeOpenGlovesInputs(in, true, line, sizeof(line));
+            fwrite(line, 1, length, lines);
+            if (realtime)
+            {
+                fflush(lines);
+            }
+        }
+    }
+    if (lines != NULL && lines != stdout)
+    {
+        fclose(lines);
+    }
+
+    fprintf(report, "%u open and %u closed calibration passes, %u run passes replayed, %u match the glove\n",
+            calibrationPasses[0], calibrationPasses[1], runPasses, matching);
+    fprintf(report, "Buttons differ in %u passes\n", buttonMismatches);
+    const char *fingerNames[5] = {"Thumb", "Index", "Middle", "Ring", "Pinkie"};
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        fprintf(report, "  %-6s differs in %u passes, by up to %d\n", fingerNames[i], fingerMismatches[i], maxDifference[i]);
+    }
+    return runPasses > 0 ? 0 : 1;
+}
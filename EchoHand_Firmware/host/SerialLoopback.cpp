@@ -0,0 +1,355 @@
+// Loopback throughput of the simulator's serial frontend(EchoHand_Simulator/src/serial.cpp) over a pseudo
+// terminal: a writer thread plays the glove and writes OpenGloves lines from the firmware's encoder into the pty
+// master, SerialDevice reads them from the slave like it reads /dev/ttyACM0. Every line is checked against the
+// one sent, lines/s is measured from the first line in to the last. The same stream is then read one byte per
+// read() call, the way the frontend used to, for comparison. Last the frontend's GloveLink(glovelink.h) parses the
+// stream on its I/O thread while a 60 Hz loop plays the render thread: every line sent has to be parsed, the last
+// state has to reach the render loop and the frame gaps show whether the link ever holds a frame up. A rate
+// limits the writer to check the frontend keeps up with a glove sending that many lines a second(1000 for
+// 1 kHz) instead of measuring its ceiling.
+//
+// Build and run from EchoHand_Firmware/host(Linux/POSIX only):
+//   cmake -S . -B build && cmake --build build -j && ./build/SerialLoopback [seconds] [lines per second, 0 max]
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include "OpenGlovesCodec.h"
+#include "serial.h"
+#include "glovelink.h"
+
+// Lines per write() call of the writer, about what the glove's USB CDC hands over per transfer
+#define LINES_PER_WRITE 16
+
+// Frame rate of the stand-in render loop
+#define RENDER_FPS 60
+
+struct LoopbackResult
+{
+    uint64_t lines = 0;
+    uint64_t wrong = 0;
+    double seconds = 0;
+
+    // Render loop frames and the longest gap between two(GloveLink run only)
+    uint64_t frames = 0;
+    double maxFrameMs = 0;
+};
+
+// Description: The line the glove sends n-th, every finger and button changes from line to line
+// Parameters: line number, buffer of OPENGLOVES_MAX_LINE bytes
+// Return: line length including its '\n'
+static size_t makeLine(uint64_t n, char *line)
+{
+    InputsPayload in{};
+    for (int i = 0; i < 5; i++)
+    {
+        in.fingerAngles[i] = (n * 7 + i * 811) % 4096;
+    }
+    in.joystickXY[0] = n % 4096;
+    in.joystickXY[1] = 4095 - n % 4096;
+    in.buttonsBitmask = n & 0xF;
+    return encodeOpenGlovesInputs(in, true, line, OPENGLOVES_MAX_LINE);
+}
+
+// Set by the reader when it stops reading, so a writer waiting on a full pty gives up
+static std::atomic<bool> readerStopped(false);
+
+// Description: Plays the glove, writes lines into the pty master until the time is up, then hangs up
+// Parameters: non-blocking master fd, run time, line rate(0 as fast as the pty takes them)
+// Return: lines written
+static uint64_t writeLines(int master, double seconds, uint32_t rate)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    char batch[LINES_PER_WRITE * OPENGLOVES_MAX_LINE];
+    uint64_t n = 0;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        if (rate > 0)
+        {
+            // Hold back until the batch is due
+            std::this_thread::sleep_until(start + std::chrono::microseconds(n * 1000000 / rate));
+        }
+        size_t length = 0;
+        for (int i = 0; i < LINES_PER_WRITE; i++)
+        {
+            length += makeLine(n++, batch + length);
+        }
+        for (size_t written = 0; written < length;)
+        {
+            ssize_t count = write(master, batch + written, length - written);
+            if (count > 0)
+            {
+                written += count;
+                continue;
+            }
+            if (errno != EAGAIN || readerStopped)
+            {
+                return n - LINES_PER_WRITE;
+            }
+            pollfd wait = {master, POLLOUT, 0};
+            poll(&wait, 1, SERIAL_READ_TIMEOUT_MS);
+        }
+    }
+
+    // Hanging up flushes what the slave hasn't read yet, give the reader time to take the last lines
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    return n;
+}
+
+// Description: Checks a received line against the one sent
+// Parameters: result to count into, line without its '\n'
+// Return: none
+static void checkLine(LoopbackResult &result, const std::string &line)
+{
+    char expected[OPENGLOVES_MAX_LINE];
+    size_t length = makeLine(result.lines++, expected);
+    result.wrong += line.size() + 1 != length || memcmp(line.data(), expected, line.size()) != 0;
+}
+
+// Description: Opens a pty pair in raw mode
+// Parameters: master fd to fill, slave path to fill
+// Return: false if the system has no ptys to give
+static bool openPty(int &master, std::string &slavePath)
+{
+    readerStopped = false;
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+        return false;
+    }
+    slavePath = ptsname(master);
+
+    // The master side mustn't echo or translate either
+    termios tty;
+    tcgetattr(master, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(master, TCSANOW, &tty);
+    return true;
+}
+
+// Description: Runs the writer against SerialDevice's bulk reads
+// Parameters: run time, line rate
+// Return: lines received and the time they took
+static LoopbackResult runBulk(double seconds, uint32_t rate)
+{
+    LoopbackResult result;
+    int master;
+    std::string slavePath;
+    if (!openPty(master, slavePath))
+    {
+        return result;
+    }
+    SerialDevice device(slavePath, 115200, false, 8, 1, false);
+    if (!device.connect())
+    {
+        ::close(master);
+        return result;
+    }
+
+    std::thread writer([&] {
+        writeLines(master, seconds, rate);
+        ::close(master);
+    });
+    std::string line;
+    std::chrono::steady_clock::time_point first;
+    std::chrono::steady_clock::time_point last;
+    while (device.isConnected())
+    {
+        if (device.readLine(line))
+        {
+            last = std::chrono::steady_clock::now();
+            first = result.lines == 0 ? last : first;
+            checkLine(result, line);
+        }
+    }
+    readerStopped = true;
+    writer.join();
+    result.seconds = std::chrono::duration<double>(last - first).count();
+    return result;
+}
+
+// Description: Runs the writer against one read() per byte, the frontend's old way of reading
+// Parameters: run time, line rate
+// Return: lines received and the time they took
+static LoopbackResult runBytewise(double seconds, uint32_t rate)
+{
+    LoopbackResult result;
+    int master;
+    std::string slavePath;
+    if (!openPty(master, slavePath))
+    {
+        return result;
+    }
+    int fd = open(slavePath.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    termios tty;
+    tcgetattr(fd, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(fd, TCSANOW, &tty);
+
+    std::thread writer([&] {
+        writeLines(master, seconds, rate);
+        ::close(master);
+    });
+    std::string line;
+    std::chrono::steady_clock::time_point first;
+    std::chrono::steady_clock::time_point last;
+    for (;;)
+    {
+        char ch;
+        ssize_t count = read(fd, &ch, 1);
+        if (count == 1)
+        {
+            if (ch != '\n')
+            {
+                line += ch;
+                continue;
+            }
+            last = std::chrono::steady_clock::now();
+            first = result.lines == 0 ? last : first;
+            checkLine(result, line);
+            line.clear();
+            continue;
+        }
+        if (count == 0 || errno != EAGAIN)
+        {
+            break;
+        }
+        pollfd wait = {fd, POLLIN, 0};
+        poll(&wait, 1, SERIAL_READ_TIMEOUT_MS);
+    }
+    ::close(fd);
+    readerStopped = true;
+    writer.join();
+    result.seconds = std::chrono::duration<double>(last - first).count();
+    return result;
+}
+
+// Description: Runs the writer against GloveLink's I/O thread with a 60 Hz render loop taking its state
+// Parameters: run time, line rate
+// Return: lines parsed, lines lost plus a wrong last state, frames and the longest frame gap
+static LoopbackResult runLink(double seconds, uint32_t rate)
+{
+    LoopbackResult result;
+    int master;
+    std::string slavePath;
+    if (!openPty(master, slavePath))
+    {
+        return result;
+    }
+    SerialDevice device(slavePath, 115200, false, 8, 1, false);
+    if (!device.connect())
+    {
+        ::close(master);
+        return result;
+    }
+
+    uint64_t sent = 0;
+    std::thread writer([&] {
+        sent = writeLines(master, seconds, rate);
+        ::close(master);
+    });
+    GloveLink link;
+    link.start([&device](std::string &line) -> int {
+        if (device.readLine(line))
+        {
+            return 1;
+        }
+        return device.isConnected() ? 0 : -1;
+    });
+
+    // Render thread stand-in, frames on a fixed cadence whatever the link does
+    OpenGlovesData shown;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastFrame = start;
+    std::chrono::steady_clock::time_point lastPacket = start;
+    uint64_t packets = 0;
+    while (link.isOpen())
+    {
+        std::this_thread::sleep_until(start + std::chrono::microseconds((result.frames + 1) * 1000000 / RENDER_FPS));
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        double frameMs = std::chrono::duration<double, std::milli>(now - lastFrame).count();
+        result.maxFrameMs = frameMs > result.maxFrameMs ? frameMs : result.maxFrameMs;
+        lastFrame = now;
+        result.frames++;
+        link.takeLatest(shown);
+        if (link.packetCount() != packets)
+        {
+            packets = link.packetCount();
+            lastPacket = now;
+        }
+    }
+    link.stop();
+    readerStopped = true;
+    writer.join();
+    link.takeLatest(shown);
+
+    // The last line sent is the state the window has to end on
+    char lastLine[OPENGLOVES_MAX_LINE];
+    OpenGlovesData expected;
+    size_t length = makeLine(sent - 1, lastLine);
+    lastLine[length - 1] = '\0';
+    parseOpenGlovesPayload(lastLine, expected);
+
+    result.lines = link.packetCount();
+    result.wrong = (sent - result.lines) + (shown.fingerCurl != expected.fingerCurl || shown.joystickX != expected.joystickX);
+    result.seconds = std::chrono::duration<double>(lastPacket - start).count();
+    return result;
+}
+
+// Description: Prints one run
+// Parameters: label, result, line rate asked for
+// Return: none
+static void printResult(const char *label, const LoopbackResult &result, uint32_t rate)
+{
+    double linesPerSecond = result.seconds > 0 ? result.lines / result.seconds : 0;
+    printf("%-22s %10llu lines %8.2f s %12.0f lines/s %6llu wrong", label, (unsigned long long)result.lines,
+           result.seconds, linesPerSecond, (unsigned long long)result.wrong);
+    if (rate > 0)
+    {
+        printf("  %s", linesPerSecond >= rate * 0.99 ? "keeps up" : "FALLS BEHIND");
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 3.0;
+    uint32_t rate = argc > 2 ? atoi(argv[2]) : 0;
+
+    // SerialDevice reports opening and closing the port, keep stdout for the results
+    std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+    LoopbackResult bulk = runBulk(seconds, rate);
+    LoopbackResult bytewise = runBytewise(seconds, rate);
+    LoopbackResult link = runLink(seconds, rate);
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    if (bulk.lines == 0)
+    {
+        printf("No lines came through the pty loopback\n");
+        return 1;
+    }
+    if (rate > 0)
+    {
+        printf("Writer at %u lines/s\n", rate);
+    }
+    else
+    {
+        printf("Writer as fast as the pty takes lines\n");
+    }
+    printResult("SerialDevice bulk", bulk, rate);
+    printResult("read() per byte", bytewise, rate);
+    printResult("GloveLink + render", link, rate);
+    printf("%-22s %10llu frames at %d Hz, longest gap %.1f ms\n", "", (unsigned long long)link.frames, RENDER_FPS, link.maxFrameMs);
+    return bulk.wrong == 0 && bytewise.wrong == 0 && link.wrong == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// Current/energy model of the glove's five haptic servos with and without the idle release policy.
+// Runs the real ServoIdlePolicy from main/ over a deterministic FFB trace in 1 ms virtual steps and
+// integrates an assumed current draw per servo state, then turns the mean current into battery life.
+// The currents are estimates for 9g class metal gear servos on a 5V rail, edit them to match measured values.
+//
+// Build and run from EchoHand_Firmware/host:
+//   g++ -std=c++17 -O2 -I ../main ServoEnergyModel.cpp -o ServoEnergyModel && ./ServoEnergyModel
+
+#include <cstdio>
+#include <cstdint>
+#include "ServoIdlePolicy.h"
+
+// Small deterministic PRNG so results don't depend on the host's std library
+struct XorShift32
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+// Assumed currents in mA
+static const double BASELINE_MA = 95.0;        // ESP32-S3 with the radio up and the sensor task running
+static const double HOLD_RELAXED_MA = 22.0;    // servo pulsed at its end stop, holding against the spool spring
+static const double HOLD_FORCE_MA = 160.0;     // servo holding against a finger pushing on the spool
+static const double RELEASED_MA = 5.0;         // servo powered but without pulses
+static const double ENGAGE_MA = 250.0;         // extra current while a released servo snaps back to position
+static const uint32_t ENGAGE_MS = 40;          // how long that takes
+static const double BATTERY_MAH = 2000.0;
+
+static const uint32_t SIMULATION_MS = 3600000; // one hour of play
+static const uint32_t SERVO_TRAVEL_MS = 120;   // time to move between relaxed and a force target
+
+// How a session uses force feedback
+struct UsageProfile
+{
+    const char *name;
+    uint32_t forceChancePerSecondPermille; // chance per finger per second of a grab starting
+    uint32_t minGrabMs;
+    uint32_t maxGrabMs;
+};
+
+struct ModelResult
+{
+    double meanMa = 0;
+    double forceFraction = 0;
+    uint32_t releases = 0;
+    uint32_t engages = 0;
+};
+
+// Description: Integrates the current of all five servos over the usage profile
+// Parameters: usage profile, idleRelease enables the policy, release delay in ms
+// Return: mean current and policy counters
+ModelResult runModel(const UsageProfile &usage, bool idleRelease, uint32_t releaseDelayMs)
+{
+    XorShift32 rng = {0x1234567u};
+    ServoIdlePolicy policies[5];
+    uint32_t grabEndMs[5] = {0, 0, 0, 0, 0};
+    uint32_t lastChangeMs[5] = {0, 0, 0, 0, 0};
+    bool force[5] = {false, false, false, false, false};
+    uint32_t engageUntilMs[5] = {0, 0, 0, 0, 0};
+    double chargeMaMs = 0;
+    uint64_t forceMs = 0;
+    ModelResult result;
+
+    for (int i = 0; i < 5; i++)
+    {
+        policies[i].setReleaseDelayMs(releaseDelayMs);
+    }
+
+    for (uint32_t now = 0; now < SIMULATION_MS; now++)
+    {
+        double current = BASELINE_MA;
+        for (int i = 0; i < 5; i++)
+        {
+            // Unity grabs and lets go of things
+            if (force[i] && now >= grabEndMs[i])
+            {
+                force[i] = false;
+                lastChangeMs[i] = now;
+            }
+            else if (!force[i] && now % 1000 == 0 && rng.next() % 1000 < usage.forceChancePerSecondPermille)
+            {
+                force[i] = true;
+                lastChangeMs[i] = now;
+                grabEndMs[i] = now + usage.minGrabMs + rng.next() % (usage.maxGrabMs - usage.minGrabMs + 1);
+            }
+            bool resting = now - lastChangeMs[i] >= SERVO_TRAVEL_MS;
+
+            bool engaged = true;
+            if (idleRelease)
+            {
+                ServoIdleAction action = policies[i].update(now, force[i], resting);
+                if (action == SERVO_ACTION_ENGAGE)
+                {
+                    engageUntilMs[i] = now + ENGAGE_MS;
+                }
+                engaged = policies[i].engaged();
+            }
+
+            if (!engaged)
+            {
+                current += RELEASED_MA;
+            }
+            else
+            {
+                current += force[i] ? HOLD_FORCE_MA : HOLD_RELAXED_MA;
+            }
+            if (now < engageUntilMs[i])
+            {
+                current += ENGAGE_MA;
+            }
+            forceMs += force[i] ? 1 : 0;
+        }
+        chargeMaMs += current;
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        result.releases += policies[i].releases();
+        result.engages += policies[i].engages();
+    }
+    result.meanMa = chargeMaMs / SIMULATION_MS;
+    result.forceFraction = (double)forceMs / (5.0 * SIMULATION_MS);
+    return result;
+}
+
+int main()
+{
+    const UsageProfile profiles[] = {
+        {"menus/idle", 20, 300, 1500},
+        {"typical game", 150, 500, 3000},
+        {"grab heavy", 400, 1000, 5000},
+    };
+    const uint32_t releaseDelays[] = {200, 500, 2000};
+
+    printf("Assumed: baseline %.0fmA, per servo relaxed hold %.0fmA, force hold %.0fmA, released %.0fmA, "
+           "re-engage +%.0fmA for %ums, battery %.0fmAh\n\n",
+           BASELINE_MA, HOLD_RELAXED_MA, HOLD_FORCE_MA, RELEASED_MA, ENGAGE_MA, ENGAGE_MS, BATTERY_MAH);
+    printf("%-14s %7s %10s %9s %9s %9s %9s %8s\n",
+           "usage", "force%", "policy", "meanMa", "life(h)", "gain", "releases", "engages");
+    for (const UsageProfile &usage : profiles)
+    {
+        ModelResult hold = runModel(usage, false, 0);
+        double holdHours = BATTERY_MAH / hold.meanMa;
+        printf("%-14s %6.1f%% %10s %8.1f %9.2f %9s %9s %8s\n",
+               usage.name, 100.0 * hold.forceFraction, "always on", hold.meanMa, holdHours, "-", "-", "-");
+
+        for (uint32_t delay : releaseDelays)
+        {
+            ModelResult idle = runModel(usage, true, delay);
+            double idleHours = BATTERY_MAH / idle.meanMa;
+            char policy[16];
+            snprintf(policy, sizeof(policy), "rel %ums", delay);
+            printf("%-14s %6.1f%% %10s %8.1f %9.2f %+8.1f%% %9u %8u\n",
+                   usage.name, 100.0 * idle.forceFraction, policy, idle.meanMa, idleHours,
+                   100.0 * (idleHours - holdHours) / holdHours, idle.releases, idle.engages);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Settling check of the servo motion profile(main/ServoMotionProfile.h). Random targets, integer ones like the old
+// haptic lines and fractional ones like the force loop and finger pre-positioning command, arrive at random FFB
+// periods and the profile is stepped at SERVO_CONTROL_HZ. After the last target every run has to end settled, on
+// the target exactly, within the time the limits allow: a profile that never settles keeps the servo task from
+// sleeping and the finger from being idle released.
+//
+// Build and run from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j && ./build/ServoProfileCheck [runs per kind] [seed]
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include "config.h"
+#include "ServoMotionProfile.h"
+
+// Longest a run may take to settle after its last target, a full 180 degree move at the slowest finger's limits is
+// well inside it
+#define SETTLE_LIMIT_S 2.0f
+
+struct CheckCounts
+{
+    unsigned long runs = 0;
+    unsigned long unsettled = 0;
+    unsigned long offTarget = 0;
+};
+
+// Description: Runs one profile through a few targets and waits for it to settle on the last one
+// Parameters: counts to update, random generator, finger(for its limits), whether targets are whole degrees
+// Return: none
+static void checkRun(CheckCounts &counts, std::mt19937 &rng, int finger, bool fractional)
+{
+    const uint32_t periodUs = 1000000 / SERVO_CONTROL_HZ;
+    std::uniform_real_distribution<float> angle(0.0f, 180.0f);
+    std::uniform_int_distribution<uint32_t> ffbPeriod(4000, 40000);
+
+    ServoMotionProfile profile;
+    profile.setLimits({SERVO_MAX_VELOCITY[finger], SERVO_MAX_ACCELERATION[finger]});
+    profile.reset(fractional ? angle(rng) : (int)angle(rng));
+
+    uint32_t nowUs = 0;
+    float target = 0;
+    int targets = 1 + rng() % 6;
+    for (int t = 0; t < targets; t++)
+    {
+        target = fractional ? angle(rng) : (int)angle(rng);
+        profile.setTarget(target, nowUs);
+        uint32_t nextUs = nowUs + ffbPeriod(rng);
+        while (nowUs < nextUs)
+        {
+            profile.update(periodUs);
+            nowUs += periodUs;
+        }
+    }
+
+    uint32_t steps = 0;
+    while (!profile.settled() && steps < SETTLE_LIMIT_S * SERVO_CONTROL_HZ)
+    {
+        profile.update(periodUs);
+        steps++;
+    }
+
+    counts.runs++;
+    if (!profile.settled())
+    {
+        if (counts.unsettled++ < 5)
+        {
+            fprintf(stderr, "Never settled: target %.8f position %.8f velocity %.8f\n", target, profile.position(), profile.velocity());
+        }
+    }
+    else if (profile.position() != target)
+    {
+        counts.offTarget++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long perKind = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+    unsigned int seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1;
+    std::mt19937 rng(seed);
+
+    CheckCounts whole, fractional;
+    for (unsigned long i = 0; i < perKind; i++)
+    {
+        checkRun(whole, rng, i % 5, false);
+        checkRun(fractional, rng, i % 5, true);
+    }
+
+    printf("%-12s %8lu runs %6lu never settled %6lu settled off target\n", "integer", whole.runs, whole.unsettled, whole.offTarget);
+    printf("%-12s %8lu runs %6lu never settled %6lu settled off target\n", "fractional", fractional.runs, fractional.unsettled, fractional.offTarget);
+    return whole.unsettled + whole.offTarget + fractional.unsettled + fractional.offTarget == 0 ? 0 : 1;
+}
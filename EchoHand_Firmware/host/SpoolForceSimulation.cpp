@@ -0,0 +1,226 @@
+// Host simulation of one haptic spool for tuning the closed loop force control(SERVO_FORCE_FEEDBACK).
+// Runs the real ServoForceEstimator, ServoForcePid and ServoMotionProfile from main/ against a spool model
+// in 0.1 ms virtual steps: a hobby servo whose torque follows its position error up to stall, with
+// inertia, damping and a speed limit, pulling on a finger modelled as a soft spring towards where the
+// user is trying to close it. The pot is sampled with ADC noise at the acquisition task rate,
+// the force loop runs at SERVO_CONTROL_HZ. Prints force tracking for a few gain sets.
+//
+// Build and run from EchoHand_Firmware/host:
+//   g++ -std=c++17 -O2 -I ../main SpoolForceSimulation.cpp -o SpoolForceSimulation && ./SpoolForceSimulation
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "ServoForceControl.h"
+#include "ServoMotionProfile.h"
+
+// Small deterministic PRNG so results don't depend on the host's std library
+struct XorShift32
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    // Roughly gaussian noise with the given standard deviation(sum of uniforms)
+    float noise(float sigma)
+    {
+        float sum = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            sum += (next() % 10000) / 10000.0f - 0.5f;
+        }
+        return sum * sigma * 1.732f;
+    }
+};
+
+// Spool model, torque is in units of the servo's stall torque
+static const float STALL_DEFLECTION = 10.0f;   // degrees off command at stall(SERVO_STALL_DEFLECTION_DEG)
+static const float SPOOL_INERTIA = 1.0f / 20000.0f;
+static const float SPOOL_DAMPING = 1.0f / 600.0f; // terminal speed of 600 deg/s at stall torque
+static const float SERVO_MAX_SPEED = 600.0f;   // degrees per second
+static const float FINGER_COMPLIANCE = 30.0f;  // degrees of finger/strap give at stall torque
+
+// Acquisition and control timing
+static const uint32_t STEP_US = 100;
+static const uint32_t CONTROL_US = 4000;       // SERVO_CONTROL_HZ 250
+static const uint32_t SIMULATION_US = 6000000; // 6 s per scenario
+static const float POT_MV_AT_0 = 300.0f;
+static const float POT_MV_AT_180 = 2700.0f;
+static const float POT_NOISE_MV = 8.0f;        // after readSmooth's median
+
+struct GainSet
+{
+    const char *name;
+    ServoForceGains gains;
+};
+
+struct Scenario
+{
+    const char *name;
+    uint32_t acquisitionUs; // pot sample period of the acquisition task
+};
+
+struct TrackingResult
+{
+    double rmsError = 0;
+    double maxOvershoot = 0;
+    double settleMs = 0;
+    bool neverSettled = false;
+    double stallFraction = 0;
+};
+
+// Description: Force target over time, a grab at 0.3 that firms up to 0.7 and lets go
+// Parameters: time in microseconds
+// Return: force target from 0.0-1.0
+float forceTarget(uint32_t nowUs)
+{
+    if (nowUs < 500000 || nowUs >= 5000000)
+    {
+        return 0;
+    }
+    return nowUs < 2500000 ? 0.3f : 0.7f;
+}
+
+// Description: Where the user is trying to close the finger to, in spool target space
+// Parameters: time in microseconds
+// Return: angle the finger would reach with no glove
+float fingerIntent(uint32_t nowUs)
+{
+    // Squeezing the object harder and softer while holding it
+    return 20.0f + 5.0f * sinf(2.0f * 3.14159f * 0.5f * nowUs * 1e-6f);
+}
+
+// Description: Runs the spool model with one set of gains
+// Parameters: gains, scenario timing
+// Return: force tracking statistics while a target is active
+TrackingResult runScenario(const ServoForceGains &gains, const Scenario &scenario)
+{
+    XorShift32 rng = {0xC0FFEEu};
+    ServoForceEstimator estimator;
+    ServoForcePid pid;
+    ServoMotionProfile profile;
+    estimator.setCalibration({POT_MV_AT_0, POT_MV_AT_180, STALL_DEFLECTION, 0.5f});
+    pid.setGains(gains);
+    profile.reset(0);
+    profile.setLimits({600.0f, 20000.0f});
+
+    float position = 0;
+    float velocity = 0;
+    float command = 0;
+    bool forceActive = false;
+    float lastTarget = 0;
+    uint32_t stepStartUs = 0;
+    bool settled = true;
+    double sumSquares = 0;
+    uint64_t samples = 0;
+    uint64_t stallSteps = 0;
+    TrackingResult result;
+
+    for (uint32_t now = 0; now < SIMULATION_US; now += STEP_US)
+    {
+        float target = forceTarget(now);
+
+        // Acquisition task samples the pot
+        if (now % scenario.acquisitionUs == 0)
+        {
+            float horn = 180.0f - position;
+            float mv = POT_MV_AT_0 + horn * (POT_MV_AT_180 - POT_MV_AT_0) / 180.0f + rng.noise(POT_NOISE_MV);
+            estimator.update(mv, command);
+        }
+
+        // Servo task, mirrors the force path of TaskServoControl
+        if (now % CONTROL_US == 0)
+        {
+            if (target > 0)
+            {
+                if (!forceActive)
+                {
+                    pid.reset(profile.position());
+                    forceActive = true;
+                }
+                profile.setTarget(pid.update(target, estimator.force(), CONTROL_US), now);
+            }
+            else if (forceActive || lastTarget != target)
+            {
+                forceActive = false;
+                profile.setTarget(0, now);
+            }
+            command = profile.update(CONTROL_US);
+        }
+
+        // Spool physics, the finger only pulls once it is closed past the spool
+        float servoTorque = (command - position) / STALL_DEFLECTION;
+        servoTorque = std::max(-1.0f, std::min(1.0f, servoTorque));
+        float fingerTorque = std::max(0.0f, (position - fingerIntent(now)) / FINGER_COMPLIANCE);
+        float acceleration = (servoTorque - fingerTorque - SPOOL_DAMPING * velocity) / SPOOL_INERTIA;
+        velocity += acceleration * STEP_US * 1e-6f;
+        velocity = std::max(-SERVO_MAX_SPEED, std::min(SERVO_MAX_SPEED, velocity));
+        position += velocity * STEP_US * 1e-6f;
+
+        // Real string tension vs target
+        if (target != lastTarget)
+        {
+            result.neverSettled = result.neverSettled || !settled;
+            stepStartUs = now;
+            settled = target == 0;
+            lastTarget = target;
+        }
+        if (target > 0)
+        {
+            float error = fingerTorque - target;
+            if (now - stepStartUs > 300000)
+            {
+                sumSquares += error * error;
+                samples++;
+            }
+            result.maxOvershoot = std::max<double>(result.maxOvershoot, error);
+            if (!settled && fabsf(error) < 0.1f * target)
+            {
+                settled = true;
+                result.settleMs = std::max<double>(result.settleMs, (now - stepStartUs) / 1000.0);
+            }
+            stallSteps += servoTorque >= 1.0f ? 1 : 0;
+        }
+    }
+
+    result.neverSettled = result.neverSettled || !settled;
+    result.rmsError = samples ? sqrt(sumSquares / samples) : 0;
+    result.stallFraction = samples ? (double)stallSteps / samples : 0;
+    return result;
+}
+
+int main()
+{
+    const GainSet gainSets[] = {
+        {"P only", {20.0f, 0.0f, 0.0f}},
+        {"I only", {0.0f, 800.0f, 0.0f}},
+        {"PI soft", {10.0f, 400.0f, 0.0f}},
+        {"PI", {10.0f, 800.0f, 0.0f}},
+        {"PI high", {20.0f, 1600.0f, 0.0f}},
+        {"PID", {10.0f, 800.0f, 0.2f}},
+    };
+    const Scenario scenarios[] = {
+        {"acq 20ms", 20000},
+        {"acq 4ms", 4000},
+    };
+
+    printf("%-10s %-10s %9s %10s %9s %7s\n", "timing", "gains", "rmsError", "overshoot", "settleMs", "stall%");
+    for (const Scenario &scenario : scenarios)
+    {
+        for (const GainSet &set : gainSets)
+        {
+            TrackingResult r = runScenario(set.gains, scenario);
+            char settle[16];
+            snprintf(settle, sizeof(settle), r.neverSettled ? "never" : "%.1f", r.settleMs);
+            printf("%-10s %-10s %9.3f %10.3f %9s %6.1f%%\n",
+                   scenario.name, set.name, r.rmsError, r.maxOvershoot, settle, 100.0 * r.stallFraction);
+        }
+    }
+    return 0;
+}
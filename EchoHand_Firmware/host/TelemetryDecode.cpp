@@ -0,0 +1,237 @@
+// Decodes the binary telemetry the glove streams on the USB Serial with DEBUG_PRINT(main/TelemetryCodec.h) and
+// renders it as the views the firmware used to print itself: the payload status table, Serial Plotter lines or
+// CSV for a spreadsheet. Text other tasks print between frames(boot messages, profiler) goes to stderr, the
+// summary at the end counts frames, frames lost on the link(sequence gaps) and corrupt blocks.
+//
+// Capture the port raw and decode it, from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j
+//   stty -F /dev/ttyACM0 115200 raw && ./build/TelemetryDecode /dev/ttyACM0 table
+//   ./build/TelemetryDecode <capture | -> [table | plotter | csv]
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "TelemetryCodec.h"
+
+enum View
+{
+    VIEW_TABLE,
+    VIEW_PLOTTER,
+    VIEW_CSV
+};
+
+static const char *const fingerNames[5] = {"Thumb ", "Index ", "Middle", "Ring  ", "Pinkie"};
+
+// Description: Prints a frame as the payload status table
+// Parameters: frame
+// Return: none
+static void printTable(const TelemetryFrame &f)
+{
+    printf("\n=== PAYLOAD STATUS === (%.2f s, frame %u)\n", f.timeMs / 1000.0, f.sequence);
+    printf("Finger Angles (deg):\n");
+    for (int i = 0; i < 5; i++)
+    {
+        printf("  %s: %u\n", fingerNames[i], f.fingerAngles[i]);
+    }
+    printf("\nServo Targets (deg):\n");
+    for (int i = 0; i < 5; i++)
+    {
+        printf("  %s: %.1f\n", fingerNames[i], f.servoTargetAngles[i]);
+    }
+    printf("\nServo Writes (written/skipped):\n");
+    for (int i = 0; i < 5; i++)
+    {
+        printf("  %s: %u/%u\n", fingerNames[i], f.servoWrites[i], f.servoSkipped[i]);
+    }
+    if (f.flags & TELEMETRY_FLAG_FORCE_FEEDBACK)
+    {
+        printf("\nServo Force:\n");
+        for (int i = 0; i < 5; i++)
+        {
+            printf("  %s: %.2f\n", fingerNames[i], f.servoForces[i]);
+        }
+    }
+    printf("\nVibration RPM (envelope %%):\n");
+    for (int i = 0; i < 5; i++)
+    {
+        printf("  %s: %u (%u)\n", fingerNames[i], f.vibrationRPMs[i], f.vibrationPercent[i]);
+    }
+    printf("\nJoystick:\n  X: %.3f\n  Y: %.3f\n", f.joystickXY[0], f.joystickXY[1]);
+    printf("\nButtons:\n");
+    printf("  Bitmask      : 0x%02X\n", f.buttonsBitmask);
+    printf("  Joystick Btn : %s\n", (f.buttonsBitmask & 0b100) ? "released" : "PRESSED");
+    printf("  A Button     : %s\n", (f.buttonsBitmask & 0b010) ? "PRESSED" : "released");
+    printf("  B Button     : %s\n", (f.buttonsBitmask & 0b001) ? "PRESSED" : "released");
+    printf("\nBattery: %u%%\nFree heap: %u bytes\n", f.batteryPercent, f.freeHeap);
+}
+
+// Description: Prints a frame as one Arduino Serial Plotter line(label:value pairs)
+// Parameters: frame
+// Return: none
+static void printPlotter(const TelemetryFrame &f)
+{
+    printf("Thumb:%u Index:%u Middle:%u Ring:%u Pinkie:%u\n", f.fingerAngles[0], f.fingerAngles[1], f.fingerAngles[2],
+           f.fingerAngles[3], f.fingerAngles[4]);
+}
+
+// Description: Prints the CSV header, five columns per finger field
+// Parameters: none
+// Return: none
+static void printCsvHeader()
+{
+    const char *fields[] = {"finger", "velocity", "target", "force", "rpm", "vibration", "writes", "skipped"};
+    printf("time_ms,frame,revision");
+    for (const char *field : fields)
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            printf(",%s%d", field, i);
+        }
+    }
+    printf(",joystick_x,joystick_y,buttons,battery,free_heap\n");
+}
+
+// Description: Prints a frame as one CSV row
+// Parameters: frame
+// Return: none
+static void printCsv(const TelemetryFrame &f)
+{
+    printf("%u,%u,%u", f.timeMs, f.sequence, f.revision);
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%u", f.fingerAngles[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%.0f", f.fingerVelocities[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%.1f", f.servoTargetAngles[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%.3f", f.servoForces[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%u", f.vibrationRPMs[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%u", f.vibrationPercent[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%u", f.servoWrites[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        printf(",%u", f.servoSkipped[i]);
+    }
+    printf(",%.0f,%.0f,%u,%u,%u\n", f.joystickXY[0], f.joystickXY[1], f.buttonsBitmask, f.batteryPercent, f.freeHeap);
+}
+
+// Description: Whether bytes between frames are text printed by the firmware
+// Parameters: bytes and their count
+// Return: true if nearly all of them are printable
+static bool isText(const uint8_t *data, size_t length)
+{
+    size_t printable = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        printable += isprint(data[i]) || data[i] == '\n' || data[i] == '\r' || data[i] == '\t';
+    }
+    return printable * 10 >= length * 9;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <capture | -> [table | plotter | csv]\n", argv[0]);
+        return 1;
+    }
+    const char *viewName = argc > 2 ? argv[2] : "table";
+    View view = strcmp(viewName, "csv") == 0 ? VIEW_CSV : (strcmp(viewName, "plotter") == 0 ? VIEW_PLOTTER : VIEW_TABLE);
+
+    FILE *input = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (input == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+    if (view == VIEW_CSV)
+    {
+        printCsvHeader();
+    }
+
+    // A frame's COBS block is always payload + 1 bytes long(the payload is shorter than one 254 byte run), text
+    // printed right before a frame ends up in front of it in the same block
+    const size_t frameBlock = TELEMETRY_PAYLOAD_BYTES + 1;
+    std::vector<uint8_t> block;
+    uint8_t chunk[4096];
+    uint32_t frames = 0;
+    uint32_t lost = 0;
+    uint32_t corrupt = 0;
+    bool haveSequence = false;
+    uint16_t nextSequence = 0;
+    TelemetryFrame frame;
+
+    size_t count;
+    while ((count = fread(chunk, 1, sizeof(chunk), input)) > 0)
+    {
+        for (size_t n = 0; n < count; n++)
+        {
+            if (chunk[n] != 0)
+            {
+                block.push_back(chunk[n]);
+                continue;
+            }
+
+            // Text in front of the frame, or a block that isn't a frame at all
+            size_t textLength = block.size() > frameBlock ? block.size() - frameBlock : 0;
+            bool decoded = decodeTelemetryFrame(block.data() + textLength, block.size() - textLength, frame);
+            textLength = decoded ? textLength : block.size();
+            if (textLength > 0 && isText(block.data(), textLength))
+            {
+                fwrite(block.data(), 1, textLength, stderr);
+            }
+            else if (textLength > 0)
+            {
+                corrupt++;
+            }
+            block.clear();
+            if (!decoded)
+            {
+                continue;
+            }
+
+            frames++;
+            lost += haveSequence ? (uint16_t)(frame.sequence - nextSequence) : 0;
+            haveSequence = true;
+            nextSequence = frame.sequence + 1;
+            if (view == VIEW_TABLE)
+            {
+                printTable(frame);
+            }
+            else if (view == VIEW_PLOTTER)
+            {
+                printPlotter(frame);
+            }
+            else
+            {
+                printCsv(frame);
+            }
+        }
+        fflush(stdout);
+    }
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+
+    fprintf(stderr, "%u frames, %u lost, %u corrupt blocks\n", frames, lost, corrupt);
+    return frames > 0 ? 0 : 1;
+}
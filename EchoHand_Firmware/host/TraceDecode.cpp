@@ -0,0 +1,251 @@
+// Decodes the hot path trace dumps(HOT_PATH_TRACE in config.h, format in main/TraceFormat.h) from a log of the
+// glove's USB Serial into a Chrome trace JSON file for ui.perfetto.dev or chrome://tracing: one process per core,
+// one thread per task table row, begin/end slices and instant events with the record's argument.
+// Every dump in the log is decoded, the cores' cycle counts are put on the shared microsecond clock through the
+// sync pairs of their dump. Prints event counts and slice durations per event.
+//
+// Capture a dump(send "!" on the link, or set TRACE_DUMP_PERIOD_MS) and decode it, from EchoHand_Firmware/host:
+//   cmake -S . -B build && cmake --build build -j
+//   ./build/TraceDecode <log | -> [trace.json]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "TraceFormat.h"
+
+#define MAX_CORES 2
+
+struct CoreSync
+{
+    uint32_t us;
+    uint32_t cycles;
+};
+
+// Slice statistics of one event
+struct EventStats
+{
+    uint32_t count = 0;
+    uint32_t slices = 0;
+    double sumUs = 0;
+    double maxUs = 0;
+};
+
+// Description: Converts a record's cycle count to microseconds on the shared clock
+// Parameters: cycle count, sync pair of its core, cycle counter rate
+// Return: timestamp in microseconds, records are at most one counter wrap older than the sync
+static double recordUs(uint32_t cycles, const CoreSync &sync, double mhz)
+{
+    return sync.us - (double)(uint32_t)(sync.cycles - cycles) / mhz;
+}
+
+// Description: Escapes a task name for JSON
+// Parameters: name
+// Return: quoted string
+static std::string jsonString(const std::string &text)
+{
+    std::string out = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+        }
+        out += c >= ' ' ? c : ' ';
+    }
+    return out + "\"";
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <log | -> [trace.json]\n", argv[0]);
+        return 1;
+    }
+    const char *outputPath = argc > 2 ? argv[2] : "trace.json";
+
+    std::ifstream file;
+    if (strcmp(argv[1], "-") != 0)
+    {
+        file.open(argv[1]);
+        if (!file)
+        {
+            fprintf(stderr, "Can't open %s\n", argv[1]);
+            return 1;
+        }
+    }
+    std::istream &input = file.is_open() ? file : std::cin;
+
+    FILE *output = fopen(outputPath, "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", outputPath);
+        return 1;
+    }
+    fprintf(output, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    bool first = true;
+    auto emit = [&](const std::string &event) {
+        fprintf(output, "%s  %s", first ? "" : ",\n", event.c_str());
+        first = false;
+    };
+
+    // Open slices per core, task and event for the durations
+    std::map<uint32_t, std::vector<double>> open;
+    EventStats stats[TRACE_EVENT_COUNT];
+    std::map<uint32_t, std::string> threadNames;
+    uint32_t dumps = 0;
+    uint64_t records = 0;
+    uint64_t dropped = 0;
+
+    // State of the dump being read
+    bool inDump = false;
+    double mhz = 240;
+    CoreSync syncs[MAX_CORES] = {};
+    std::map<int, std::string> taskNames;
+
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line == TRACE_DUMP_BEGIN)
+        {
+            // Slices cut off by the previous dump never end
+            inDump = true;
+            taskNames.clear();
+            open.clear();
+            continue;
+        }
+        if (!inDump)
+        {
+            continue;
+        }
+        if (line == TRACE_DUMP_END)
+        {
+            inDump = false;
+            dumps++;
+            continue;
+        }
+
+        char kind = line.empty() ? 0 : line[0];
+        const char *rest = line.c_str() + (line.size() > 1 ? 2 : line.size());
+        char *end = NULL;
+        if (kind == 'C')
+        {
+            mhz = strtod(rest, NULL);
+        }
+        else if (kind == 'S')
+        {
+            int core = strtol(rest, &end, 10);
+            if (core >= 0 && core < MAX_CORES)
+            {
+                syncs[core].us = strtoul(end, &end, 10);
+                syncs[core].cycles = strtoul(end, NULL, 10);
+            }
+        }
+        else if (kind == 'N')
+        {
+            int row = strtol(rest, &end, 10);
+            taskNames[row] = *end == ' ' ? end + 1 : end;
+        }
+        else if (kind == 'D')
+        {
+            strtol(rest, &end, 10);
+            dropped += strtoul(end, NULL, 10);
+        }
+        else if (kind == 'R')
+        {
+            int core = strtol(rest, &end, 10);
+            if (core < 0 || core >= MAX_CORES || mhz <= 0)
+            {
+                continue;
+            }
+            for (const char *hex = end; *hex == ' ' && strlen(hex) > 16; hex += 17)
+            {
+                std::string digits(hex + 1, 16);
+                TraceRecord r;
+                r.cycles = strtoul(digits.substr(0, 8).c_str(), NULL, 16);
+                r.arg = strtoul(digits.substr(8, 4).c_str(), NULL, 16);
+                r.event = strtoul(digits.substr(12, 2).c_str(), NULL, 16);
+                r.taskPhase = strtoul(digits.substr(14, 2).c_str(), NULL, 16);
+                records++;
+
+                int task = r.taskPhase >> 2;
+                uint8_t phase = r.taskPhase & 3;
+                double us = recordUs(r.cycles, syncs[core], mhz);
+                uint32_t thread = core << 8 | task;
+                if (!threadNames.count(thread))
+                {
+                    std::string name = taskNames.count(task) ? taskNames[task] : "task " + std::to_string(task);
+                    threadNames[thread] = task == TRACE_TASK_OTHER ? "other" : name;
+                }
+
+                char event[256];
+                snprintf(event, sizeof(event),
+                         "{\"name\": \"%s\", \"cat\": \"hotpath\", \"ph\": \"%s\", \"ts\": %.3f, \"pid\": %d, \"tid\": %d, "
+                         "\"args\": {\"arg\": %u}}",
+                         traceEventName(r.event), phase == TRACE_PHASE_BEGIN ? "B" : (phase == TRACE_PHASE_END ? "E" : "i\", \"s\": \"t"), us,
+                         core, task, (unsigned)r.arg);
+                emit(event);
+
+                if (r.event >= TRACE_EVENT_COUNT)
+                {
+                    continue;
+                }
+                EventStats &s = stats[r.event];
+                std::vector<double> &begins = open[thread << 8 | r.event];
+                if (phase != TRACE_PHASE_END)
+                {
+                    s.count++;
+                }
+                if (phase == TRACE_PHASE_BEGIN)
+                {
+                    begins.push_back(us);
+                }
+                else if (phase == TRACE_PHASE_END && !begins.empty())
+                {
+                    double duration = us - begins.back();
+                    begins.pop_back();
+                    s.slices++;
+                    s.sumUs += duration;
+                    s.maxUs = duration > s.maxUs ? duration : s.maxUs;
+                }
+            }
+        }
+    }
+
+    // Names for the timeline's rows
+    for (int core = 0; core < MAX_CORES; core++)
+    {
+        emit("{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " + std::to_string(core) +
+             ", \"args\": {\"name\": \"core " + std::to_string(core) + "\"}}");
+    }
+    for (const auto &[thread, name] : threadNames)
+    {
+        emit("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " + std::to_string(thread >> 8) + ", \"tid\": " +
+             std::to_string(thread & 0xFF) + ", \"args\": {\"name\": " + jsonString(name) + "}}");
+    }
+    fprintf(output, "\n]}\n");
+    fclose(output);
+
+    printf("%u dumps, %llu records, %llu overwritten before their dump\n", dumps, (unsigned long long)records,
+           (unsigned long long)dropped);
+    printf("%-16s %8s %12s %12s\n", "event", "count", "mean us", "max us");
+    for (int e = 0; e < TRACE_EVENT_COUNT; e++)
+    {
+        const EventStats &s = stats[e];
+        if (s.count > 0)
+        {
+            printf("%-16s %8u %12.2f %12.2f\n", traceEventName(e), s.count, s.slices ? s.sumUs / s.slices : 0.0, s.maxUs);
+        }
+    }
+    printf("Trace in %s, open it in ui.perfetto.dev\n", outputPath);
+    return dumps > 0 ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#pragma once
+// Host stand-in for the subset of the Arduino core the firmware uses(see HostHal.h)
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "esp_attr.h"
+#include "HardwareSerial.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define HIGH 0x1
+#define LOW 0x0
+
+// ESP32-S3 DevKitC LED
+#define LED_BUILTIN 48
+
+// ADC attenuation, only 11dB(0-3.1V) is used
+#define ADC_11db 3
+
+typedef bool boolean;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void analogSetAttenuation(int attenuation);
+void analogReadResolution(uint8_t bits);
+
+// 32 bit like unsigned long on the ESP32 so wraparound behaves the same
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void initArduino();
+uint32_t getCpuFrequencyMhz();
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+using std::max;
+using std::min;
+
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGI(tag, ...)
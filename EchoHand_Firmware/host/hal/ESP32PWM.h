@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+
+// Host stand-in for ESP32Servo's PWM channel, the duty on each pin can be read with hostPwmDuty()
+class ESP32PWM
+{
+public:
+    void attachPin(uint8_t pin, double freq, uint8_t resolutionBits = 10);
+    void detachPin(int pin);
+    void write(uint32_t duty) { writeFast(duty); }
+    void writeFast(uint32_t duty);
+    uint32_t read() { return duty_; }
+    bool attached() { return pin_ >= 0; }
+
+private:
+    int pin_ = -1;
+    uint32_t duty_ = 0;
+    int channel_ = -1;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include "ESP32PWM.h"
+
+// Same limits as the ESP32Servo component
+#define DEFAULT_uS_LOW 544
+#define DEFAULT_uS_HIGH 2400
+#define MIN_PULSE_WIDTH 500
+#define MAX_PULSE_WIDTH 2500
+#define DEFAULT_TIMER_WIDTH 10
+#define REFRESH_USEC 20000
+
+// Host stand-in for ESP32Servo's Servo, the pulse on each pin can be read with hostServoPulseUs()
+class Servo
+{
+public:
+    int attach(int pin) { return attach(pin, DEFAULT_uS_LOW, DEFAULT_uS_HIGH); }
+    int attach(int pin, int min, int max);
+    void detach();
+    void write(int value);
+    void writeMicroseconds(int value);
+    void writeAngleFast(int angle);
+    void release();
+    int read();
+    int readMicroseconds() { return pulseUs_; }
+    bool attached() { return pin_ >= 0; }
+    void setTimerWidth(int value) { timerWidth_ = value; }
+    int readTimerWidth() { return timerWidth_; }
+
+private:
+    int pin_ = -1;
+    int min_ = DEFAULT_uS_LOW;
+    int max_ = DEFAULT_uS_HIGH;
+    int pulseUs_ = 0;
+    int timerWidth_ = DEFAULT_TIMER_WIDTH;
+    int channel_ = -1;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "WString.h"
+
+#define SERIAL_8N1 0x800001c
+
+// Host stand-in for the USB Serial, writes to stdout and reads what hostSerialFeed() queued
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+    void end();
+    int available();
+    int read();
+    int peek();
+    String readStringUntil(char terminator);
+    size_t write(uint8_t byte);
+    size_t write(const uint8_t *data, size_t length);
+    size_t write(const char *data, size_t length) { return write((const uint8_t *)data, length); }
+    size_t print(const char *text);
+    size_t print(const String &text) { return print(text.c_str()); }
+    size_t print(int value);
+    size_t println(const char *text = "");
+    size_t println(const String &text) { return println(text.c_str()); }
+    size_t println(int value);
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    void flush();
+    void setTimeout(unsigned long timeoutMs);
+    int availableForWrite();
+    void setRxBufferSize(size_t size);
+};
+
+extern HardwareSerial Serial;
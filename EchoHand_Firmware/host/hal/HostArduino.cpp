@@ -0,0 +1,306 @@
+// Host HAL: clock, GPIO, ADC and Serial behind the Arduino calls the firmware makes
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <stdarg.h>
+#include "Arduino.h"
+#include "HostHal.h"
+#include "HostScheduler.h"
+#include "esp_cpu.h"
+#include "esp_err.h"
+#include "esp_rom_sys.h"
+#include "esp_system.h"
+
+static std::atomic<uint32_t> analogMilliVolts[HOST_PIN_COUNT];
+static std::atomic<int> digitalLevels[HOST_PIN_COUNT];
+static HostAnalogReadHandler analogReadHandler = NULL;
+static void *analogReadContext = NULL;
+
+static std::mutex serialMutex;
+static FILE *serialOutput = stdout;
+static std::deque<char> serialInput;
+
+HardwareSerial Serial;
+
+void hostSetAnalogMilliVolts(uint8_t pin, uint32_t milliVolts)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        analogMilliVolts[pin] = milliVolts;
+    }
+}
+
+void hostSetAnalogReadHandler(HostAnalogReadHandler handler, void *context)
+{
+    analogReadContext = context;
+    analogReadHandler = handler;
+}
+
+void hostSetDigitalLevel(uint8_t pin, int level)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        digitalLevels[pin] = level;
+    }
+}
+
+int hostGetDigitalLevel(uint8_t pin)
+{
+    return pin < HOST_PIN_COUNT ? digitalLevels[pin].load() : LOW;
+}
+
+void hostSetSerialOutput(FILE *output)
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    serialOutput = output;
+}
+
+void hostSerialFeed(const char *data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    serialInput.insert(serialInput.end(), data, data + length);
+}
+
+//-------Arduino core-------//
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    // Pulled up inputs idle high until the host drives them
+    if (mode == INPUT_PULLUP)
+    {
+        hostSetDigitalLevel(pin, HIGH);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+    hostSetDigitalLevel(pin, level);
+}
+
+int digitalRead(uint8_t pin)
+{
+    return hostGetDigitalLevel(pin);
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+    hostSpendUs(HOST_ADC_READ_US);
+    if (analogReadHandler != NULL)
+    {
+        return analogReadHandler(pin, analogReadContext);
+    }
+    return pin < HOST_PIN_COUNT ? analogMilliVolts[pin].load() : 0;
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    // 12 bit reading over the 11dB range
+    uint32_t raw = analogReadMilliVolts(pin) * 4095 / 3100;
+    return raw > 4095 ? 4095 : raw;
+}
+
+void analogSetAttenuation(int attenuation)
+{
+    (void)attenuation;
+}
+
+void analogReadResolution(uint8_t bits)
+{
+    (void)bits;
+}
+
+uint32_t millis()
+{
+    uint32_t now = (uint32_t)(hostMicros() / 1000);
+    hostSpendUs(HOST_CLOCK_READ_US);
+    return now;
+}
+
+uint32_t micros()
+{
+    uint32_t now = (uint32_t)hostMicros();
+    hostSpendUs(HOST_CLOCK_READ_US);
+    return now;
+}
+
+void delay(uint32_t ms)
+{
+    hostSleepUntilUs(hostMicros() + ms * 1000ull);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    hostSleepUntilUs(hostMicros() + us);
+}
+
+void initArduino()
+{
+}
+
+uint32_t getCpuFrequencyMhz()
+{
+    return 240;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    // Same as arduino-esp32, an empty input range maps to -1
+    const long run = in_max - in_min;
+    if (run == 0)
+    {
+        return -1;
+    }
+    return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+//-------Serial-------//
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin)
+{
+    (void)baud;
+    (void)config;
+    (void)rxPin;
+    (void)txPin;
+}
+
+void HardwareSerial::end()
+{
+}
+
+int HardwareSerial::available()
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    return (int)serialInput.size();
+}
+
+int HardwareSerial::read()
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    if (serialInput.empty())
+    {
+        return -1;
+    }
+    int byte = (uint8_t)serialInput.front();
+    serialInput.pop_front();
+    return byte;
+}
+
+int HardwareSerial::peek()
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    return serialInput.empty() ? -1 : (uint8_t)serialInput.front();
+}
+
+String HardwareSerial::readStringUntil(char terminator)
+{
+    std::string line;
+    for (int byte = read(); byte >= 0 && byte != terminator; byte = read())
+    {
+        line += (char)byte;
+    }
+    return String(line);
+}
+
+size_t HardwareSerial::write(uint8_t byte)
+{
+    return write(&byte, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    if (serialOutput != NULL)
+    {
+        fwrite(data, 1, length, serialOutput);
+    }
+    return length;
+}
+
+size_t HardwareSerial::print(const char *text)
+{
+    return write((const uint8_t *)text, strlen(text));
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return printf("%d", value);
+}
+
+size_t HardwareSerial::println(const char *text)
+{
+    return print(text) + print("\n");
+}
+
+size_t HardwareSerial::println(int value)
+{
+    return printf("%d\n", value);
+}
+
+size_t HardwareSerial::printf(const char *format, ...)
+{
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < 0)
+    {
+        return 0;
+    }
+    return write((const uint8_t *)line, (size_t)length < sizeof(line) ? length : sizeof(line) - 1);
+}
+
+void HardwareSerial::flush()
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    if (serialOutput != NULL)
+    {
+        fflush(serialOutput);
+    }
+}
+
+void HardwareSerial::setTimeout(unsigned long timeoutMs)
+{
+    (void)timeoutMs;
+}
+
+int HardwareSerial::availableForWrite()
+{
+    return 128;
+}
+
+void HardwareSerial::setRxBufferSize(size_t size)
+{
+    (void)size;
+}
+
+//-------ESP-IDF system-------//
+
+int esp_rom_printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int length = vfprintf(stderr, format, args);
+    va_end(args);
+    return length;
+}
+
+uint32_t esp_get_free_heap_size()
+{
+    return 0;
+}
+
+uint32_t esp_get_minimum_free_heap_size()
+{
+    return 0;
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    return (uint32_t)(hostMicros() * 240);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    return code == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
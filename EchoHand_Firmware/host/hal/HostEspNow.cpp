@@ -0,0 +1,241 @@
+// Host HAL: WiFi and ESP-NOW
+// Sent packets queue up for a radio thread that keeps each one on air for its airtime, hands it to the host's
+// send handler and then runs the firmware's send callback, so send results arrive asynchronously and as late
+// as they do from the WiFi task.
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "WiFi.h"
+#include "esp_now.h"
+#include "HostHal.h"
+#include "HostScheduler.h"
+
+// Radio thread priority, the WiFi task's on IDF
+#define RADIO_THREAD_PRIORITY 23
+
+// 802.11 framing around an ESP-NOW payload: MAC header, vendor action header and FCS, then SIFS and the ACK
+#define RADIO_FRAME_OVERHEAD_BYTES 43
+#define RADIO_ACK_BYTES 14
+#define RADIO_SIFS_US 10
+
+// MAC the glove reports and receives from on the host
+static uint8_t hostMac[ESP_NOW_ETH_ALEN] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01};
+static uint8_t peerMac[ESP_NOW_ETH_ALEN] = {0x30, 0xED, 0xA0, 0xBC, 0x0B, 0x34};
+
+static std::mutex radioMutex;
+static std::deque<std::vector<uint8_t>> sendQueue;
+static HostThread *radioThread = NULL;
+
+// PHY of the peer, 1 Mbps 802.11b with the long preamble until the firmware sets a rate
+static uint32_t phyKbps = 1000;
+static uint32_t preambleUs = 192;
+static HostEspNowSendHandler sendHandler = NULL;
+static void *sendContext = NULL;
+static esp_now_send_cb_t sendCallback = NULL;
+static esp_now_recv_cb_t receiveCallback = NULL;
+
+WiFiClass WiFi;
+
+// Description: Time a frame and its ACK keep the air busy at the peer's PHY rate
+// Parameters: payload length in bytes
+// Return: airtime in microseconds
+static uint32_t frameAirtimeUs(size_t length)
+{
+    uint32_t frameBits = (length + RADIO_FRAME_OVERHEAD_BYTES) * 8;
+    return preambleUs + frameBits * 1000 / phyKbps + RADIO_SIFS_US + preambleUs + RADIO_ACK_BYTES * 8 * 1000 / phyKbps;
+}
+
+// Description: Radio thread, delivers queued packets one at a time and reports each result
+// Parameters: none
+// Return: none
+static void radioLoop()
+{
+    for (;;)
+    {
+        std::vector<uint8_t> packet;
+        uint32_t airtimeUs = 0;
+        {
+            std::lock_guard<std::mutex> lock(radioMutex);
+            if (!sendQueue.empty())
+            {
+                packet.swap(sendQueue.front());
+                sendQueue.pop_front();
+                airtimeUs = frameAirtimeUs(packet.size());
+            }
+        }
+        if (packet.empty())
+        {
+            hostThreadWait(HOST_WAIT_FOREVER);
+            continue;
+        }
+
+        hostSleepUntilUs(hostMicros() + airtimeUs);
+
+        HostEspNowSendHandler handler;
+        void *context;
+        esp_now_send_cb_t callback;
+        {
+            std::lock_guard<std::mutex> lock(radioMutex);
+            handler = sendHandler;
+            context = sendContext;
+            callback = sendCallback;
+        }
+        bool acknowledged = handler == NULL || handler(packet.data(), packet.size(), context);
+        if (callback != NULL)
+        {
+            callback(peerMac, acknowledged ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL);
+        }
+    }
+}
+
+void hostEspNowSetSendHandler(HostEspNowSendHandler handler, void *context)
+{
+    std::lock_guard<std::mutex> lock(radioMutex);
+    sendHandler = handler;
+    sendContext = context;
+}
+
+void hostEspNowReceive(const uint8_t *data, size_t length)
+{
+    esp_now_recv_cb_t callback;
+    {
+        std::lock_guard<std::mutex> lock(radioMutex);
+        callback = receiveCallback;
+    }
+    if (callback != NULL)
+    {
+        esp_now_recv_info_t info = {peerMac, hostMac, NULL};
+        callback(&info, data, (int)length);
+    }
+}
+
+//-------WiFi-------//
+
+bool WiFiClass::mode(int mode)
+{
+    (void)mode;
+    return true;
+}
+
+String WiFiClass::macAddress()
+{
+    char text[18];
+    snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X",
+             hostMac[0], hostMac[1], hostMac[2], hostMac[3], hostMac[4], hostMac[5]);
+    return String(text);
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second)
+{
+    (void)second;
+    return primary >= 1 && primary <= 13 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_wifi_set_protocol(wifi_interface_t interface, uint8_t protocolBitmap)
+{
+    (void)interface;
+    (void)protocolBitmap;
+    return ESP_OK;
+}
+
+//-------ESP-NOW-------//
+
+esp_err_t esp_now_init()
+{
+    std::lock_guard<std::mutex> lock(radioMutex);
+    if (radioThread == NULL)
+    {
+        radioThread = hostThreadSpawn("esp_now", RADIO_THREAD_PRIORITY, false, radioLoop);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *peer)
+{
+    return peer != NULL ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_now_mod_peer(const esp_now_peer_info_t *peer)
+{
+    return peer != NULL ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback)
+{
+    std::lock_guard<std::mutex> lock(radioMutex);
+    receiveCallback = callback;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback)
+{
+    std::lock_guard<std::mutex> lock(radioMutex);
+    sendCallback = callback;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_send(const uint8_t *peerAddress, const uint8_t *data, size_t length)
+{
+    (void)peerAddress;
+    if (length == 0 || length > ESP_NOW_MAX_DATA_LEN)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(radioMutex);
+        if (radioThread == NULL)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+        sendQueue.emplace_back(data, data + length);
+    }
+    hostThreadWake(radioThread);
+    return ESP_OK;
+}
+
+esp_err_t esp_now_set_peer_rate_config(const uint8_t *peerAddress, esp_now_rate_config_t *config)
+{
+    (void)peerAddress;
+    if (config == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 802.11b and long range use the long DSSS preamble, OFDM rates a 20us one
+    std::lock_guard<std::mutex> lock(radioMutex);
+    switch (config->rate)
+    {
+    case WIFI_PHY_RATE_2M:
+        phyKbps = 2000;
+        break;
+    case WIFI_PHY_RATE_11M_L:
+        phyKbps = 11000;
+        break;
+    case WIFI_PHY_RATE_6M:
+        phyKbps = 6000;
+        break;
+    case WIFI_PHY_RATE_12M:
+        phyKbps = 12000;
+        break;
+    case WIFI_PHY_RATE_24M:
+        phyKbps = 24000;
+        break;
+    case WIFI_PHY_RATE_54M:
+        phyKbps = 54000;
+        break;
+    case WIFI_PHY_RATE_MCS7_SGI:
+        phyKbps = 72200;
+        break;
+    case WIFI_PHY_RATE_LORA_250K:
+        phyKbps = 250;
+        break;
+    case WIFI_PHY_RATE_LORA_500K:
+        phyKbps = 500;
+        break;
+    default:
+        phyKbps = 1000;
+        break;
+    }
+    preambleUs = phyKbps >= 6000 && config->rate != WIFI_PHY_RATE_11M_L ? 20 : 192;
+    return ESP_OK;
+}
@@ -0,0 +1,258 @@
+// Host HAL: FreeRTOS tasks on HAL threads(see HostScheduler.h)
+// Every task is a thread, notifications are a counter the task waits on and the tick is the HAL clock in
+// milliseconds. Cores are only recorded, in real time the host OS does the scheduling and in virtual time the
+// lockstep scheduler picks by wake up time and priority.
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <time.h>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "HostHal.h"
+#include "HostScheduler.h"
+
+struct HostTask
+{
+    std::string name;
+    UBaseType_t priority;
+    BaseType_t core;
+    UBaseType_t number;
+    clockid_t cpuClock;
+    bool hasCpuClock;
+    HostThread *thread;
+    std::mutex mutex;
+    uint32_t notifications;
+};
+
+// Every task ever created(tasks are never freed, vTaskDelete only parks the thread)
+static std::mutex registryMutex;
+static std::vector<HostTask *> registry;
+
+// Task the calling thread runs, threads not started by xTaskCreate get one on first use
+static thread_local HostTask *currentTask = NULL;
+
+// Description: Adds a task to the registry
+// Parameters: name, priority and core
+// Return: the new task
+static HostTask *registerTask(const char *name, UBaseType_t priority, BaseType_t core)
+{
+    HostTask *task = new HostTask();
+    task->name = name;
+    task->priority = priority;
+    task->core = core;
+    task->hasCpuClock = false;
+    task->thread = NULL;
+    task->notifications = 0;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    task->number = registry.size();
+    registry.push_back(task);
+    return task;
+}
+
+// Description: Makes the calling thread a task and records its CPU clock for the run time stats
+// Parameters: task the thread runs
+// Return: none
+static void enterTask(HostTask *task)
+{
+    currentTask = task;
+    task->hasCpuClock = pthread_getcpuclockid(pthread_self(), &task->cpuClock) == 0;
+}
+
+// Description: Task of the calling thread
+// Parameters: none
+// Return: its task, adopted as "host" if the thread wasn't started by xTaskCreate
+static HostTask *selfTask()
+{
+    if (currentTask == NULL)
+    {
+        HostTask *task = registerTask("host", 0, tskNO_AFFINITY);
+        task->thread = hostThreadSelf();
+        enterTask(task);
+    }
+    return currentTask;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackBytes, void *parameters,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    (void)stackBytes;
+    HostTask *task = registerTask(name, priority, core);
+
+    // The handle is out before the task runs, like on FreeRTOS
+    if (handle != NULL)
+    {
+        *handle = task;
+    }
+    task->thread = hostThreadSpawn(name, priority, true, [task, function, parameters]()
+                                   {
+                                       enterTask(task);
+                                       function(parameters);
+                                   });
+    return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t function, const char *name, uint32_t stackBytes, void *parameters,
+                                           UBaseType_t priority, StackType_t *stack, StaticTask_t *buffer, BaseType_t core)
+{
+    (void)stack;
+    (void)buffer;
+    TaskHandle_t handle = NULL;
+    xTaskCreatePinnedToCore(function, name, stackBytes, parameters, priority, &handle, core);
+    return handle;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Threads can't be killed from outside, a task deleting itself parks forever
+    if (task == NULL || task == selfTask())
+    {
+        for (;;)
+        {
+            hostSleepUntilUs(HOST_WAIT_FOREVER);
+        }
+    }
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)(hostMicros() / 1000);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    hostSleepUntilUs(hostMicros() + ticks * 1000ull);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previousWake, TickType_t increment)
+{
+    // Wake time on the 64 bit clock from the 32 bit tick, same wraparound as FreeRTOS
+    TickType_t wake = *previousWake + increment;
+    TickType_t now = xTaskGetTickCount();
+    *previousWake = wake;
+    if ((int32_t)(wake - now) <= 0)
+    {
+        return pdFALSE;
+    }
+    hostSleepUntilUs(hostMicros() + (uint64_t)(wake - now) * 1000);
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait)
+{
+    HostTask *task = selfTask();
+    uint64_t deadlineUs = ticksToWait == portMAX_DELAY ? HOST_WAIT_FOREVER : hostMicros() + ticksToWait * 1000ull;
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(task->mutex);
+            uint32_t value = task->notifications;
+            if (value > 0)
+            {
+                task->notifications = clearOnExit ? 0 : value - 1;
+                return value;
+            }
+        }
+        if (hostMicros() >= deadlineUs)
+        {
+            return 0;
+        }
+        hostThreadWait(deadlineUs);
+    }
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+
+    // A task that hasn't got its thread yet sees the count when it first waits
+    if (task->thread != NULL)
+    {
+        hostThreadWake(task->thread);
+    }
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken)
+{
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken != NULL)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return selfTask();
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+    return (task != NULL ? task : selfTask())->name.c_str();
+}
+
+BaseType_t xTaskGetCoreID(TaskHandle_t task)
+{
+    return (task != NULL ? task : selfTask())->core;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core)
+{
+    // No idle tasks, the profiler reports full load
+    (void)core;
+    return NULL;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return registry.size();
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *statuses, UBaseType_t size, uint32_t *totalRunTime)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (registry.size() > size)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < registry.size(); i++)
+    {
+        HostTask *task = registry[i];
+        timespec cpu = {0, 0};
+        if (task->hasCpuClock)
+        {
+            clock_gettime(task->cpuClock, &cpu);
+        }
+        statuses[i] = {task, task->name.c_str(), task->number, eReady, task->priority, task->priority,
+                       (uint32_t)(cpu.tv_sec * 1000000ull + cpu.tv_nsec / 1000), NULL, 0, task->core};
+    }
+    if (totalRunTime != NULL)
+    {
+        *totalRunTime = (uint32_t)hostMicros();
+    }
+    return registry.size();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    (void)task;
+    return 0;
+}
+
+BaseType_t xPortGetCoreID()
+{
+    BaseType_t core = selfTask()->core;
+    return core == tskNO_AFFINITY ? 0 : core;
+}
+
+BaseType_t xPortInIsrContext()
+{
+    return pdFALSE;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Host side of the HAL shims: the hardware the firmware sees when it is built for the host.
+// Host programs drive the inputs(ADC, buttons, serial, received ESP-NOW packets) and read back the outputs
+// (GPIO, servo pulses, PWM duty, sent ESP-NOW packets) through these calls.
+
+// Description: Switches the HAL to deterministic virtual time(see HostScheduler.h), tasks and the radio run in
+// lockstep and the clock jumps from one wake up to the next, so runs are repeatable and faster than real time.
+// Call first thing in main(), the calling thread becomes the host program's thread
+// Parameters: none
+// Return: none
+void hostUseVirtualTime();
+bool hostVirtualTime();
+
+// CPU time charged in virtual time to firmware tasks for each HAL call, about what they take on the ESP32-S3.
+// Busy loops(calibration, the comms loop) advance the clock through these
+#define HOST_ADC_READ_US 20
+#define HOST_CLOCK_READ_US 2
+
+// Time since the host HAL started in microseconds, the clock behind millis(), micros() and the FreeRTOS tick
+uint64_t hostMicros();
+
+// Description: Sleeps the calling thread until the HAL clock reaches a time
+// Parameters: wake up time in microseconds on the HAL clock
+// Return: none
+void hostSleepUntilUs(uint64_t wakeUs);
+
+// Pins the HAL tracks, covers every ESP32-S3 GPIO
+#define HOST_PIN_COUNT 64
+
+// ADC and GPIO
+void hostSetAnalogMilliVolts(uint8_t pin, uint32_t milliVolts);
+
+// Called on every ADC read instead of using the set voltage, on the reading task, returns the reading in mV
+typedef uint32_t (*HostAnalogReadHandler)(uint8_t pin, void *context);
+void hostSetAnalogReadHandler(HostAnalogReadHandler handler, void *context);
+void hostSetDigitalLevel(uint8_t pin, int level);
+int hostGetDigitalLevel(uint8_t pin);
+
+// Servo pulse width on a pin in microseconds, 0 while the servo is released or detached
+int hostServoPulseUs(uint8_t pin);
+
+// Called on every pulse the firmware writes to a servo(0 when it is released), on the writing task
+typedef void (*HostServoWriteHandler)(uint8_t pin, int pulseUs, void *context);
+void hostSetServoWriteHandler(HostServoWriteHandler handler, void *context);
+
+// PWM duty on a pin, 0 if no channel is attached to it
+uint32_t hostPwmDuty(uint8_t pin);
+
+// Serial, output goes to stdout unless redirected(NULL discards it)
+void hostSetSerialOutput(FILE *output);
+void hostSerialFeed(const char *data, size_t length);
+
+// ESP-NOW, packets the firmware sends go to the handler which returns whether the peer acknowledged them
+// (no handler acknowledges everything), received packets are handed to the firmware's receive callback.
+// The handler runs on the radio thread once the frame and its ACK have been on air for their airtime
+typedef bool (*HostEspNowSendHandler)(const uint8_t *data, size_t length, void *context);
+void hostEspNowSetSendHandler(HostEspNowSendHandler handler, void *context);
+void hostEspNowReceive(const uint8_t *data, size_t length);
@@ -0,0 +1,301 @@
+// Host HAL: clock and threads, real time or lockstep virtual time(see HostScheduler.h)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "HostHal.h"
+#include "HostScheduler.h"
+
+struct HostThread
+{
+    std::string name;
+    int priority;
+    bool firmware;
+    std::condition_variable resume;
+
+    // Wake that hasn't been consumed by a wait yet
+    bool woken;
+
+    // Virtual time: blocked until wakeUs(or a wake if wakeable), order it blocked in for ties
+    bool blocked;
+    bool wakeable;
+    uint64_t wakeUs;
+    uint64_t blockOrder;
+};
+
+static const std::chrono::steady_clock::time_point hostEpoch = std::chrono::steady_clock::now();
+
+// Guards every thread's state and the virtual clock
+static std::mutex schedulerMutex;
+static std::vector<HostThread *> threads;
+static bool virtualTime = false;
+static std::atomic<uint64_t> virtualUs{0};
+static HostThread *running = NULL;
+static uint64_t blockCount = 0;
+
+static thread_local HostThread *selfThread = NULL;
+static thread_local int criticalNesting = 0;
+static thread_local uint32_t deferredUs = 0;
+
+// Description: Creates a thread record
+// Parameters: name, priority, whether it is a firmware task
+// Return: the record, not yet registered
+static HostThread *newThread(const char *name, int priority, bool firmware)
+{
+    HostThread *thread = new HostThread();
+    thread->name = name;
+    thread->priority = priority;
+    thread->firmware = firmware;
+    thread->woken = false;
+    thread->blocked = false;
+    thread->wakeable = false;
+    thread->wakeUs = 0;
+    thread->blockOrder = 0;
+    return thread;
+}
+
+// Description: Picks the blocked thread that runs next in virtual time(schedulerMutex held)
+// Parameters: time it runs at out
+// Return: the thread, NULL if every thread waits forever
+static HostThread *nextThread(uint64_t &atUs)
+{
+    HostThread *next = NULL;
+    uint64_t now = virtualUs.load();
+    for (HostThread *thread : threads)
+    {
+        if (!thread->blocked)
+        {
+            continue;
+        }
+        uint64_t at = thread->wakeable && thread->woken ? now : thread->wakeUs;
+        if (at == HOST_WAIT_FOREVER)
+        {
+            continue;
+        }
+        if (next == NULL || at < atUs ||
+            (at == atUs && (thread->priority > next->priority ||
+                            (thread->priority == next->priority && thread->blockOrder < next->blockOrder))))
+        {
+            next = thread;
+            atUs = at;
+        }
+    }
+    return next;
+}
+
+// Description: Blocks the calling thread in virtual time and runs the others until it is picked again
+// Parameters: lock on schedulerMutex, calling thread, deadline, whether a wake ends the block
+// Return: none
+static void blockVirtual(std::unique_lock<std::mutex> &lock, HostThread *self, uint64_t deadlineUs, bool wakeable)
+{
+    self->blocked = true;
+    self->wakeable = wakeable;
+    self->wakeUs = deadlineUs;
+    self->blockOrder = blockCount++;
+
+    uint64_t atUs = 0;
+    HostThread *next = nextThread(atUs);
+    if (next == NULL)
+    {
+        fprintf(stderr, "Host scheduler: every thread waits forever at %llu us\n", (unsigned long long)virtualUs.load());
+        abort();
+    }
+    if (atUs > virtualUs.load())
+    {
+        virtualUs = atUs;
+    }
+    next->blocked = false;
+    running = next;
+
+    // Nothing else due first, keep going without a switch
+    if (next != self)
+    {
+        next->resume.notify_one();
+        self->resume.wait(lock, [self]()
+                          { return running == self; });
+    }
+    if (wakeable)
+    {
+        self->woken = false;
+    }
+}
+
+// Description: Switches the HAL to virtual time, the calling thread becomes the host program's thread.
+// Call before anything starts a thread(tasks, esp_now_init)
+// Parameters: none
+// Return: none
+void hostUseVirtualTime()
+{
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    if (virtualTime)
+    {
+        return;
+    }
+    virtualTime = true;
+    selfThread = newThread("host", HOST_THREAD_PRIORITY, false);
+    threads.push_back(selfThread);
+    running = selfThread;
+}
+
+bool hostVirtualTime()
+{
+    return virtualTime;
+}
+
+uint64_t hostMicros()
+{
+    // A firmware task sees its own time, ahead of the clock by what it has been charged since it last synced
+    if (virtualTime)
+    {
+        return virtualUs.load() + deferredUs;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostEpoch).count();
+}
+
+void hostSleepUntilUs(uint64_t wakeUs)
+{
+    if (!virtualTime)
+    {
+        while (wakeUs == HOST_WAIT_FOREVER)
+        {
+            std::this_thread::sleep_for(std::chrono::hours(1));
+        }
+        std::this_thread::sleep_until(hostEpoch + std::chrono::microseconds(wakeUs));
+        return;
+    }
+    // Sleeping from the task's own time, the charged time is spent by the sleep
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    uint64_t nowUs = virtualUs.load() + deferredUs;
+    deferredUs = 0;
+    blockVirtual(lock, hostThreadSelf(), wakeUs > nowUs ? wakeUs : nowUs, false);
+}
+
+HostThread *hostThreadSpawn(const char *name, int priority, bool firmware, std::function<void()> body)
+{
+    HostThread *thread = newThread(name, priority, firmware);
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        threads.push_back(thread);
+
+        // Ready to run at the current time, behind everything already waiting for it
+        thread->blocked = virtualTime;
+        thread->wakeUs = virtualUs.load();
+        thread->blockOrder = blockCount++;
+    }
+
+    std::thread([thread, body]()
+                {
+                    selfThread = thread;
+                    if (virtualTime)
+                    {
+                        std::unique_lock<std::mutex> lock(schedulerMutex);
+                        thread->resume.wait(lock, [thread]()
+                                            { return running == thread; });
+                    }
+                    body();
+
+                    // Finished threads never run again
+                    for (;;)
+                    {
+                        hostSleepUntilUs(HOST_WAIT_FOREVER);
+                    }
+                })
+        .detach();
+    return thread;
+}
+
+HostThread *hostThreadSelf()
+{
+    if (selfThread == NULL)
+    {
+        // A thread the scheduler doesn't know can't take part in the lockstep
+        if (virtualTime)
+        {
+            fprintf(stderr, "Host scheduler: thread not started by the HAL in virtual time\n");
+            abort();
+        }
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        selfThread = newThread("host", HOST_THREAD_PRIORITY, false);
+        threads.push_back(selfThread);
+    }
+    return selfThread;
+}
+
+void hostThreadWait(uint64_t deadlineUs)
+{
+    HostThread *self = hostThreadSelf();
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    if (virtualTime)
+    {
+        if (self->woken)
+        {
+            self->woken = false;
+            return;
+        }
+
+        // Same for a wait
+        uint64_t nowUs = virtualUs.load() + deferredUs;
+        deferredUs = 0;
+        blockVirtual(lock, self, deadlineUs > nowUs ? deadlineUs : nowUs, true);
+        return;
+    }
+
+    if (deadlineUs == HOST_WAIT_FOREVER)
+    {
+        self->resume.wait(lock, [self]()
+                          { return self->woken; });
+    }
+    else
+    {
+        self->resume.wait_until(lock, hostEpoch + std::chrono::microseconds(deadlineUs), [self]()
+                                { return self->woken; });
+    }
+    self->woken = false;
+}
+
+void hostThreadWake(HostThread *thread)
+{
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        thread->woken = true;
+    }
+
+    // In virtual time the woken thread runs once the caller blocks or is charged time
+    if (!virtualTime)
+    {
+        thread->resume.notify_one();
+    }
+}
+
+void hostSpendUs(uint32_t us)
+{
+    if (!virtualTime || selfThread == NULL || !selfThread->firmware)
+    {
+        return;
+    }
+    deferredUs += us;
+    if (criticalNesting > 0 || deferredUs < HOST_TIME_QUANTUM_US)
+    {
+        return;
+    }
+
+    uint64_t wakeUs = virtualUs.load() + deferredUs;
+    deferredUs = 0;
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    blockVirtual(lock, selfThread, wakeUs, false);
+}
+
+void hostEnterCritical()
+{
+    criticalNesting++;
+}
+
+void hostExitCritical()
+{
+    criticalNesting--;
+}
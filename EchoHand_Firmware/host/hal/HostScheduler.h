@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <functional>
+
+// Threads of the host HAL(FreeRTOS tasks, the radio, the host program) and the clock they run on.
+// In real time every thread is a free running std::thread on the steady clock.
+// In virtual time(hostUseVirtualTime()) they run in lockstep: one thread at a time, a blocked thread hands
+// over to the one that wakes next and the clock jumps straight to its wake up time. Ties go to the higher
+// priority, then to the thread that blocked first, so a run only depends on its inputs.
+// Each thread acts as if it had a CPU of its own, tasks sharing a core don't delay each other.
+// Firmware tasks run ahead of the clock by up to HOST_TIME_QUANTUM_US of charged CPU time before they sync with
+// the others(temporal decoupling), so busy loops don't switch threads on every HAL call.
+
+// Waits with no deadline
+#define HOST_WAIT_FOREVER UINT64_MAX
+
+// Most CPU time a firmware task is charged before it syncs with the other threads,
+// bounds how far events between tasks can be out of step
+#define HOST_TIME_QUANTUM_US 100
+
+// Priority of the host program's own thread, above every task so inputs change before tasks sample them
+#define HOST_THREAD_PRIORITY 100
+
+struct HostThread;
+
+// Description: Starts a HAL thread, in virtual time it first runs once the thread that started it blocks
+// Parameters: name, priority, whether HAL calls made on it cost virtual CPU time(firmware tasks), body
+// Return: the thread
+HostThread *hostThreadSpawn(const char *name, int priority, bool firmware, std::function<void()> body);
+
+// Description: Thread of the caller
+// Parameters: none
+// Return: its thread, adopted if it wasn't started by hostThreadSpawn(real time only)
+HostThread *hostThreadSelf();
+
+// Description: Blocks the calling thread until it is woken or the clock reaches a deadline.
+// A wake that arrived while the thread wasn't waiting ends the next wait straight away
+// Parameters: deadline in microseconds on the HAL clock, HOST_WAIT_FOREVER for none
+// Return: none
+void hostThreadWait(uint64_t deadlineUs);
+
+// Description: Wakes a thread from hostThreadWait(), or lets its next wait through
+// Parameters: thread
+// Return: none
+void hostThreadWake(HostThread *thread);
+
+// Description: Charges CPU time to the calling firmware task in virtual time. Once a quantum has built up the
+// clock moves on and other threads due meanwhile run first, inside a critical section it waits for the next
+// charge after it. Does nothing in real time or on host threads
+// Parameters: microseconds the call took
+// Return: none
+void hostSpendUs(uint32_t us);
+
+// Critical section nesting of the calling thread, charges inside one are deferred
+void hostEnterCritical();
+void hostExitCritical();
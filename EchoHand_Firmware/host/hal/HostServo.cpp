@@ -0,0 +1,193 @@
+// Host HAL: servo pulses and PWM duty per pin
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+#include "ESP32Servo.h"
+#include "HostHal.h"
+
+static std::atomic<int> servoPulses[HOST_PIN_COUNT];
+static std::atomic<uint32_t> pwmDuties[HOST_PIN_COUNT];
+static HostServoWriteHandler servoWriteHandler = NULL;
+static void *servoWriteContext = NULL;
+
+// LEDC channels as ESP32PWM hands them out on the S3: channel j is on timer j / 2 and a timer runs at the frequency
+// of its first channel until its last one is freed
+#define HOST_LEDC_CHANNELS 8
+#define HOST_LEDC_TIMERS 4
+static std::mutex ledcMutex;
+static bool ledcChannelUsed[HOST_LEDC_CHANNELS];
+static long ledcTimerFreq[HOST_LEDC_TIMERS] = {-1, -1, -1, -1};
+static int ledcTimerCount[HOST_LEDC_TIMERS];
+
+// Description: Takes a free LEDC channel on a timer at the frequency like ESP32PWM::allocatenext()
+// The firmware halts when none is left, the host aborts so the run fails instead of hanging
+// Parameters: frequency in Hz
+// Return: channel
+static int allocateLedcChannel(double freq)
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    for (int timer = 0; timer < HOST_LEDC_TIMERS; timer++)
+    {
+        if (ledcTimerFreq[timer] != (long)freq && ledcTimerFreq[timer] != -1)
+        {
+            continue;
+        }
+        for (int channel = timer * 2; channel < timer * 2 + 2; channel++)
+        {
+            if (!ledcChannelUsed[channel])
+            {
+                ledcChannelUsed[channel] = true;
+                ledcTimerFreq[timer] = (long)freq;
+                ledcTimerCount[timer]++;
+                return channel;
+            }
+        }
+    }
+    fprintf(stderr, "ERROR All PWM timers allocated! Can't accomodate %.3f Hz\n", freq);
+    abort();
+}
+
+// Description: Frees a channel from allocateLedcChannel() and its timer's frequency with its last channel
+// Parameters: channel(-1 for none)
+// Return: none
+static void freeLedcChannel(int channel)
+{
+    if (channel < 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    int timer = channel / 2;
+    ledcChannelUsed[channel] = false;
+    if (--ledcTimerCount[timer] == 0)
+    {
+        ledcTimerFreq[timer] = -1;
+    }
+}
+
+// Description: Stores a pin's pulse and reports the write to the host
+// Parameters: pin, pulse width in microseconds(0 released)
+// Return: none
+static void setServoPulse(int pin, int pulseUs)
+{
+    servoPulses[pin] = pulseUs;
+    if (servoWriteHandler != NULL)
+    {
+        servoWriteHandler((uint8_t)pin, pulseUs, servoWriteContext);
+    }
+}
+
+int hostServoPulseUs(uint8_t pin)
+{
+    return pin < HOST_PIN_COUNT ? servoPulses[pin].load() : 0;
+}
+
+uint32_t hostPwmDuty(uint8_t pin)
+{
+    return pin < HOST_PIN_COUNT ? pwmDuties[pin].load() : 0;
+}
+
+void hostSetServoWriteHandler(HostServoWriteHandler handler, void *context)
+{
+    servoWriteContext = context;
+    servoWriteHandler = handler;
+}
+
+//-------Servo-------//
+
+int Servo::attach(int pin, int min, int max)
+{
+    if (pin < 0 || pin >= HOST_PIN_COUNT)
+    {
+        return 0;
+    }
+    if (channel_ < 0)
+    {
+        channel_ = allocateLedcChannel(1000000.0 / REFRESH_USEC);
+    }
+    pin_ = pin;
+    min_ = min < MIN_PULSE_WIDTH ? MIN_PULSE_WIDTH : min;
+    max_ = max > MAX_PULSE_WIDTH ? MAX_PULSE_WIDTH : max;
+    return 1;
+}
+
+void Servo::detach()
+{
+    release();
+    pin_ = -1;
+    freeLedcChannel(channel_);
+    channel_ = -1;
+}
+
+void Servo::write(int value)
+{
+    // Values below the shortest pulse are angles like in ESP32Servo
+    if (value < MIN_PULSE_WIDTH)
+    {
+        writeAngleFast(value);
+        return;
+    }
+    writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int value)
+{
+    if (pin_ < 0)
+    {
+        return;
+    }
+    pulseUs_ = value < min_ ? min_ : (value > max_ ? max_ : value);
+    setServoPulse(pin_, pulseUs_);
+}
+
+void Servo::writeAngleFast(int angle)
+{
+    angle = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+    writeMicroseconds(min_ + ((max_ - min_) * angle) / 180);
+}
+
+void Servo::release()
+{
+    pulseUs_ = 0;
+    if (pin_ >= 0)
+    {
+        setServoPulse(pin_, 0);
+    }
+}
+
+int Servo::read()
+{
+    return pulseUs_ ? ((pulseUs_ - min_) * 180) / (max_ - min_) : 0;
+}
+
+//-------PWM-------//
+
+void ESP32PWM::attachPin(uint8_t pin, double freq, uint8_t resolutionBits)
+{
+    (void)resolutionBits;
+    pin_ = pin < HOST_PIN_COUNT ? pin : -1;
+    if (pin_ >= 0 && channel_ < 0)
+    {
+        channel_ = allocateLedcChannel(freq);
+    }
+}
+
+void ESP32PWM::detachPin(int pin)
+{
+    if (pin == pin_)
+    {
+        writeFast(0);
+        pin_ = -1;
+        freeLedcChannel(channel_);
+        channel_ = -1;
+    }
+}
+
+void ESP32PWM::writeFast(uint32_t duty)
+{
+    duty_ = duty;
+    if (pin_ >= 0)
+    {
+        pwmDuties[pin_] = duty;
+    }
+}
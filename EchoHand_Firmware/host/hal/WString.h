@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+// Host stand-in for Arduino's String
+class String
+{
+public:
+    String(const char *text = "") : text_(text) {}
+    String(const std::string &text) : text_(text) {}
+    const char *c_str() const { return text_.c_str(); }
+    size_t length() const { return text_.size(); }
+
+private:
+    std::string text_;
+};
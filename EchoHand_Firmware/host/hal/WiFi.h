@@ -0,0 +1,15 @@
+#pragma once
+#include "WString.h"
+#include "esp_wifi.h"
+
+#define WIFI_STA 1
+
+// Host stand-in for the WiFi class, only what bringing up ESP-NOW needs
+class WiFiClass
+{
+public:
+    bool mode(int mode);
+    String macAddress();
+};
+
+extern WiFiClass WiFi;
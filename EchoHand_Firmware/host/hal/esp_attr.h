@@ -0,0 +1,4 @@
+#pragma once
+// Placement attributes are meaningless on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
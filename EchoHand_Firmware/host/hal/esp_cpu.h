@@ -0,0 +1,4 @@
+#pragma once
+#include <stdint.h>
+// Cycles of a 240MHz core derived from the HAL clock
+uint32_t esp_cpu_get_cycle_count(void);
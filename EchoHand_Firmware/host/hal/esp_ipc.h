@@ -0,0 +1,11 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+// Runs the function straight away on the caller, the host's cores share one cycle counter
+typedef void (*esp_ipc_func_t)(void *arg);
+inline esp_err_t esp_ipc_call_blocking(uint32_t cpu_id, esp_ipc_func_t func, void *arg)
+{
+    (void)cpu_id;
+    func(arg);
+    return ESP_OK;
+}
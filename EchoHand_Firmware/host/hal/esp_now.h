@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_wifi.h"
+
+// Host stand-in for ESP-NOW, sent packets go to the handler set with hostEspNowSetSendHandler() and
+// their send callbacks run on a radio thread like they do on the WiFi task(see HostHal.h)
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_MAX_DATA_LEN 250
+
+typedef struct
+{
+    uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+    uint8_t lmk[16];
+    uint8_t channel;
+    wifi_interface_t ifidx;
+    bool encrypt;
+    void *priv;
+} esp_now_peer_info_t;
+
+typedef struct
+{
+    uint8_t *src_addr;
+    uint8_t *des_addr;
+    void *rx_ctrl;
+} esp_now_recv_info_t;
+
+typedef enum
+{
+    ESP_NOW_SEND_SUCCESS = 0,
+    ESP_NOW_SEND_FAIL
+} esp_now_send_status_t;
+
+typedef struct
+{
+    wifi_phy_mode_t phymode;
+    wifi_phy_rate_t rate;
+    bool ersu;
+    bool dcm;
+} esp_now_rate_config_t;
+
+typedef void (*esp_now_recv_cb_t)(const esp_now_recv_info_t *info, const uint8_t *data, int length);
+typedef void (*esp_now_send_cb_t)(const uint8_t *macAddress, esp_now_send_status_t status);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *peer);
+esp_err_t esp_now_mod_peer(const esp_now_peer_info_t *peer);
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback);
+esp_err_t esp_now_send(const uint8_t *peerAddress, const uint8_t *data, size_t length);
+esp_err_t esp_now_set_peer_rate_config(const uint8_t *peerAddress, esp_now_rate_config_t *config);
@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+// The host has no fixed heap, both report 0
+uint32_t esp_get_free_heap_size();
+uint32_t esp_get_minimum_free_heap_size();
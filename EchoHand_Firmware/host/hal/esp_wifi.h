@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+// Host stand-in for the WiFi driver calls the ESP-NOW radio setup makes, all succeed and change nothing
+
+typedef enum
+{
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP
+} wifi_interface_t;
+
+typedef enum
+{
+    WIFI_SECOND_CHAN_NONE = 0
+} wifi_second_chan_t;
+
+typedef enum
+{
+    WIFI_PHY_RATE_1M_L = 0x00,
+    WIFI_PHY_RATE_2M = 0x01,
+    WIFI_PHY_RATE_11M_L = 0x03,
+    WIFI_PHY_RATE_24M = 0x09,
+    WIFI_PHY_RATE_12M = 0x0A,
+    WIFI_PHY_RATE_6M = 0x0B,
+    WIFI_PHY_RATE_54M = 0x0C,
+    WIFI_PHY_RATE_MCS7_SGI = 0x1F,
+    WIFI_PHY_RATE_LORA_250K = 0x29,
+    WIFI_PHY_RATE_LORA_500K = 0x2A
+} wifi_phy_rate_t;
+
+typedef enum
+{
+    WIFI_PHY_MODE_LR,
+    WIFI_PHY_MODE_11B,
+    WIFI_PHY_MODE_11G,
+    WIFI_PHY_MODE_HT20,
+    WIFI_PHY_MODE_HT40,
+    WIFI_PHY_MODE_HE20
+} wifi_phy_mode_t;
+
+#define WIFI_PROTOCOL_11B 1
+#define WIFI_PROTOCOL_11G 2
+#define WIFI_PROTOCOL_11N 4
+#define WIFI_PROTOCOL_LR 8
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second);
+esp_err_t esp_wifi_set_protocol(wifi_interface_t interface, uint8_t protocolBitmap);
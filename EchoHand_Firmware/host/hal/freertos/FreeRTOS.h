@@ -0,0 +1,51 @@
+#pragma once
+// Host stand-in for FreeRTOS on std::thread(see HostFreeRTOS.cpp): every task is a thread,
+// the tick is 1ms on the HAL clock and priorities/cores are only recorded, the host OS schedules
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+#include <mutex>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef struct HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// Stack depth is in bytes like on IDF
+typedef uint8_t StackType_t;
+typedef struct
+{
+    void *unused;
+} StaticTask_t;
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portNUM_PROCESSORS 2
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define configASSERT(x) assert(x)
+
+// Task states and run time counters are always kept on the host(uxTaskGetSystemState)
+#define configUSE_TRACE_FACILITY 1
+#define configGENERATE_RUN_TIME_STATS 1
+
+// Critical sections lock a mutex, nesting on the same task is allowed like on IDF.
+// The scheduler holds back CPU time charged inside one so virtual time never switches tasks in it
+struct portMUX_TYPE
+{
+    std::recursive_mutex mutex;
+};
+void hostEnterCritical();
+void hostExitCritical();
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) ((mux)->mutex.lock(), hostEnterCritical())
+#define portEXIT_CRITICAL(mux) (hostExitCritical(), (mux)->mutex.unlock())
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL(mux)
+#define portYIELD_FROM_ISR()
@@ -1,79 +1,26 @@
 #include "AnalogRead_task.h"
 
-// Description: Averages value read from an analog pin based off sample rate in config.h
-// Parameters: rawanalog pin
-// Return: sum value given sample rate
+// Description: Reads a burst of samples from an analog pin and filters them(POT_SAMPLE_RATE and POLL_METHOD in config.h)
+// Parameters: rawanalog pin, capture hands the raw burst to the sensor capture(acquisition task only)
+// Return: filtered value in mV
 // Note: This will be deprecated if we move to ExpressIf Ide as we can do this via hardware
-int readSmooth(int pin)
+int readSmooth(int pin, bool capture)
 {
-    switch (POLL_METHOD)
+    // Samples stay on the stack so the acquisition loop never touches the heap
+    int samples[POT_SAMPLE_RATE];
+    int count = (POLL_METHOD >= 1 && POLL_METHOD <= 3) ? POT_SAMPLE_RATE : 1;
+    for (int i = 0; i < count; i++)
     {
-    case 0:
-        return analogReadMilliVolts(pin);
-    case 1:
-    {
-        //--Basic Average
-        long long sum = 0;
-        for (int i = 0; i < POT_SAMPLE_RATE; i++)
-        {
-            sum += analogReadMilliVolts(pin);
-        }
-        return sum / POT_SAMPLE_RATE;
-    }
-    case 2:
-    {
-        //--Median filter
-
-        // Store all readings in dynamic array and sort then take median value to avoid outliers
-        std::vector<int> readings;
-        readings.reserve(POT_SAMPLE_RATE);
-        for (int i = 0; i < POT_SAMPLE_RATE; i++)
-        {
-            readings.push_back(analogReadMilliVolts(pin));
-        }
-
-        // Get middle index(round down to middle value if even)
-        uint8_t n = readings.size() / 2;
-
-        // Sort vector to only have that value sorted
-        // Makes values to the left less than median and values to the right greater(still not ordered)
-        std::nth_element(readings.begin(), readings.begin() + n, readings.end());
-
-        int median = readings[n];
-
-        // If even, average two elements that would be in the mean
-        if (!(readings.size() & 1))
-        {
-            auto max_it = std::max_element(readings.begin(), readings.begin() + n);
-            median = (*max_it + median) / 2;
-        }
-
-        return median;
+        samples[i] = analogReadMilliVolts(pin);
     }
-    case 3:
+    if (capture)
     {
-        // --Trimmed mean filter
-        std::vector<int> readings;
-        readings.reserve(POT_SAMPLE_RATE);
-        for (int i = 0; i < POT_SAMPLE_RATE; i++)
-        {
-            readings.push_back(analogReadMilliVolts(pin));
-        }
-        std::sort(readings.begin(), readings.end());
-
-        // Remove top and bottom 25% of readings to avoid outliers
-        long long sum = 0;
-        int trimIndexStart = POT_SAMPLE_RATE / 4;
-        int trimIndexEnd = POT_SAMPLE_RATE - trimIndexStart;
-        for (int i = trimIndexStart; i < trimIndexEnd; i++)
-        {
-            sum += readings[i];
-        }
-        return sum / (trimIndexEnd - trimIndexStart);
-    }
-    default:
-        return analogReadMilliVolts(pin);
+        captureBurst(pin, samples, count);
     }
+    TRACE_BEGIN(TRACE_FILTER, pin);
+    int filtered = filterSamples(samples, count, POLL_METHOD);
+    TRACE_END(TRACE_FILTER, pin);
+    return filtered;
 }
 
 // Description: Reads all Analog Data from sensors
@@ -95,88 +42,56 @@ void TaskAnalogRead(void *pvParameters)
     pinMode(A_BUTTON, INPUT);
     pinMode(B_BUTTON, INPUT);
 
+    // Finger velocity for predicting where the finger will be when the spool gets there
+    FingerMotionPredictor predictors[5];
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        predictors[i].setFilter(FFB_VELOCITY_FILTER);
+    }
+
+    // Servo pot feedback for the force estimate
+    ServoForceEstimator forceEstimators[5];
+    for (uint8_t i = 0; SERVO_FORCE_FEEDBACK && i < 5; i++)
+    {
+        if (SERVO_FEEDBACK_PINS[i] != SERVO_FEEDBACK_NOT_FITTED)
+        {
+            pinMode(SERVO_FEEDBACK_PINS[i], INPUT);
+        }
+        forceEstimators[i].setCalibration({SERVO_FEEDBACK_MV_AT_0, SERVO_FEEDBACK_MV_AT_180,
+                                           SERVO_STALL_DEFLECTION_DEG, SERVO_FORCE_FILTER});
+    }
+
     // Get range from 0.0V to 3.3V
     analogSetAttenuation(ADC_11db);
     analogReadResolution(12);
 
     // Calibration phase
-    long long maxThumbValue = 4095, maxIndexValue = 4095, maxMiddleValue = 4095, maxRingValue = 4095, maxPinkieValue = 4095;
-    long long minThumbValue = 0, minIndexValue = 0, minMiddleValue = 0, minRingValue = 0, minPinkieValue = 0;
-    long long currentThumb = 0, currentIndex = 0, currentMiddle = 0, currentRing = 0, currentPinkie = 0;
+    // Flex sensor pins in finger order(thumb, index, middle, ring, pinkie)
+    const uint8_t potPins[5] = {THUMB_POT, INDEX_POT, MIDDLE_POT, RING_POT, PINKIE_POT};
+    long long closedValues[5] = {0, 0, 0, 0, 0};
+    long long openValues[5] = {4095, 4095, 4095, 4095, 4095};
 
     // If not simulation don't calibration
     if (!SIMULATION)
     {
-
-        maxThumbValue = 0, maxIndexValue = 0, maxMiddleValue = 0, maxRingValue = 0, maxPinkieValue = 0;
-        minThumbValue = 0, minIndexValue = 0, minMiddleValue = 0, minRingValue = 0, minPinkieValue = 0;
-        currentThumb = 0, currentIndex = 0, currentMiddle = 0, currentRing = 0, currentPinkie = 0;
+        FlexCalibrator calibrators[5];
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            calibrators[i].begin(CALIBRATION_METHOD);
+        }
 
         // For first 5 seconds, assume hand is flexed(open as hard as possible) and record that as max flex
         // Get current time
         unsigned long long startTime = millis();
-        long long counter = 0;
-
-        // If we are getting the extreme set a values to opposites
-        if (CALIBRATION_METHOD == 1)
-        {
-            maxThumbValue = LONG_LONG_MIN;
-            maxIndexValue = LONG_LONG_MIN;
-            maxMiddleValue = LONG_LONG_MIN;
-            maxRingValue = LONG_LONG_MIN;
-            maxPinkieValue = LONG_LONG_MIN;
-
-            minThumbValue = LONG_LONG_MAX;
-            minIndexValue = LONG_LONG_MAX;
-            minMiddleValue = LONG_LONG_MAX;
-            minRingValue = LONG_LONG_MAX;
-            minPinkieValue = LONG_LONG_MAX;
-        }
 
         // Check if 5 seconds has passed
         while (millis() - startTime < 5000)
         {
-            // Read current values
-            currentThumb = readSmooth(THUMB_POT);
-            currentIndex = readSmooth(INDEX_POT);
-            currentMiddle = readSmooth(MIDDLE_POT);
-            currentRing = readSmooth(RING_POT);
-            currentPinkie = readSmooth(PINKIE_POT);
-
-            if (CALIBRATION_METHOD == 0)
-            {
-                counter++;
-
-                maxThumbValue += currentThumb;
-                maxIndexValue += currentIndex;
-                maxMiddleValue += currentMiddle;
-                maxRingValue += currentRing;
-                maxPinkieValue += currentPinkie;
-            }
-            else
+            for (uint8_t i = 0; i < 5; i++)
             {
-                // Capture Observed Min and Max for each finger and update it ehere
-
-                // Update Maximums
-                if (currentThumb > maxThumbValue)
-                    maxThumbValue = currentThumb;
-                if (currentIndex > maxIndexValue)
-                    maxIndexValue = currentIndex;
-                if (currentMiddle > maxMiddleValue)
-                    maxMiddleValue = currentMiddle;
-                if (currentRing > maxRingValue)
-                    maxRingValue = currentRing;
-                if (currentPinkie > maxPinkieValue)
-                    maxPinkieValue = currentPinkie;
+                calibrators[i].addOpen(readSmooth(potPins[i], RAW_SENSOR_CAPTURE));
             }
-        }
-        if (CALIBRATION_METHOD == 0)
-        {
-            maxThumbValue /= counter;
-            maxIndexValue /= counter;
-            maxMiddleValue /= counter;
-            maxRingValue /= counter;
-            maxPinkieValue /= counter;
+            captureEndPass(SENSOR_PHASE_OPEN, NULL, 0, 0, 0);
         }
 
         // Blink LED to let user know to start closing hand
@@ -188,50 +103,21 @@ void TaskAnalogRead(void *pvParameters)
         // For next 5 seconds, assume hand is closed(clench as hard as possible) and record that as min flex
         // Get current time
         startTime = millis();
-        counter = 0;
 
         // Check if 5 seconds has passed
         while (millis() - startTime < 5000)
         {
-            // Read current values
-            currentThumb = readSmooth(THUMB_POT);
-            currentIndex = readSmooth(INDEX_POT);
-            currentMiddle = readSmooth(MIDDLE_POT);
-            currentRing = readSmooth(RING_POT);
-            currentPinkie = readSmooth(PINKIE_POT);
-
-            if (CALIBRATION_METHOD == 0)
+            for (uint8_t i = 0; i < 5; i++)
             {
-                counter++;
-
-                minThumbValue += currentThumb;
-                minIndexValue += currentIndex;
-                minMiddleValue += currentMiddle;
-                minRingValue += currentRing;
-                minPinkieValue += currentPinkie;
-            }
-            else
-            {
-                // Update Minimums
-                if (currentThumb < minThumbValue)
-                    minThumbValue = currentThumb;
-                if (currentIndex < minIndexValue)
-                    minIndexValue = currentIndex;
-                if (currentMiddle < minMiddleValue)
-                    minMiddleValue = currentMiddle;
-                if (currentRing < minRingValue)
-                    minRingValue = currentRing;
-                if (currentPinkie < minPinkieValue)
-                    minPinkieValue = currentPinkie;
+                calibrators[i].addClosed(readSmooth(potPins[i], RAW_SENSOR_CAPTURE));
             }
+            captureEndPass(SENSOR_PHASE_CLOSED, NULL, 0, 0, 0);
         }
-        if (CALIBRATION_METHOD == 0)
+
+        for (uint8_t i = 0; i < 5; i++)
         {
-            minThumbValue /= counter;
-            minIndexValue /= counter;
-            minMiddleValue /= counter;
-            minRingValue /= counter;
-            minPinkieValue /= counter;
+            openValues[i] = calibrators[i].openValue();
+            closedValues[i] = calibrators[i].closedValue();
         }
 
         // Blink LED to let user know calibration is done
@@ -240,39 +126,28 @@ void TaskAnalogRead(void *pvParameters)
         digitalWrite(LED_BUILTIN, LOW);
         vTaskDelay(pdMS_TO_TICKS(100));
     }
+    captureCalibration(openValues, closedValues);
 
     for (;;)
     {
+        markTaskLoop();
+        TRACE_BEGIN(TRACE_SAMPLE, 0);
 
         // Raw adc voltage values // Use smoothed read or raw voltage
-        int rawThumb = readSmooth(THUMB_POT);
-        int rawIndex = readSmooth(INDEX_POT);
-        int rawMiddle = readSmooth(MIDDLE_POT);
-        int rawRing = readSmooth(RING_POT);
-        int rawPinkie = readSmooth(PINKIE_POT);
-
-        // Now map the values based on calibration
+        // then map the values based on calibration
         // Note flip for opengloves (4095->0) and constrain to valid range
-        int thumbAngle = constrain(map(rawThumb, minThumbValue, maxThumbValue, 0, 4095), 0, 4095);
-        int indexAngle = constrain(map(rawIndex, minIndexValue, maxIndexValue, 0, 4095), 0, 4095);
-        int middleAngle = constrain(map(rawMiddle, minMiddleValue, maxMiddleValue, 0, 4095), 0, 4095);
-        int ringAngle = constrain(map(rawRing, minRingValue, maxRingValue, 0, 4095), 0, 4095);
-        int pinkieAngle = constrain(map(rawPinkie, minPinkieValue, maxPinkieValue, 0, 4095), 0, 4095);
-
-        if (CALIBRATION_METHOD == 1)
+        int fingerAngles[5];
+        for (uint8_t i = 0; i < 5; i++)
         {
-            thumbAngle = max(0, 4095 - thumbAngle);
-            indexAngle = max(0, 4095 - indexAngle);
-            middleAngle = max(0, 4095 - middleAngle);
-            ringAngle = max(0, 4095 - ringAngle);
-            pinkieAngle = max(0, 4095 - pinkieAngle);
+            fingerAngles[i] = flexToFinger(readSmooth(potPins[i], RAW_SENSOR_CAPTURE), closedValues[i], openValues[i], CALIBRATION_METHOD == 1);
         }
+
         // Debug print that show's a finger's raw current value and it's minumum and max recorded value during calibration
 
         // Arduino Serial Plotter format (label:value pairs)
         /*
         Serial.printf("Thumb:%d,Index:%d,Middle:%d,Ring:%d,Pinkie:%d\n",
-                      rawThumb, rawIndex, rawMiddle, rawRing, rawPinkie);
+                      fingerAngles[0], fingerAngles[1], fingerAngles[2], fingerAngles[3], fingerAngles[4]);
         */
 
         // Read controller button values
@@ -286,20 +161,47 @@ void TaskAnalogRead(void *pvParameters)
 
         // Calculate trigger button passed of value of bending
         // If index and thumb is more than 50% bent
-        if (thumbAngle + indexAngle + middleAngle + ringAngle + pinkieAngle >= 4095 * 2)
+        if (fingerAngles[0] + fingerAngles[1] + fingerAngles[2] + fingerAngles[3] + fingerAngles[4] >= 4095 * 2)
         {
             // Set current 4 bit of bit mask to have trigger button
             buttonMask |= (1 << 3);
         }
 
         // Send Data to Persistant State
-        DataBroker::instance().setFingerAngle(0, (thumbAngle));
-        DataBroker::instance().setFingerAngle(1, (indexAngle));
-        DataBroker::instance().setFingerAngle(2, (middleAngle));
-        DataBroker::instance().setFingerAngle(3, (ringAngle));
-        DataBroker::instance().setFingerAngle(4, (pinkieAngle));
+        TRACE_BEGIN(TRACE_BROKER_COMMIT, 0);
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            DataBroker::instance().setFingerAngle(i, fingerAngles[i]);
+        }
         DataBroker::instance().setJoystick(joystick_x, joystick_y);
         DataBroker::instance().setButtonsBitmask(buttonMask);
+        TRACE_END(TRACE_BROKER_COMMIT, 0);
+
+        // Finger velocity in the same units as the finger values, per second
+        uint32_t sampleUs = micros();
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            predictors[i].update(fingerAngles[i] / 4095.0f, sampleUs);
+            DataBroker::instance().setFingerVelocity(i, predictors[i].velocity() * 4095.0f);
+        }
+
+        // Estimate the force on each spool from how far its servo is held off the commanded angle
+        for (uint8_t i = 0; SERVO_FORCE_FEEDBACK && i < 5; i++)
+        {
+            if (SERVO_FEEDBACK_PINS[i] != SERVO_FEEDBACK_NOT_FITTED)
+            {
+                float force = forceEstimators[i].update(readSmooth(SERVO_FEEDBACK_PINS[i], RAW_SENSOR_CAPTURE), getServoCommandedAngle(i));
+                DataBroker::instance().setServoForce(i, force);
+            }
+        }
+
+        // Pre-positioned spools follow the finger at sensor rate, not only when the PC sends a target
+        if (FFB_TARGET_MODE && xServoTaskHandle != NULL)
+        {
+            xTaskNotifyGive(xServoTaskHandle);
+        }
+        TRACE_END(TRACE_SAMPLE, 0);
+        captureEndPass(SENSOR_PHASE_RUN, fingerAngles, joystick_x, joystick_y, buttonMask);
 
         vTaskDelay(pdMS_TO_TICKS(20));
     }
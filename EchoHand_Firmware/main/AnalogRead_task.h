@@ -8,10 +8,14 @@
 #include <HardwareSerial.h>
 #include <string>
 #include <climits>
-#include <vector>
 #include <algorithm>
 #include "config.h"
 #include "DataBroker.h"
-int readSmooth(int pin);
-int mapFlex(int raw);
+#include "TaskTable.h"
+#include "ServoControl_task.h"
+#include "FingerPrediction.h"
+#include "SensorFilter.h"
+#include "TraceRing.h"
+#include "SensorCapture.h"
+int readSmooth(int pin, bool capture = false);
 void TaskAnalogRead(void *pvParameters);
@@ -0,0 +1,70 @@
+#include "Benchmark_task.h"
+
+// Description: CPU cycle counter widened to 64 bits, the 32 bit counter wraps every ~18 s at 240 MHz
+// Parameters: none
+// Return: cycles since the first call
+static uint64_t cycleClock()
+{
+    static uint64_t total = 0;
+    static uint32_t last = esp_cpu_get_cycle_count();
+    uint32_t now = esp_cpu_get_cycle_count();
+    total += (uint32_t)(now - last);
+    last = now;
+    return total;
+}
+
+// Description: readSmooth() with the real ADC reads, the burst the host can only time without them
+// Parameters: iteration loop
+// Return: none
+static void benchReadSmooth(BenchState &state)
+{
+    while (state.keepRunning())
+    {
+        benchKeep(readSmooth(THUMB_POT));
+    }
+}
+
+static const BenchSpec targetBenchmarks[] = {
+    {"readSmooth/adc", benchReadSmooth},
+};
+
+// Description: Prints JSON text on the USB Serial
+// Parameters: text, unused context
+// Return: none
+static void writeSerial(const char *text, void *context)
+{
+    (void)context;
+    Serial.print(text);
+}
+
+// Description: Runs the hot path microbenchmarks once at boot and prints them as JSON(see HOT_PATH_BENCHMARK)
+// Runs above the servo and vibration tasks on core 1 so their wake ups don't land in the timings
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskBenchmark(void *pvParameters)
+{
+    // To not get compiler unused variable error
+    (void)pvParameters;
+
+    // Give the USB Serial time to come up
+    vTaskDelay(pdMS_TO_TICKS(2000));
+
+    const BenchClock clock = {cycleClock, getCpuFrequencyMhz() * 1e6, "cpu_cycles"};
+    const size_t total = hotPathBenchmarkCount + sizeof(targetBenchmarks) / sizeof(targetBenchmarks[0]);
+    static BenchResult results[HOT_PATH_BENCHMARK_MAX];
+
+    size_t count = 0;
+    for (size_t i = 0; i < total && count < HOT_PATH_BENCHMARK_MAX; i++)
+    {
+        const BenchSpec &spec = i < hotPathBenchmarkCount ? hotPathBenchmarks[i] : targetBenchmarks[i - hotPathBenchmarkCount];
+        results[count] = runBenchmark(spec, clock, 0.05, 5);
+        Serial.printf("Benchmark %-36s %10.1f cycles %10.1f ns\n", spec.name, results[count].bestTicks, results[count].bestNs);
+        count++;
+    }
+
+    Serial.println(BENCH_JSON_BEGIN);
+    writeBenchJson(results, count, clock, "esp32s3", writeSerial, NULL);
+    Serial.println(BENCH_JSON_END);
+
+    vTaskDelete(NULL);
+}
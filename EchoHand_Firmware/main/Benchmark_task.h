@@ -0,0 +1,19 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_cpu.h>
+#include "config.h"
+#include "AnalogRead_task.h"
+#include "HotPathBenchmarks.h"
+
+// Lines around the JSON on the USB Serial, Testing/bench_compare.py takes the document between them from a log
+#define BENCH_JSON_BEGIN "--- BENCH JSON BEGIN ---"
+#define BENCH_JSON_END "--- BENCH JSON END ---"
+
+// Most results one run holds, the shared hot path benchmarks plus the glove only ones
+#define HOT_PATH_BENCHMARK_MAX 24
+
+void TaskBenchmark(void *pvParameters);
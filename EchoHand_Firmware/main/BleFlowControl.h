@@ -0,0 +1,139 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Pure BLE link helpers shared by the glove's BLE transport and the host side mock(host/BleTransportMock.cpp)
+// No Bluedroid/FreeRTOS dependencies, the caller feeds in time, MTU and the controller's free buffers
+
+// Bytes of ATT header in every notification/write, the rest of the MTU is payload
+#define BLE_ATT_HEADER_SIZE 3
+
+// Description: Payload bytes one notification or write can carry at the given MTU
+// Parameters: negotiated ATT MTU
+// Return: payload bytes per packet
+inline size_t bleChunkPayload(uint16_t mtu)
+{
+    return mtu > BLE_ATT_HEADER_SIZE ? mtu - BLE_ATT_HEADER_SIZE : 1;
+}
+
+// Description: Number of packets needed to send a line at the given MTU
+// Parameters: line length in bytes, negotiated ATT MTU
+// Return: packet count
+inline size_t bleChunkCount(size_t length, uint16_t mtu)
+{
+    size_t payload = bleChunkPayload(mtu);
+    return (length + payload - 1) / payload;
+}
+
+// Paces input notifications so there is at most one line in the controller per connection event
+// Sending faster than the connection interval only queues frames in the controller and adds latency,
+// so when the slot isn't free yet the frame is skipped and the next slot sends whatever is newest
+class BleNotifyPacer
+{
+public:
+    // Description: Stores the MTU agreed with the central
+    // Parameters: negotiated ATT MTU
+    // Return: none
+    void setMtu(uint16_t mtu) { mtu_ = mtu; }
+
+    // Description: Stores the connection interval the central settled on
+    // Parameters: connection interval in microseconds
+    // Return: none
+    void setConnIntervalUs(uint32_t intervalUs) { connIntervalUs_ = intervalUs; }
+
+    // Description: Forgets the last send, called on connect so the first frame goes out right away
+    // Parameters: none
+    // Return: none
+    void reset()
+    {
+        sentAny_ = false;
+    }
+
+    // Description: Checks if a connection interval has passed since the last line
+    // Parameters: current time in microseconds
+    // Return: true if the next slot is open
+    bool slotOpen(uint32_t nowUs) const
+    {
+        return !sentAny_ || (uint32_t)(nowUs - lastSendUs_) >= connIntervalUs_;
+    }
+
+    // Description: Checks if the next line can go out without piling up in the controller
+    // Parameters: current time in microseconds, free controller buffers for this connection, line length
+    // Return: true if the caller should send now
+    bool readyToSend(uint32_t nowUs, uint16_t sendablePackets, size_t length)
+    {
+        if (!slotOpen(nowUs))
+        {
+            return false;
+        }
+        if (sendablePackets < bleChunkCount(length, mtu_))
+        {
+            deferred_++;
+            return false;
+        }
+        return true;
+    }
+
+    // Description: Records that a line was handed to the stack
+    // Parameters: current time in microseconds
+    // Return: none
+    void onSend(uint32_t nowUs)
+    {
+        sentAny_ = true;
+        lastSendUs_ = nowUs;
+        sent_++;
+    }
+
+    uint16_t mtu() const { return mtu_; }
+    uint32_t connIntervalUs() const { return connIntervalUs_; }
+    uint32_t framesSent() const { return sent_; }
+    uint32_t framesDeferred() const { return deferred_; }
+
+private:
+    uint16_t mtu_ = 23;
+    uint32_t connIntervalUs_ = 7500;
+    bool sentAny_ = false;
+    uint32_t lastSendUs_ = 0;
+    uint32_t sent_ = 0;
+    uint32_t deferred_ = 0;
+};
+
+// Rebuilds '\n' terminated lines from BLE packets(a line longer than MTU-3 arrives in pieces)
+// Size is the longest line kept, longer lines are dropped up to their '\n'
+template <size_t Size>
+class BleLineAssembler
+{
+public:
+    // Description: Adds one received byte
+    // Parameters: byte from a notification or write
+    // Return: true when a complete line is ready in line()
+    bool push(char byte)
+    {
+        if (byte == '\n')
+        {
+            bool complete = !overflow_;
+            buffer_[length_] = '\0';
+            lineLength_ = length_;
+            length_ = 0;
+            overflow_ = false;
+            return complete;
+        }
+        if (length_ >= Size - 1)
+        {
+            overflow_ = true;
+            return false;
+        }
+        buffer_[length_++] = byte;
+        return false;
+    }
+
+    // Null terminated line without the '\n', valid until the next push
+    const char *line() const { return buffer_; }
+    size_t lineLength() const { return lineLength_; }
+
+private:
+    char buffer_[Size];
+    size_t length_ = 0;
+    size_t lineLength_ = 0;
+    bool overflow_ = false;
+};
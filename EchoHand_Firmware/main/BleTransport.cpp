@@ -0,0 +1,165 @@
+#include "BleTransport.h"
+
+// Haptic writes from the BLE stack's task, drained by BleTransport::receiveLine
+static StreamBufferHandle_t hapticStream = NULL;
+
+// Link state shared with the stack callbacks
+static volatile bool connected = false;
+static volatile bool connectionChanged = false;
+static volatile uint16_t connectionId = 0;
+static volatile uint16_t connectionMtu = 23;
+static volatile uint32_t connectionIntervalUs = BLE_CONN_INTERVAL_UNITS * 1250;
+
+// Connection callbacks, asks the central for the shortest interval as soon as it connects
+class EchoServerCallbacks : public BLEServerCallbacks
+{
+    void onConnect(BLEServer *server, esp_ble_gatts_cb_param_t *param) override
+    {
+        connectionId = param->connect.conn_id;
+        connectionMtu = 23;
+        connected = true;
+        connectionChanged = true;
+
+        // Interval in 1.25ms units, no slave latency, supervision timeout in 10ms units
+        server->updateConnParams(param->connect.remote_bda, BLE_CONN_INTERVAL_UNITS, BLE_CONN_INTERVAL_UNITS, 0, BLE_SUPERVISION_TIMEOUT);
+    }
+
+    void onDisconnect(BLEServer *server) override
+    {
+        connected = false;
+        connectionChanged = true;
+
+        // Advertise again so the host can reconnect
+        server->startAdvertising();
+    }
+
+    void onMtuChanged(BLEServer *server, esp_ble_gatts_cb_param_t *param) override
+    {
+        connectionMtu = param->mtu.mtu;
+        connectionChanged = true;
+    }
+};
+
+// Haptic characteristic callbacks, hands the bytes over to the task without parsing in the stack's task
+class EchoHapticsCallbacks : public BLECharacteristicCallbacks
+{
+    void onWrite(BLECharacteristic *characteristic) override
+    {
+        xStreamBufferSend(hapticStream, characteristic->getData(), characteristic->getLength(), 0);
+    }
+};
+
+// Description: Picks up the connection interval the central actually agreed to
+// Parameters: GAP event and its parameters
+// Return: none
+static void onGapEvent(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param)
+{
+    if (event == ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT && param->update_conn_params.status == ESP_BT_STATUS_SUCCESS)
+    {
+        connectionIntervalUs = param->update_conn_params.conn_int * 1250;
+        connectionChanged = true;
+    }
+}
+
+// Description: Brings up the GATT server and starts advertising
+// Parameters: none
+// Return: true if the haptic buffer could be allocated
+bool BleTransport::begin()
+{
+    hapticStream = xStreamBufferCreate(BLE_HAPTICS_BUFFER_SIZE, 1);
+    if (hapticStream == NULL)
+    {
+        return false;
+    }
+
+    // Setup BLE stack, the MTU is offered to the central when it connects
+    BLEDevice::init(BLE_DEVICE_NAME);
+    BLEDevice::setMTU(BLE_MTU);
+    BLEDevice::setCustomGapHandler(onGapEvent);
+
+    BLEServer *server = BLEDevice::createServer();
+    server->setCallbacks(new EchoServerCallbacks());
+
+    BLEService *service = server->createService(BLE_SERVICE_UUID);
+
+    inputs_ = service->createCharacteristic(BLE_INPUTS_CHAR_UUID, BLECharacteristic::PROPERTY_NOTIFY);
+    inputs_->addDescriptor(new BLE2902());
+
+    BLECharacteristic *haptics = service->createCharacteristic(BLE_HAPTICS_CHAR_UUID, BLECharacteristic::PROPERTY_WRITE_NR);
+    haptics->setCallbacks(new EchoHapticsCallbacks());
+
+    service->start();
+
+    BLEAdvertising *advertising = BLEDevice::getAdvertising();
+    advertising->addServiceUUID(BLE_SERVICE_UUID);
+    advertising->setScanResponse(true);
+    BLEDevice::startAdvertising();
+    return true;
+}
+
+// Description: Rebuilds the next haptic line, a line longer than MTU-3 arrives over several writes
+// Parameters: buffer for the haptic line, its size and the line length out
+// Return: true if a complete line was copied
+bool BleTransport::receiveLine(char *buffer, size_t size, size_t &length)
+{
+    for (;;)
+    {
+        if (hapticOffset_ == hapticLength_)
+        {
+            hapticLength_ = xStreamBufferReceive(hapticStream, hapticBytes_, sizeof(hapticBytes_), 0);
+            hapticOffset_ = 0;
+            if (hapticLength_ == 0)
+            {
+                return false;
+            }
+        }
+
+        if (hapticLine_.push(hapticBytes_[hapticOffset_++]))
+        {
+            length = hapticLine_.lineLength() < size - 1 ? hapticLine_.lineLength() : size - 1;
+            memcpy(buffer, hapticLine_.line(), length);
+            buffer[length] = '\0';
+            return true;
+        }
+    }
+}
+
+// Description: Hands MTU and interval changes to the pacer and checks for an open slot
+// Parameters: current time in microseconds
+// Return: true if connected and a connection interval has passed since the last line
+bool BleTransport::readyToSend(uint32_t nowUs)
+{
+    if (connectionChanged)
+    {
+        connectionChanged = false;
+        pacer_.setMtu(connectionMtu);
+        pacer_.setConnIntervalUs(connectionIntervalUs);
+        pacer_.reset();
+    }
+
+    // Nothing to do until the host connects, haptics still get drained
+    return connected && pacer_.slotOpen(nowUs);
+}
+
+// Description: Notifies one line, split into MTU-3 chunks
+// Parameters: '\n' terminated line and its length
+// Return: false if the controller can't take the whole line, the next slot sends whatever is newest
+bool BleTransport::send(const char *line, size_t length)
+{
+    // One line per connection event and only when the controller can take all of it
+    uint32_t now = micros();
+    if (!pacer_.readyToSend(now, esp_ble_get_cur_sendable_packets_num(connectionId), length))
+    {
+        return false;
+    }
+
+    size_t payload = bleChunkPayload(pacer_.mtu());
+    for (size_t offset = 0; offset < length; offset += payload)
+    {
+        size_t chunk = length - offset < payload ? length - offset : payload;
+        inputs_->setValue((uint8_t *)line + offset, chunk);
+        inputs_->notify();
+    }
+    pacer_.onSend(now);
+    return true;
+}
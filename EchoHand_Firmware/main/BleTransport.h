@@ -0,0 +1,52 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/stream_buffer.h>
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLE2902.h>
+#include <esp_gap_ble_api.h>
+#include "config.h"
+#include "OpenGlovesCodec.h"
+#include "BleFlowControl.h"
+#include "Transport.h"
+
+// GATT layout, a Nordic UART style service so generic BLE serial tools can talk to the glove
+// Inputs go out as notifications, haptics come in as write without response
+#define BLE_SERVICE_UUID "6e400001-b5a3-f393-e0a9-e50e24dcca9e"
+#define BLE_HAPTICS_CHAR_UUID "6e400002-b5a3-f393-e0a9-e50e24dcca9e"
+#define BLE_INPUTS_CHAR_UUID "6e400003-b5a3-f393-e0a9-e50e24dcca9e"
+
+// Bytes of haptic writes buffered between the BLE stack and the task
+#define BLE_HAPTICS_BUFFER_SIZE 512
+
+// Native BLE link, the stack callbacks are global so only one instance may exist
+class BleTransport
+{
+public:
+    static constexpr bool includeJoystick = true;
+
+    bool begin();
+    bool receiveLine(char *buffer, size_t size, size_t &length);
+    bool readyToSend(uint32_t nowUs);
+    bool send(const char *line, size_t length);
+
+    // Sleep for one tick so lower priority tasks on this core get to run
+    void idle() { vTaskDelay(1); }
+
+    TransportStats stats{};
+
+private:
+    BLECharacteristic *inputs_ = NULL;
+    BleNotifyPacer pacer_;
+
+    // Haptic bytes taken from the stream buffer but not yet pushed into a line
+    BleLineAssembler<OPENGLOVES_MAX_LINE> hapticLine_;
+    uint8_t hapticBytes_[64];
+    size_t hapticLength_ = 0;
+    size_t hapticOffset_ = 0;
+};
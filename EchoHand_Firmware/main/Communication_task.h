@@ -0,0 +1,99 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "DataBroker.h"
+#include "TaskTable.h"
+#include "OpenGlovesCodec.h"
+#include "ServoControl_task.h"
+#include "Transport.h"
+#include "TraceRing.h"
+
+// Description: Comms loop shared by every link, one task per transport so several can run side by side
+// Parameters: pvParameters points at the transport instance(must outlive the task)
+// Return: none
+template <Transport T>
+void TaskCommunication(void *pvParameters)
+{
+    T &transport = *static_cast<T *>(pvParameters);
+
+    if (!transport.begin())
+    {
+        Serial.println("Transport failed to start, stopping its task.");
+        vTaskDelete(NULL);
+        return;
+    }
+
+    // Echohand snapshot and the line built from it
+    EchoStateSnapshot s;
+    InputsPayload in{};
+    char inputsString[OPENGLOVES_MAX_LINE];
+
+    // Haptic line and the command parsed from it
+    char hapticString[OPENGLOVES_MAX_LINE];
+    OpenGlovesCommand command;
+    size_t len = 0;
+
+    // Last recivison
+    uint32_t lastRevision = 0;
+
+    for (;;)
+    {
+        markTaskLoop();
+
+        // Parse every complete haptic line and update servo targets and vibration RPMs
+        while (transport.receiveLine(hapticString, sizeof(hapticString), len))
+        {
+            transport.stats.linesReceived++;
+            if (hapticString[0] == TRACE_DUMP_COMMAND)
+            {
+                requestTraceDump();
+                continue;
+            }
+            TRACE_BEGIN(TRACE_PARSE, len);
+            parseOpenGlovesCommand(hapticString, command);
+            applyHapticCommand(command);
+            TRACE_END(TRACE_PARSE, len);
+        }
+
+        // Send over payload when the link has a slot open, also with DEBUG_PRINT so debug builds time like release
+        if (transport.readyToSend(micros()))
+        {
+            // Let's take a screenshot of the current persistent state
+            DataBroker::instance().takeSnapshot(s);
+
+            // If the revision has changed, update the input payload and send it
+            if (s.revision != lastRevision)
+            {
+                // update packed inputs
+                for (uint8_t i = 0; i < 5; ++i)
+                {
+                    in.fingerAngles[i] = s.fingerAngles[i];
+                }
+                in.joystickXY[0] = s.joystickXY[0];
+                in.joystickXY[1] = s.joystickXY[1];
+                in.buttonsBitmask = s.buttonsBitmask;
+
+                // Keep the revision on a refused send so the next slot sends whatever is newest
+                TRACE_BEGIN(TRACE_ENCODE, 0);
+                len = encodeOpenGlovesInputs(in, T::includeJoystick, inputsString, sizeof(inputsString));
+                TRACE_END(TRACE_ENCODE, len);
+                if (transport.send(inputsString, len))
+                {
+                    transport.stats.framesSent++;
+                    transport.stats.bytesSent += len;
+                    lastRevision = s.revision;
+                }
+                else
+                {
+                    transport.stats.framesDeferred++;
+                }
+            }
+        }
+
+        transport.idle();
+    }
+}
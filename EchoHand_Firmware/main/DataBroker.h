@@ -1,15 +1,14 @@
 #pragma once
 #include <stdint.h>
 
-// Task signal to notify servo's to activate
-extern TaskHandle_t xServoTaskHandle;
-
 // This will be used as the basic data structure for the state of the EchoHand for when other tasks need to access the data
 struct EchoStateSnapshot
 {
   int fingerAngles[5];
+  float fingerVelocities[5];
   float servoTargetAngles[5];
   uint16_t vibrationRPMs[5];
+  float servoForces[5];
   float joystickXY[2];
   uint32_t buttonsBitmask;
   uint8_t batteryPercent;
@@ -43,6 +42,14 @@ public:
       incrementRevision();
     }
   }
+  void setFingerVelocity(uint8_t index, float velocity)
+  {
+    if (index < 5)
+    {
+      fingerVelocities_[index] = velocity;
+      incrementRevision();
+    }
+  }
   void setServoTargetAngle(uint8_t index, float angle)
   {
     if (index < 5)
@@ -59,6 +66,14 @@ public:
       incrementRevision();
     }
   }
+  void setServoForce(uint8_t index, float force)
+  {
+    if (index < 5)
+    {
+      servoForces_[index] = force;
+      incrementRevision();
+    }
+  }
   void setJoystick(float x, float y)
   {
     joystickXY_[0] = x;
@@ -78,8 +93,10 @@ public:
 
   // Read APIs ( for single values)
   int getFingerAngle(uint8_t index) const { return index < 5 ? fingerAngles_[index] : 0.0f; }
+  float getFingerVelocity(uint8_t index) const { return index < 5 ? fingerVelocities_[index] : 0.0f; }
   float getServoTargetAngle(uint8_t index) const { return index < 5 ? servoTargetAngles_[index] : 0.0f; }
   uint16_t getVibrationRPM(uint8_t index) const { return index < 5 ? vibrationRPMs_[index] : 0; }
+  float getServoForce(uint8_t index) const { return index < 5 ? servoForces_[index] : 0.0f; }
   void getJoystick(float &x, float &y) const
   {
     x = joystickXY_[0];
@@ -96,6 +113,11 @@ public:
     out.fingerAngles[2] = fingerAngles_[2];
     out.fingerAngles[3] = fingerAngles_[3];
     out.fingerAngles[4] = fingerAngles_[4];
+    out.fingerVelocities[0] = fingerVelocities_[0];
+    out.fingerVelocities[1] = fingerVelocities_[1];
+    out.fingerVelocities[2] = fingerVelocities_[2];
+    out.fingerVelocities[3] = fingerVelocities_[3];
+    out.fingerVelocities[4] = fingerVelocities_[4];
     out.servoTargetAngles[0] = servoTargetAngles_[0];
     out.servoTargetAngles[1] = servoTargetAngles_[1];
     out.servoTargetAngles[2] = servoTargetAngles_[2];
@@ -106,6 +128,11 @@ public:
     out.vibrationRPMs[2] = vibrationRPMs_[2];
     out.vibrationRPMs[3] = vibrationRPMs_[3];
     out.vibrationRPMs[4] = vibrationRPMs_[4];
+    out.servoForces[0] = servoForces_[0];
+    out.servoForces[1] = servoForces_[1];
+    out.servoForces[2] = servoForces_[2];
+    out.servoForces[3] = servoForces_[3];
+    out.servoForces[4] = servoForces_[4];
     out.joystickXY[0] = joystickXY_[0];
     out.joystickXY[1] = joystickXY_[1];
     out.buttonsBitmask = buttonsBitmask_;
@@ -122,8 +149,10 @@ private:
   DataBroker()
       : revision_(0),
         fingerAngles_{0, 0, 0, 0, 0},
+        fingerVelocities_{0, 0, 0, 0, 0},
         servoTargetAngles_{0, 0, 0, 0, 0},
         vibrationRPMs_{0, 0, 0, 0, 0},
+        servoForces_{0, 0, 0, 0, 0},
         joystickXY_{0, 0},
         buttonsBitmask_(0),
         batteryPercent_(100) {}
@@ -132,8 +161,10 @@ private:
 
   volatile uint32_t revision_;
   volatile float fingerAngles_[5];
+  volatile float fingerVelocities_[5];
   volatile float servoTargetAngles_[5];
   volatile uint16_t vibrationRPMs_[5];
+  volatile float servoForces_[5];
   volatile float joystickXY_[2];
   volatile uint32_t buttonsBitmask_;
   volatile uint8_t batteryPercent_;
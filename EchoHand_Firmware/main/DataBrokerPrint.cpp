@@ -1,87 +1,58 @@
 #include "DataBrokerPrint_task.h"
 
-// Description: Print out current values from persistant state
+// Description: Streams the persistant state and the servo/vibration stats as binary telemetry frames on the USB
+// Serial every 1000 / TELEMETRY_RATE_HZ ms(TelemetryCodec.h). One Serial.write of ~120 bytes per frame instead of
+// formatted text keeps the task's CPU and link time small enough that debug builds run like release ones,
+// host/TelemetryDecode shows the frames as the table, plotter or CSV views
 // Parameters: pvParameters which is a place holder for any pointer to any type
-// Return: none, it will simply pass the information on to the next core for processing
+// Return: none
 void TaskDataBrokerPrint(void *pvParameters)
 {
     // To not get compiler unused variable error
     (void)pvParameters;
 
-    for (;;)
+    if (!DEBUG_PRINT)
     {
-        if (DEBUG_PRINT)
-        {
-            // Check if we should use plotter format
-            if (USE_SERIAL_PLOTTER)
-            {
-                // Serial Plotter format
-                Serial.printf("Thumb:%d Index:%d Middle:%d Ring:%d Pinkie:%d ",
-                              DataBroker::instance().getFingerAngle(0),
-                              DataBroker::instance().getFingerAngle(1),
-                              DataBroker::instance().getFingerAngle(2),
-                              DataBroker::instance().getFingerAngle(3),
-                              DataBroker::instance().getFingerAngle(4));
-                Serial.printf("\n");
-            }
-            else
-            {
-                // Original Serial Monitor format
-                Serial.println("\n=== PAYLOAD STATUS ===");
-
-                // Finger angles
-                Serial.println("Finger Angles (deg):");
-                Serial.printf("  Thumb : %d\n", DataBroker::instance().getFingerAngle(0));
-                Serial.printf("  Index : %d\n", DataBroker::instance().getFingerAngle(1));
-                Serial.printf("  Middle: %d\n", DataBroker::instance().getFingerAngle(2));
-                Serial.printf("  Ring  : %d\n", DataBroker::instance().getFingerAngle(3));
-                Serial.printf("  Pinkie: %d\n", DataBroker::instance().getFingerAngle(4));
-                Serial.println();
-
-                // Servo targets
-
-                Serial.println("Servo Targets (deg):");
-                Serial.printf("  Thumb : %.1f\n", DataBroker::instance().getServoTargetAngle(0));
-                Serial.printf("  Index : %.1f\n", DataBroker::instance().getServoTargetAngle(1));
-                Serial.printf("  Middle: %.1f\n", DataBroker::instance().getServoTargetAngle(2));
-                Serial.printf("  Ring  : %.1f\n", DataBroker::instance().getServoTargetAngle(3));
-                Serial.printf("  Pinkie: %.1f\n", DataBroker::instance().getServoTargetAngle(4));
-                Serial.println();
+        vTaskDelete(NULL);
+        return;
+    }
 
-                // Vibration motors
-                Serial.println("Vibration RPM:");
-                Serial.printf("  Thumb : %d\n", DataBroker::instance().getVibrationRPM(0));
-                Serial.printf("  Index : %d\n", DataBroker::instance().getVibrationRPM(1));
-                Serial.printf("  Middle: %d\n", DataBroker::instance().getVibrationRPM(2));
-                Serial.printf("  Ring  : %d\n", DataBroker::instance().getVibrationRPM(3));
-                Serial.printf("  Pinkie: %d\n", DataBroker::instance().getVibrationRPM(4));
-                Serial.println();
+    // Frame and its wire bytes stay static, the loop never touches the heap
+    static TelemetryFrame frame;
+    static uint8_t wire[TELEMETRY_MAX_FRAME];
+    EchoStateSnapshot s;
 
-                // Joystick
-                float joyX, joyY;
-                DataBroker::instance().getJoystick(joyX, joyY);
-                Serial.println("Joystick:");
-                Serial.printf("  X: %.3f\n", joyX);
-                Serial.printf("  Y: %.3f\n", joyY);
-                Serial.println();
+    frame.flags = (SERVO_FORCE_FEEDBACK ? TELEMETRY_FLAG_FORCE_FEEDBACK : 0) | (VIBRATION_ENABLE ? TELEMETRY_FLAG_VIBRATION : 0);
+    TickType_t lastWake = xTaskGetTickCount();
 
-                // Buttons
-                uint32_t buttons = DataBroker::instance().getButtonsBitmask();
-                Serial.println("Buttons:");
-                Serial.printf("  Bitmask      : 0b%03lu (0x%02lX)\n", buttons, buttons);
-                Serial.printf("  Joystick Btn : %s\n", (buttons & 0b100) ? "released" : "PRESSED");
-                Serial.printf("  A Button     : %s\n", (buttons & 0b010) ? "PRESSED" : "released");
-                Serial.printf("  B Button     : %s\n", (buttons & 0b001) ? "PRESSED" : "released");
-                Serial.println();
+    for (;;)
+    {
+        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(1000 / TELEMETRY_RATE_HZ));
+        markTaskLoop();
 
-                // Battery
-                Serial.printf("Battery: %d%%\n", DataBroker::instance().getBatteryPercent());
-            }
-        }
-        else
+        DataBroker::instance().takeSnapshot(s);
+        frame.timeMs = millis();
+        frame.revision = s.revision;
+        for (uint8_t i = 0; i < 5; i++)
         {
-            vTaskDelete(NULL);
+            frame.fingerAngles[i] = s.fingerAngles[i];
+            frame.fingerVelocities[i] = s.fingerVelocities[i];
+            frame.servoTargetAngles[i] = s.servoTargetAngles[i];
+            frame.servoForces[i] = s.servoForces[i];
+            frame.vibrationRPMs[i] = s.vibrationRPMs[i];
+            frame.vibrationPercent[i] = (uint8_t)(100 * getVibrationLevel(i) + 0.5f);
         }
-        vTaskDelay(pdMS_TO_TICKS(20));
+        frame.joystickXY[0] = s.joystickXY[0];
+        frame.joystickXY[1] = s.joystickXY[1];
+        frame.buttonsBitmask = s.buttonsBitmask;
+        frame.batteryPercent = s.batteryPercent;
+
+        // Servo writes that reached the LEDC registers vs ones skipped by change detection
+        getServoWriteStats(frame.servoWrites, frame.servoSkipped);
+        frame.freeHeap = esp_get_free_heap_size();
+
+        size_t length = encodeTelemetryFrame(frame, wire, sizeof(wire));
+        Serial.write(wire, length);
+        frame.sequence++;
     }
-}
\ No newline at end of file
+}
@@ -6,8 +6,12 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <HardwareSerial.h>
-#include <string>
+#include <esp_system.h>
 #include "config.h"
 #include "DataBroker.h"
+#include "TaskTable.h"
+#include "TelemetryCodec.h"
+#include "ServoControl_task.h"
+#include "VibrationControl_task.h"
 
 void TaskDataBrokerPrint(void *pvParameters);
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include "TraceFormat.h"
+
+// Control lines of the ESP-NOW link that stay between the glove and the receiver dongle, shared by both firmwares
+// (EchoHand_Receiver_Firmware includes this file from here). No Arduino/FreeRTOS dependencies so host tools can
+// run the same code. A prefix here must not start an OpenGloves line or a command the PC sends through the link.
+
+// Prefix of a radio control line from the PC, e.g. "$C6R3L0" -> channel 6, rate 3, long range off
+#define RADIO_COMMAND_PREFIX '$'
+
+// Prefix of the glove's answer to a radio command, e.g. "%C6R3L0". Sent on the old settings with the settings the
+// glove switches to, the receiver only switches once it has it. A bare "%" is a probe, the glove sends them while
+// new settings are on trial so a still hand(no input frames) doesn't look like a dead link, the receiver answers
+#define RADIO_ACK_PREFIX '%'
+
+// Prefix of the loss report the receiver sends back, e.g. "#L25" -> 2.5% of frames lost
+#define LINK_FEEDBACK_PREFIX '#'
+
+// Both ends go back to the previous settings if nothing arrives this long after switching(ms)
+#define RADIO_REVERT_TIMEOUT_MS 1000
+
+// Number of entries in the ESP-NOW PHY rate table (see ESPNOW_PHY_RATE in config.h)
+#define ESPNOW_PHY_RATE_COUNT 7
+
+static_assert(RADIO_COMMAND_PREFIX != TRACE_DUMP_COMMAND && RADIO_ACK_PREFIX != TRACE_DUMP_COMMAND &&
+                  LINK_FEEDBACK_PREFIX != TRACE_DUMP_COMMAND,
+              "ESP-NOW control lines would swallow the trace dump command");
+
+// Radio settings that both ends of the ESP-NOW link have to agree on
+struct EspNowRadioSettings
+{
+    uint8_t channel;
+    uint8_t phyRate;
+    bool longRange;
+};
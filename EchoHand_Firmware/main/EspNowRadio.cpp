@@ -0,0 +1,126 @@
+#include "EspNowRadio.h"
+
+// PHY rate table, index is ESPNOW_PHY_RATE in config.h
+// Keep in sync with the table in EchoHand_Receiver_Firmware/main/main.cpp
+static const esp_now_rate_config_t phyRateTable[ESPNOW_PHY_RATE_COUNT] = {
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_1M_L, false, false},
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_2M, false, false},
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_11M_L, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_6M, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_24M, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_54M, false, false},
+    {WIFI_PHY_MODE_HT20, WIFI_PHY_RATE_MCS7_SGI, false, false},
+};
+
+// Long range trades rate for sensitivity, 500Kbps is the faster of the two LR rates
+static const esp_now_rate_config_t longRangeRate = {WIFI_PHY_MODE_LR, WIFI_PHY_RATE_LORA_500K, false, false};
+
+// Description: Parses a radio control line ("$C<channel>R<rate>L<0/1>") into settings, any field may be left out
+// Parameters: command is a null terminated line starting with RADIO_COMMAND_PREFIX, settings is updated in place
+// Return: true if the line was a valid radio command, settings is left untouched otherwise
+bool parseRadioCommand(const char *command, EspNowRadioSettings &settings)
+{
+    if (command == NULL || *command != RADIO_COMMAND_PREFIX)
+    {
+        return false;
+    }
+
+    // Work on a copy so a bad field doesn't leave half applied settings
+    EspNowRadioSettings parsed = settings;
+    const char *currentByte = command + 1;
+
+    while (*currentByte != '\0' && *currentByte != '\n')
+    {
+        char field = *currentByte;
+        currentByte++;
+
+        // Every field needs a value
+        if (*currentByte < '0' || *currentByte > '9')
+        {
+            return false;
+        }
+
+        int intValue = 0;
+        while (*currentByte >= '0' && *currentByte <= '9')
+        {
+            intValue = (intValue * 10) + (*currentByte - '0');
+            currentByte++;
+        }
+
+        switch (field)
+        {
+        case 'C':
+            if (intValue < 1 || intValue > 13)
+                return false;
+            parsed.channel = intValue;
+            break;
+        case 'R':
+            if (intValue >= ESPNOW_PHY_RATE_COUNT)
+                return false;
+            parsed.phyRate = intValue;
+            break;
+        case 'L':
+            parsed.longRange = (intValue != 0);
+            break;
+        default:
+            return false;
+        }
+    }
+
+    settings = parsed;
+    return true;
+}
+
+// Description: Applies channel, long range mode and PHY rate to the Wi-Fi driver and the ESP-NOW peer
+// Parameters: peerInfo of the registered peer(channel gets updated), settings to apply
+// Return: true if every driver call succeeded
+bool applyEspNowRadio(esp_now_peer_info_t &peerInfo, const EspNowRadioSettings &settings)
+{
+    bool success = true;
+
+    // Long range has to be in the protocol bitmap of the interface before the LR rate can be used
+    uint8_t protocol = WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N;
+    if (settings.longRange)
+    {
+        protocol |= WIFI_PROTOCOL_LR;
+    }
+    if (esp_wifi_set_protocol(WIFI_IF_STA, protocol) != ESP_OK)
+    {
+        Serial.println("Failed to set Wi-Fi protocol.");
+        success = false;
+    }
+
+    if (esp_wifi_set_channel(settings.channel, WIFI_SECOND_CHAN_NONE) != ESP_OK)
+    {
+        Serial.println("Failed to set Wi-Fi channel.");
+        success = false;
+    }
+
+    // Peer has to follow the channel or esp_now_send will reject it
+    peerInfo.channel = settings.channel;
+    if (esp_now_mod_peer(&peerInfo) != ESP_OK)
+    {
+        Serial.println("Failed to update peer channel.");
+        success = false;
+    }
+
+    esp_now_rate_config_t rateConfig = settings.longRange ? longRangeRate : phyRateTable[settings.phyRate < ESPNOW_PHY_RATE_COUNT ? settings.phyRate : 0];
+    if (esp_now_set_peer_rate_config(peerInfo.peer_addr, &rateConfig) != ESP_OK)
+    {
+        Serial.println("Failed to set ESP-NOW peer rate.");
+        success = false;
+    }
+
+    Serial.printf("ESP-NOW radio: channel %d, rate %d, long range %s\n",
+                  settings.channel, settings.phyRate, settings.longRange ? "on" : "off");
+    return success;
+}
+
+// Description: Builds the ack of a radio command, every field spelled out so the receiver can check it against its own
+// Parameters: settings the glove switches to, buffer and its size
+// Return: length of the ack without its null terminator
+size_t formatRadioAck(const EspNowRadioSettings &settings, char *buffer, size_t size)
+{
+    int length = snprintf(buffer, size, "%cC%uR%uL%u", RADIO_ACK_PREFIX, settings.channel, settings.phyRate, settings.longRange ? 1u : 0u);
+    return length < 0 ? 0 : ((size_t)length < size ? (size_t)length : size - 1);
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <HardwareSerial.h>
+#include <esp_wifi.h>
+#include <esp_now.h>
+#include "config.h"
+#include "EspNowLink.h"
+
+// Time the ack gets to go out on the old settings before the glove switches(ms)
+#define RADIO_SWITCH_DELAY_MS 20
+
+// Period of the probes while new settings are on trial(ms)
+#define RADIO_PROBE_PERIOD_MS 100
+
+bool parseRadioCommand(const char *command, EspNowRadioSettings &settings);
+bool applyEspNowRadio(esp_now_peer_info_t &peerInfo, const EspNowRadioSettings &settings);
+size_t formatRadioAck(const EspNowRadioSettings &settings, char *buffer, size_t size);
@@ -0,0 +1,245 @@
+#include "EspNowTransport.h"
+
+// MAC address of other ESP32
+static const uint8_t broadcastAddress[] = {0x30, 0xED, 0xA0, 0xBC, 0x0B, 0x34};
+
+// Global array for servo angles
+char incoming_servo_data[256];
+
+// Global array for servo data
+volatile bool new_servo_data = false;
+
+// Frames received of any kind, tells the radio switch there is traffic on the new settings
+volatile uint32_t frames_received = 0;
+
+// Send callback results, consumed by the task loop
+volatile bool send_complete = false;
+volatile bool send_success = false;
+
+// Global for send results(ACK from receiver or retries exhausted)
+void on_data_sent(const uint8_t *mac_addr, esp_now_send_status_t status)
+{
+    (void)mac_addr;
+
+    send_success = (status == ESP_NOW_SEND_SUCCESS);
+    send_complete = true;
+    TRACE_INSTANT(TRACE_ESPNOW_SENT, send_success);
+}
+
+// Global for received data(servos)
+void on_data_receive(const esp_now_recv_info_t *esp_now_info, const uint8_t *incoming_data, int len)
+{
+    (void)esp_now_info;
+    frames_received = frames_received + 1;
+
+    // Copy servo angles to local array, leaving room for the null terminator
+    int copy_len = len < (int)sizeof(incoming_servo_data) - 1 ? len : (int)sizeof(incoming_servo_data) - 1;
+    memcpy(incoming_servo_data, incoming_data, copy_len);
+    incoming_servo_data[copy_len] = '\0';
+
+    new_servo_data = true;
+    TRACE_INSTANT(TRACE_ESPNOW_RECEIVE, len);
+}
+
+// Description: Sets up WiFi, ESP-NOW, the receiver as peer and the radio settings from config.h
+// Parameters: none
+// Return: true once the peer is registered
+bool EspNowTransport::begin()
+{
+    // Setup ESP32 WIFI Moudle
+    WiFi.mode(WIFI_STA);
+
+    // Check if it initalized
+    if (esp_now_init() != ESP_OK)
+    {
+        Serial.println("Error setting up ESP_NOW");
+    }
+
+    // Print ESP32 MAC Address
+    Serial.print("ESP32 MAC Address: ");
+    Serial.println(WiFi.macAddress());
+
+    // Clear struct
+    memset(&peerInfo_, 0, sizeof(peerInfo_));
+
+    // Register Peer
+    memcpy(peerInfo_.peer_addr, broadcastAddress, sizeof(broadcastAddress));
+    peerInfo_.channel = 0;
+    peerInfo_.encrypt = false;
+
+    // Set Wi-FI interface to station mode
+    peerInfo_.ifidx = WIFI_IF_STA;
+
+    while (esp_now_add_peer(&peerInfo_) != ESP_OK)
+    {
+        Serial.println("Failed to add peer MAC Address.");
+    }
+
+    // Apply channel, PHY rate and long range mode from config.h
+    radioSettings_ = {ESPNOW_CHANNEL, ESPNOW_PHY_RATE, ESPNOW_LONG_RANGE != 0};
+    applyEspNowRadio(peerInfo_, radioSettings_);
+
+    // Register callback for data received
+    esp_now_register_recv_cb(on_data_receive);
+
+    // Register callback for send results so the scheduler knows when the air is free again
+    esp_now_register_send_cb(on_data_sent);
+    return true;
+}
+
+// Description: Takes the last received packet, handles receiver control lines itself
+// Parameters: buffer for the haptic line, its size and the line length out
+// Return: true if a haptic line was copied
+bool EspNowTransport::receiveLine(char *buffer, size_t size, size_t &length)
+{
+    // If there's new servo data
+    if (!new_servo_data)
+    {
+        return false;
+    }
+
+    const char *currentByte = incoming_servo_data;
+    bool isHaptic = false;
+
+    // Radio control line from the receiver, ack it on the current settings and switch once the ack is out
+    if (*currentByte == RADIO_COMMAND_PREFIX)
+    {
+        EspNowRadioSettings requested = radioSettings_;
+        if (parseRadioCommand(currentByte, requested))
+        {
+            char ack[16];
+            size_t ackLength = formatRadioAck(requested, ack, sizeof(ack));
+            esp_now_send(broadcastAddress, (const uint8_t *)ack, ackLength + 1);
+            pendingRadio_ = requested;
+            radioSwitchMs_ = millis();
+            radioState_ = RADIO_SWITCH_PENDING;
+        }
+        else
+        {
+            Serial.println("Invalid radio command.");
+        }
+    }
+    // Probe from the receiver while new settings are on trial, arriving is all it has to do
+    else if (*currentByte == RADIO_ACK_PREFIX)
+    {
+    }
+    // Loss report from the receiver, feeds the send scheduler
+    else if (*currentByte == LINK_FEEDBACK_PREFIX)
+    {
+        if (currentByte[1] == 'L')
+        {
+            sendRate_.onLossReport(atoi(currentByte + 2));
+        }
+    }
+    else
+    {
+        length = strnlen(currentByte, size - 1);
+        memcpy(buffer, currentByte, length);
+        buffer[length] = '\0';
+        isHaptic = true;
+    }
+
+    new_servo_data = false;
+    return isHaptic;
+}
+
+// Description: Hands the last send result to the scheduler and checks if it allows another frame
+// Parameters: current time in microseconds
+// Return: true if a frame may go out now
+bool EspNowTransport::readyToSend(uint32_t nowUs)
+{
+    // Hand over the result of the last send to the scheduler
+    if (send_complete)
+    {
+        send_complete = false;
+        sendRate_.onSendComplete(send_success);
+    }
+
+    // Hold off while a frame is still in the air or the scheduler wants us to back off
+    // Skipped snapshots aren't lost, the next slot sends whatever is newest
+    return !ADAPTIVE_SEND_RATE || sendRate_.readyToSend(nowUs);
+}
+
+// Description: Frames the line with a sequence number and hands it to ESP-NOW
+// Parameters: '\n' terminated line and its length
+// Return: always true, a failed esp_now_send is counted as a send error
+bool EspNowTransport::send(const char *line, size_t length)
+{
+    // Frame is the string(+ null terminator) followed by the little endian sequence number
+    // The receiver only forwards up to the null terminator so OpenGloves never sees it
+    size_t stringLength = length + 1;
+    if (stringLength + sizeof(sequence_) > sizeof(frame_))
+    {
+        stringLength = sizeof(frame_) - sizeof(sequence_);
+    }
+    memcpy(frame_, line, stringLength);
+    frame_[stringLength - 1] = '\0';
+    frame_[stringLength] = sequence_ & 0xFF;
+    frame_[stringLength + 1] = sequence_ >> 8;
+    sequence_++;
+
+    // Send the constructed frame as one packet
+    TRACE_BEGIN(TRACE_ESPNOW_SEND, sequence_ - 1);
+    if (esp_now_send(broadcastAddress, frame_, stringLength + sizeof(sequence_)) == ESP_OK)
+    {
+        sendRate_.onSend(micros());
+    }
+    else
+    {
+        stats.sendErrors++;
+    }
+    TRACE_END(TRACE_ESPNOW_SEND, sequence_ - 1);
+    return true;
+}
+
+// Description: Drives a runtime radio switch: applies it once the ack had time to go out, probes the new settings and
+// goes back to the previous ones if nothing arrives on them
+// Parameters: none
+// Return: none
+void EspNowTransport::idle()
+{
+    if (radioState_ == RADIO_STEADY)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+    if (radioState_ == RADIO_SWITCH_PENDING)
+    {
+        if (now - radioSwitchMs_ < RADIO_SWITCH_DELAY_MS)
+        {
+            return;
+        }
+        previousRadio_ = radioSettings_;
+        radioSettings_ = pendingRadio_;
+        applyEspNowRadio(peerInfo_, radioSettings_);
+        trialFrames_ = frames_received;
+        radioSwitchMs_ = now;
+        lastProbeMs_ = now - RADIO_PROBE_PERIOD_MS;
+        radioState_ = RADIO_ON_TRIAL;
+    }
+
+    // Any frame from the receiver on the new settings confirms them
+    if (frames_received != trialFrames_)
+    {
+        radioState_ = RADIO_STEADY;
+        return;
+    }
+
+    if (now - radioSwitchMs_ >= RADIO_REVERT_TIMEOUT_MS)
+    {
+        Serial.println("No traffic on the new radio settings, reverting.");
+        radioSettings_ = previousRadio_;
+        applyEspNowRadio(peerInfo_, radioSettings_);
+        radioState_ = RADIO_STEADY;
+        return;
+    }
+
+    // The receiver answers a probe with its own if it is on the new settings too
+    if (now - lastProbeMs_ >= RADIO_PROBE_PERIOD_MS)
+    {
+        static const char probe[] = {RADIO_ACK_PREFIX, '\0'};
+        esp_now_send(broadcastAddress, (const uint8_t *)probe, sizeof(probe));
+        lastProbeMs_ = now;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <HardwareSerial.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include "config.h"
+#include "EspNowRadio.h"
+#include "SendRateController.h"
+#include "Transport.h"
+#include "TraceRing.h"
+
+// ESP-NOW link to the receiver dongle, the callbacks are global so only one instance may exist
+class EspNowTransport
+{
+public:
+    static constexpr bool includeJoystick = JOYSTICK_ENABLE;
+
+    bool begin();
+    bool receiveLine(char *buffer, size_t size, size_t &length);
+    bool readyToSend(uint32_t nowUs);
+    bool send(const char *line, size_t length);
+    void idle();
+
+    TransportStats stats{};
+
+private:
+    // Info of other ESP32 connected to PC
+    esp_now_peer_info_t peerInfo_;
+    EspNowRadioSettings radioSettings_;
+
+    // Runtime radio switch: the command is acked on the old settings, applied RADIO_SWITCH_DELAY_MS later and kept
+    // on trial until a frame arrives on the new settings, without one it reverts after RADIO_REVERT_TIMEOUT_MS
+    enum RadioSwitchState : uint8_t
+    {
+        RADIO_STEADY,
+        RADIO_SWITCH_PENDING,
+        RADIO_ON_TRIAL
+    };
+    RadioSwitchState radioState_ = RADIO_STEADY;
+    EspNowRadioSettings pendingRadio_;
+    EspNowRadioSettings previousRadio_;
+    uint32_t radioSwitchMs_ = 0;
+    uint32_t lastProbeMs_ = 0;
+    uint32_t trialFrames_ = 0;
+
+    // Adaptive send scheduler and frame sequence number(lets the receiver count lost frames)
+    SendRateController sendRate_;
+    uint16_t sequence_ = 0;
+    uint8_t frame_[ESP_NOW_MAX_DATA_LEN];
+};
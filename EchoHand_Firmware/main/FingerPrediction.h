@@ -0,0 +1,161 @@
+#pragma once
+#include <stdint.h>
+
+// Local finger prediction for hiding the FFB round trip.
+// Curl is the finger value sent to OpenGloves scaled to 0.0(open)-1.0(closed). A spool angle A in FFB
+// target space blocks the finger at curl 1 - A/180, the same mapping the PC uses when it turns an
+// object's curl into an A-E limit, so the glove can work out locally where the spool has to be.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// Curl velocity estimate for one finger, fed at the acquisition task's sample rate
+class FingerMotionPredictor
+{
+public:
+    // Description: Sets the velocity low pass
+    // Parameters: weight of each new velocity sample(1 -> no filtering)
+    // Return: none
+    void setFilter(float alpha) { alpha_ = alpha; }
+
+    // Description: Takes a new curl sample
+    // Parameters: curl from 0.0-1.0, sample time in microseconds
+    // Return: none
+    void update(float curl, uint32_t nowUs)
+    {
+        if (hasSample_)
+        {
+            uint32_t dtUs = nowUs - lastUs_;
+            if (dtUs > 0)
+            {
+                float sample = (curl - curl_) * 1e6f / dtUs;
+                velocity_ += alpha_ * (sample - velocity_);
+            }
+        }
+        curl_ = curl;
+        lastUs_ = nowUs;
+        hasSample_ = true;
+    }
+
+    // Description: Extrapolates the curl along the current velocity
+    // Parameters: how far ahead in microseconds
+    // Return: predicted curl from 0.0-1.0
+    float predict(uint32_t leadUs) const
+    {
+        float curl = curl_ + velocity_ * leadUs * 1e-6f;
+        return curl < 0 ? 0 : (curl > 1 ? 1 : curl);
+    }
+
+    float curl() const { return curl_; }
+    float velocity() const { return velocity_; }
+
+private:
+    float alpha_ = 0.5f;
+    float curl_ = 0;
+    float velocity_ = 0;
+    uint32_t lastUs_ = 0;
+    bool hasSample_ = false;
+};
+
+// Description: Spool angle that keeps the spool a little ahead of the finger and stops on the PC's limit.
+// Once the finger comes within reach of the limit the spool shadows it, so when it reaches the limit(or a late
+// limit arrives) the spool only has the slack left to travel instead of its whole range. Without a limit or with
+// the finger still far from it there is nothing to shadow and 0 is passed through, so the servo can idle
+// Parameters: limit angle commanded by the PC(target space, 0 = no limit), predicted curl(0.0-1.0),
+//             slack of free curl to leave in front of the finger, curl short of the limit where shadowing starts
+// Return: spool angle in target space, 0 for none
+inline float prePositionAngle(float limitAngle, float predictedCurl, float slack, float reach)
+{
+    float limitCurl = 1.0f - limitAngle / 180.0f;
+    if (limitAngle <= 0 || limitCurl - predictedCurl > reach)
+    {
+        return 0;
+    }
+    float shadowCurl = predictedCurl + slack;
+    float shadowAngle = 180.0f * (1.0f - (shadowCurl > 1 ? 1 : shadowCurl));
+    return shadowAngle > limitAngle ? shadowAngle : limitAngle;
+}
+
+// Locally enforced stop for one finger, the stop curl is what the PC's A-E value(0-1000) encodes:
+// FFBManager sends 1000 - curl * 1000 for the curl an object stops the finger at.
+// The spool locks once the measured curl reaches the stop and unlocks when the finger opens past the
+// hysteresis. While locked, curl creeping past the stop(strap and string give) tightens the spool until the
+// finger is back on it, so a grabbed object stays rigid without any further PC traffic.
+class FingerStopLimit
+{
+public:
+    // Most the spool is tightened past the stop's own angle to make up for give
+    static constexpr float MAX_CORRECTION = 30.0f;
+
+    // Description: Sets how far the finger has to open before the lock lets go
+    // Parameters: hysteresis in curl(0.0-1.0)
+    // Return: none
+    void setHysteresis(float hysteresis) { hysteresis_ = hysteresis; }
+
+    // Description: Sets how quickly curl past the stop tightens the spool
+    // Parameters: degrees per second per unit of curl past the stop
+    // Return: none
+    void setCorrectionGain(float gain) { gain_ = gain; }
+
+    // Description: Sets the stop, clearing it also forgets the learned give
+    // Parameters: stop curl from 0.0-1.0, 1.0 or more for no stop
+    // Return: none
+    void setStop(float stopCurl)
+    {
+        if (stopCurl >= 1.0f)
+        {
+            stop_ = 1.0f;
+            locked_ = false;
+            correction_ = 0;
+            return;
+        }
+        stop_ = stopCurl < 0 ? 0 : stopCurl;
+    }
+
+    // Description: Checks a curl sample against the stop and updates the lock
+    // Parameters: measured curl from 0.0-1.0, sample time in microseconds
+    // Return: spool angle in target space that holds the finger on its stop, 0 with no stop
+    float update(float curl, uint32_t nowUs)
+    {
+        uint32_t dtUs = hasUpdate_ ? nowUs - lastUs_ : 0;
+        dtUs = dtUs > 100000 ? 100000 : dtUs;
+        lastUs_ = nowUs;
+        hasUpdate_ = true;
+
+        if (stop_ >= 1.0f)
+        {
+            return 0;
+        }
+
+        if (!locked_ && curl >= stop_)
+        {
+            locked_ = true;
+            locks_++;
+        }
+        else if (locked_ && curl < stop_ - hysteresis_)
+        {
+            locked_ = false;
+        }
+
+        if (locked_)
+        {
+            correction_ += gain_ * (curl - stop_) * (dtUs * 1e-6f);
+            correction_ = correction_ < 0 ? 0 : (correction_ > MAX_CORRECTION ? MAX_CORRECTION : correction_);
+        }
+
+        float angle = 180.0f * (1.0f - stop_) + (locked_ ? correction_ : 0);
+        return angle > 180.0f ? 180.0f : angle;
+    }
+
+    bool locked() const { return locked_; }
+    float correction() const { return correction_; }
+    uint32_t locks() const { return locks_; }
+
+private:
+    float hysteresis_ = 0.05f;
+    float gain_ = 600.0f;
+    float stop_ = 1.0f;
+    float correction_ = 0;
+    bool locked_ = false;
+    uint32_t lastUs_ = 0;
+    bool hasUpdate_ = false;
+    uint32_t locks_ = 0;
+};
@@ -0,0 +1,212 @@
+#include "HotPathBenchmarks.h"
+#include <string.h>
+#include "config.h"
+#include "DataBroker.h"
+#include "OpenGlovesCodec.h"
+#include "SensorFilter.h"
+
+// Input tables, a benchmark iteration picks entry index & (INPUT_COUNT - 1)
+#define INPUT_COUNT 64
+
+// Bursts of flex sensor samples around a finger position with ADC noise, one burst per readSmooth() call
+static int sampleBursts[INPUT_COUNT][POT_SAMPLE_RATE];
+
+// Filtered readings and the lines the PC sends
+static int readings[INPUT_COUNT][5];
+static char commandLines[INPUT_COUNT][OPENGLOVES_MAX_LINE];
+
+// Description: Fills the input tables from a fixed seed the first time a benchmark needs them
+// Parameters: none
+// Return: none
+static void makeInputs()
+{
+    static bool made = false;
+    if (made)
+    {
+        return;
+    }
+    made = true;
+
+    // Small deterministic PRNG(xorshift32) so the inputs don't depend on the C library
+    uint32_t state = 0x9E3779B9u;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    for (int n = 0; n < INPUT_COUNT; n++)
+    {
+        int position = 600 + next() % 2200;
+        for (int i = 0; i < POT_SAMPLE_RATE; i++)
+        {
+            // +-40 mV of noise with the odd 300 mV spike the median and trimmed mean are there for
+            int noise = (int)(next() % 81) - 40;
+            sampleBursts[n][i] = position + (next() % 16 == 0 ? 300 : noise);
+        }
+        for (int i = 0; i < 5; i++)
+        {
+            readings[n][i] = 600 + next() % 2200;
+        }
+        unsigned limits[5];
+        for (int i = 0; i < 5; i++)
+        {
+            limits[i] = next() % 1001;
+        }
+        snprintf(commandLines[n], OPENGLOVES_MAX_LINE, "A%uB%uC%uD%uE%u%s\n", limits[0], limits[1], limits[2],
+                 limits[3], limits[4], n % 8 == 0 ? "F150.5" : "");
+    }
+}
+
+// Description: Filters one burst like readSmooth() does after reading it(the copy stands in for the ADC reads)
+// Parameters: iteration loop, noise reduction method(see POLL_METHOD in config.h)
+// Return: none
+static void filterBurst(BenchState &state, int method)
+{
+    makeInputs();
+    int samples[POT_SAMPLE_RATE];
+    int count = (method >= 1 && method <= 3) ? POT_SAMPLE_RATE : 1;
+    while (state.keepRunning())
+    {
+        memcpy(samples, sampleBursts[state.index() & (INPUT_COUNT - 1)], sizeof(samples));
+        benchKeep(filterSamples(samples, count, method));
+    }
+}
+
+static void benchFilterFirst(BenchState &state) { filterBurst(state, 0); }
+static void benchFilterAverage(BenchState &state) { filterBurst(state, 1); }
+static void benchFilterMedian(BenchState &state) { filterBurst(state, 2); }
+static void benchFilterTrimmedMean(BenchState &state) { filterBurst(state, 3); }
+
+// Description: Maps five filtered readings onto finger values, once per acquisition pass
+// Parameters: iteration loop
+// Return: none
+static void benchFlexToFinger(BenchState &state)
+{
+    makeInputs();
+    const long long closedValues[5] = {610, 605, 598, 620, 601};
+    const long long openValues[5] = {2790, 2805, 2810, 2795, 2800};
+    while (state.keepRunning())
+    {
+        const int *reading = readings[state.index() & (INPUT_COUNT - 1)];
+        for (int i = 0; i < 5; i++)
+        {
+            benchKeep(flexToFinger(reading[i], closedValues[i], openValues[i], CALIBRATION_METHOD == 1));
+        }
+    }
+}
+
+// Description: Takes five readings into the calibration, once per calibration pass
+// Parameters: iteration loop
+// Return: none
+static void benchCalibratorAdd(BenchState &state)
+{
+    makeInputs();
+    FlexCalibrator calibrators[5];
+    for (int i = 0; i < 5; i++)
+    {
+        calibrators[i].begin(CALIBRATION_METHOD);
+    }
+    while (state.keepRunning())
+    {
+        const int *reading = readings[state.index() & (INPUT_COUNT - 1)];
+        for (int i = 0; i < 5; i++)
+        {
+            calibrators[i].addOpen(reading[i]);
+        }
+    }
+    benchKeep(calibrators[0].openValue());
+}
+
+// Description: DataBroker writes of one acquisition pass(fingers, joystick, buttons, velocities)
+// Parameters: iteration loop
+// Return: none
+static void benchBrokerSet(BenchState &state)
+{
+    makeInputs();
+    DataBroker &broker = DataBroker::instance();
+    while (state.keepRunning())
+    {
+        const int *reading = readings[state.index() & (INPUT_COUNT - 1)];
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            broker.setFingerAngle(i, reading[i]);
+        }
+        broker.setJoystick(reading[0], reading[1]);
+        broker.setButtonsBitmask(reading[2] & 0xF);
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            broker.setFingerVelocity(i, reading[i] * 0.5f);
+        }
+    }
+}
+
+// Description: Snapshot the comms loop takes before every send
+// Parameters: iteration loop
+// Return: none
+static void benchBrokerSnapshot(BenchState &state)
+{
+    EchoStateSnapshot snapshot;
+    while (state.keepRunning())
+    {
+        DataBroker::instance().takeSnapshot(snapshot);
+        benchKeep(snapshot);
+    }
+}
+
+// Description: Encodes the input line sent to the PC
+// Parameters: iteration loop, whether the joystick fields are included
+// Return: none
+static void encodeInputs(BenchState &state, bool includeJoystick)
+{
+    makeInputs();
+    InputsPayload in{};
+    char line[OPENGLOVES_MAX_LINE];
+    while (state.keepRunning())
+    {
+        const int *reading = readings[state.index() & (INPUT_COUNT - 1)];
+        for (int i = 0; i < 5; i++)
+        {
+            in.fingerAngles[i] = reading[i] + reading[i] / 2;
+        }
+        in.joystickXY[0] = reading[0];
+        in.joystickXY[1] = reading[1];
+        in.buttonsBitmask = reading[2] & 0xF;
+        benchKeep(encodeOpenGlovesInputs(in, includeJoystick, line, sizeof(line)));
+        benchClobber();
+    }
+}
+
+static void benchEncodeInputs(BenchState &state) { encodeInputs(state, false); }
+static void benchEncodeInputsJoystick(BenchState &state) { encodeInputs(state, true); }
+
+// Description: Parses the FFB line the PC sends
+// Parameters: iteration loop
+// Return: none
+static void benchParseCommand(BenchState &state)
+{
+    makeInputs();
+    OpenGlovesCommand command;
+    while (state.keepRunning())
+    {
+        parseOpenGlovesCommand(commandLines[state.index() & (INPUT_COUNT - 1)], command);
+        benchKeep(command);
+    }
+}
+
+const BenchSpec hotPathBenchmarks[] = {
+    {"filterSamples/first", benchFilterFirst},
+    {"filterSamples/average", benchFilterAverage},
+    {"filterSamples/median", benchFilterMedian},
+    {"filterSamples/trimmedMean", benchFilterTrimmedMean},
+    {"calibration/flexToFinger x5", benchFlexToFinger},
+    {"calibration/addOpen x5", benchCalibratorAdd},
+    {"DataBroker/set pass", benchBrokerSet},
+    {"DataBroker/takeSnapshot", benchBrokerSnapshot},
+    {"OpenGloves/encodeInputs", benchEncodeInputs},
+    {"OpenGloves/encodeInputs joystick", benchEncodeInputsJoystick},
+    {"OpenGloves/parseCommand", benchParseCommand},
+};
+const size_t hotPathBenchmarkCount = sizeof(hotPathBenchmarks) / sizeof(hotPathBenchmarks[0]);
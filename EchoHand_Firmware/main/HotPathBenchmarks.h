@@ -0,0 +1,12 @@
+#pragma once
+#include <stddef.h>
+#include "MicroBench.h"
+
+// Microbenchmarks of the sensor->wire hot path: filtering a burst of ADC samples, calibration mapping, the
+// DataBroker writes and snapshot of one acquisition pass and the OpenGloves line codec.
+// Inputs are fixed tables so every run(host or glove) times the same work.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// Benchmarks in the order they run
+extern const BenchSpec hotPathBenchmarks[];
+extern const size_t hotPathBenchmarkCount;
@@ -0,0 +1,141 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Microbenchmark harness in the style of Google Benchmark, small enough to run on the glove.
+// A benchmark loops with while (state.keepRunning()) over the code it measures, the runner grows the iteration
+// count until one run lasts long enough for the clock, then repeats it and keeps the best and mean per iteration.
+// Results are written as Google Benchmark JSON so runs from the host and the glove can be compared with the
+// same tools(Testing/bench_compare.py).
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// Time source of a run: the CPU cycle counter on the glove, a nanosecond clock on the host
+struct BenchClock
+{
+    uint64_t (*now)();
+    double ticksPerSecond;
+    const char *name;
+};
+
+// Description: Keeps a value alive so the compiler can't drop the work that produced it
+// Parameters: value
+// Return: none
+template <typename T>
+inline void benchKeep(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Description: Makes the compiler assume memory changed, so stores before it aren't dropped as dead
+// Parameters: none
+// Return: none
+inline void benchClobber()
+{
+    asm volatile("" : : : "memory");
+}
+
+// Iteration loop handed to a benchmark
+class BenchState
+{
+public:
+    explicit BenchState(uint32_t iterations) : iterations_(iterations), done_(0) {}
+
+    // Description: Counts one iteration
+    // Parameters: none
+    // Return: true while iterations are left
+    bool keepRunning() { return done_++ < iterations_; }
+
+    // Iteration being run, for picking inputs from a table
+    uint32_t index() const { return done_ - 1; }
+    uint32_t iterations() const { return iterations_; }
+
+private:
+    uint32_t iterations_;
+    uint32_t done_;
+};
+
+struct BenchSpec
+{
+    const char *name;
+    void (*function)(BenchState &state);
+};
+
+struct BenchResult
+{
+    const char *name;
+    uint32_t iterations;
+    double bestNs;
+    double meanNs;
+    double bestTicks;
+};
+
+// Description: Runs one benchmark, grows the iteration count until a run lasts minSeconds then repeats it
+// Parameters: benchmark, clock, shortest run in seconds, number of timed runs
+// Return: best and mean time per iteration over the timed runs
+inline BenchResult runBenchmark(const BenchSpec &spec, const BenchClock &clock, double minSeconds, int repetitions)
+{
+    const uint64_t minTicks = (uint64_t)(minSeconds * clock.ticksPerSecond);
+    const uint32_t maxIterations = 1u << 30;
+
+    // Grow the run until it is long enough to time, aiming a little past the minimum
+    uint32_t iterations = 1;
+    for (;;)
+    {
+        BenchState state(iterations);
+        uint64_t start = clock.now();
+        spec.function(state);
+        uint64_t ticks = clock.now() - start;
+        if (ticks >= minTicks || iterations >= maxIterations)
+        {
+            break;
+        }
+        double scale = ticks > 0 ? 1.4 * minTicks / ticks : 10.0;
+        scale = scale > 10.0 ? 10.0 : (scale < 2.0 ? 2.0 : scale);
+        iterations = iterations * scale < maxIterations ? (uint32_t)(iterations * scale) : maxIterations;
+    }
+
+    BenchResult result = {spec.name, iterations, 0, 0, 0};
+    double bestTicks = 0;
+    double sumTicks = 0;
+    for (int r = 0; r < repetitions; r++)
+    {
+        BenchState state(iterations);
+        uint64_t start = clock.now();
+        spec.function(state);
+        double ticks = (double)(clock.now() - start) / iterations;
+        bestTicks = r == 0 || ticks < bestTicks ? ticks : bestTicks;
+        sumTicks += ticks;
+    }
+    result.bestTicks = bestTicks;
+    result.bestNs = bestTicks * 1e9 / clock.ticksPerSecond;
+    result.meanNs = repetitions > 0 ? sumTicks / repetitions * 1e9 / clock.ticksPerSecond : 0;
+    return result;
+}
+
+// Output of the JSON writer, the glove prints on Serial and the host writes a file
+typedef void (*BenchWriteFn)(const char *text, void *context);
+
+// Description: Writes results as a Google Benchmark JSON document(real_time and cpu_time are the best run,
+// mean_time and ticks_per_iteration are extra fields)
+// Parameters: results and their count, clock they were taken with, name of the machine, output and its context
+// Return: none
+inline void writeBenchJson(const BenchResult *results, size_t count, const BenchClock &clock, const char *target,
+                           BenchWriteFn write, void *context)
+{
+    char line[256];
+    snprintf(line, sizeof(line),
+             "{\n  \"context\": {\"target\": \"%s\", \"clock\": \"%s\", \"ticks_per_second\": %.0f},\n  \"benchmarks\": [\n",
+             target, clock.name, clock.ticksPerSecond);
+    write(line, context);
+    for (size_t i = 0; i < count; i++)
+    {
+        const BenchResult &r = results[i];
+        snprintf(line, sizeof(line),
+                 "    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %lu, \"real_time\": %.3f, "
+                 "\"cpu_time\": %.3f, \"mean_time\": %.3f, \"ticks_per_iteration\": %.1f, \"time_unit\": \"ns\"}%s\n",
+                 r.name, (unsigned long)r.iterations, r.bestNs, r.bestNs, r.meanNs, r.bestTicks, i + 1 < count ? "," : "");
+        write(line, context);
+    }
+    write("  ]\n}\n", context);
+}
@@ -0,0 +1,154 @@
+#include "OpenGlovesCodec.h"
+
+// Description: Appends a key and its decimal value to the output line
+// Parameters: write position, end of the buffer(exclusive), key character and value
+// Return: new write position, unchanged if the field doesn't fit
+static char *appendField(char *out, const char *end, char key, int value)
+{
+  char digits[12];
+  int count = 0;
+  bool negative = value < 0;
+  unsigned int magnitude = negative ? 0u - (unsigned int)value : (unsigned int)value;
+
+  // Digits come out backwards, flip them while copying
+  do
+  {
+    digits[count++] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0);
+
+  if (end - out < count + 1 + (negative ? 1 : 0))
+  {
+    return out;
+  }
+
+  *out++ = key;
+  if (negative)
+  {
+    *out++ = '-';
+  }
+  while (count > 0)
+  {
+    *out++ = digits[--count];
+  }
+  return out;
+}
+
+// Description: Encodes the inputs as one OpenGloves line("A..B..C..D..E..[F..G..]{L}{H}{J}{K}\n")
+// Parameters: inputs to send, includeJoystick adds the F/G axes and H button, output buffer and its size
+// Return: length of the line without the null terminator
+size_t encodeOpenGlovesInputs(const InputsPayload &in, bool includeJoystick, char *buffer, size_t size)
+{
+  if (size == 0)
+  {
+    return 0;
+  }
+
+  // Keep room for '\n' and the null terminator
+  char *out = buffer;
+  const char *end = buffer + size - 2;
+
+  for (int i = 0; i < 5; i++)
+  {
+    out = appendField(out, end, 'A' + i, in.fingerAngles[i]);
+  }
+  if (includeJoystick)
+  {
+    out = appendField(out, end, 'F', in.joystickXY[0]);
+    out = appendField(out, end, 'G', in.joystickXY[1]);
+  }
+
+  if ((in.buttonsBitmask & TRIGGER_BUTTON_BITMASK) && out < end)
+    *out++ = 'L';
+  if (includeJoystick && !(in.buttonsBitmask & JOYSTICK_BUTTON_BITMASK) && out < end)
+    *out++ = 'H';
+  if ((in.buttonsBitmask & A_BUTTON_BITMASK) && out < end)
+    *out++ = 'J';
+  if ((in.buttonsBitmask & B_BUTTON_BITMASK) && out < end)
+    *out++ = 'K';
+
+  *out++ = '\n';
+  *out = '\0';
+  return out - buffer;
+}
+
+// Description: Parses an OpenGloves FFB line, A-E are servo limits(0-1000) and F is vibration(Hz)
+// Parameters: null terminated line, command to fill in
+// Return: none, unknown characters are skipped
+void parseOpenGlovesCommand(const char *line, OpenGlovesCommand &command)
+{
+  const char *currentByte = line;
+
+  for (int i = 0; i < 5; i++)
+  {
+    command.hasServo[i] = false;
+    command.servoTargetAngles[i] = 0;
+  }
+  command.hasVibration = false;
+  command.vibrationRPM = 0;
+
+  // Process the entire buffer received in memory
+  while (*currentByte != '\0')
+  {
+    // Check for Commands A-E (Servo Angles)
+    if (*currentByte >= 'A' && *currentByte <= 'E')
+    {
+      char finger = *currentByte - 'A';
+      currentByte++;
+
+      int intValue = 0;
+
+      // Parse integer part
+      while (*currentByte >= '0' && *currentByte <= '9')
+      {
+        intValue = (intValue * 10) + (*currentByte - '0');
+        currentByte++;
+      }
+
+      // OpenGloves sends 0-1000, servos take 0-180 degrees
+      command.hasServo[(int)finger] = true;
+      command.servoTargetAngles[(int)finger] = (180 * intValue) / 1000;
+    }
+
+    // Check for Command F (Vibration)
+    else if (*currentByte == 'F')
+    {
+      currentByte++;
+
+      float floatValue = 0.0f;
+      float fraction = 0.1f;
+      bool isFraction = false;
+
+      // Parse float part
+      while ((*currentByte >= '0' && *currentByte <= '9') || *currentByte == '.')
+      {
+        if (*currentByte == '.')
+        {
+          isFraction = true;
+        }
+        else
+        {
+          if (!isFraction)
+          {
+            floatValue = (floatValue * 10) + (*currentByte - '0');
+          }
+          else
+          {
+            floatValue += (*currentByte - '0') * fraction;
+            fraction *= 0.1f;
+          }
+        }
+        currentByte++;
+      }
+
+      // Frequency in Hz to RPM
+      command.hasVibration = true;
+      command.vibrationRPM = floatValue * 60;
+    }
+    // If not a recognized command, skip the byte
+    else
+    {
+      currentByte++;
+    }
+  }
+}
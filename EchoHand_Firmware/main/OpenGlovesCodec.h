@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Bits of DataBroker's button mask
+#define TRIGGER_BUTTON_BITMASK (0x01 << 3)
+#define JOYSTICK_BUTTON_BITMASK (0x1 << 2)
+#define A_BUTTON_BITMASK (0x1 << 1)
+#define B_BUTTON_BITMASK (0x1 << 0)
+
+// Longest line encodeOpenGlovesInputs can produce(5 fingers, 2 joystick axes, 4 buttons, '\n' and null terminator)
+#define OPENGLOVES_MAX_LINE 64
+
+// Struct for input payloads
+struct InputsPayload
+{
+  int fingerAngles[5];
+  int joystickXY[2];
+  uint32_t buttonsBitmask;
+};
+
+// Haptic command parsed from one OpenGloves FFB line, only the fields present in the line are flagged
+struct OpenGlovesCommand
+{
+  bool hasServo[5];
+  int servoTargetAngles[5];
+  bool hasVibration;
+  uint16_t vibrationRPM;
+};
+
+// Shared by every transport, no Arduino/FreeRTOS dependencies so host tools can run the same code
+size_t encodeOpenGlovesInputs(const InputsPayload &in, bool includeJoystick, char *buffer, size_t size);
+void parseOpenGlovesCommand(const char *line, OpenGlovesCommand &command);
@@ -0,0 +1,125 @@
+#pragma once
+#include <stdint.h>
+
+// Tuning knobs for SendRateController, all times are in microseconds
+struct SendRateConfig
+{
+    // Fastest we ever send (500 Hz) and slowest we back off to (20 Hz)
+    uint32_t minIntervalUs = 2000;
+    uint32_t maxIntervalUs = 50000;
+
+    // Speed up after every acknowledged frame by an eighth of the interval, but at least this much
+    uint32_t decreaseStepUs = 250;
+
+    // Stop waiting on a send callback after this long and treat the frame as failed
+    uint32_t inFlightTimeoutUs = 20000;
+
+    // Receiver reported loss (per mille) above which we back off and below which we may speed up again
+    uint16_t highLossPermille = 50;
+    uint16_t lowLossPermille = 10;
+};
+
+// Decides when the glove may put the next frame on air.
+// The send interval grows by half on every failed send callback and high loss report from the receiver,
+// and eases back down on every acknowledged frame. Only one frame is ever in flight, newer snapshots
+// simply replace older ones that never got a slot, so the driver queue can't build up.
+// No Arduino/FreeRTOS dependencies so the host link simulation can drive the exact same code.
+class SendRateController
+{
+public:
+    explicit SendRateController(const SendRateConfig &config = SendRateConfig())
+        : config_(config),
+          intervalUs_(config.minIntervalUs),
+          lastSendUs_(0),
+          inFlight_(false),
+          congested_(false),
+          lastLossPermille_(0),
+          framesSent_(0),
+          framesFailed_(0) {}
+
+    // Returns true if a frame may be sent now, expires a stuck in-flight frame as a failure
+    bool readyToSend(uint32_t nowUs)
+    {
+        uint32_t elapsed = nowUs - lastSendUs_;
+        if (inFlight_)
+        {
+            if (elapsed < config_.inFlightTimeoutUs)
+            {
+                return false;
+            }
+            onSendComplete(false);
+        }
+        return framesSent_ == 0 || elapsed >= intervalUs_;
+    }
+
+    // Call right after handing a frame to the driver
+    void onSend(uint32_t nowUs)
+    {
+        lastSendUs_ = nowUs;
+        inFlight_ = true;
+        framesSent_++;
+    }
+
+    // Call with the result of the send callback
+    void onSendComplete(bool success)
+    {
+        if (!inFlight_)
+        {
+            return;
+        }
+        inFlight_ = false;
+
+        if (success)
+        {
+            // Only speed up while the receiver isn't complaining
+            if (!congested_)
+            {
+                uint32_t step = intervalUs_ / 8 > config_.decreaseStepUs ? intervalUs_ / 8 : config_.decreaseStepUs;
+                intervalUs_ = intervalUs_ > config_.minIntervalUs + step ? intervalUs_ - step : config_.minIntervalUs;
+            }
+        }
+        else
+        {
+            framesFailed_++;
+            backOff(intervalUs_ / 2);
+        }
+    }
+
+    // Call whenever the receiver reports its measured loss
+    void onLossReport(uint16_t lossPermille)
+    {
+        lastLossPermille_ = lossPermille;
+        if (lossPermille > config_.highLossPermille)
+        {
+            congested_ = true;
+            backOff(intervalUs_ / 2);
+        }
+        else if (lossPermille < config_.lowLossPermille)
+        {
+            congested_ = false;
+        }
+    }
+
+    uint32_t intervalUs() const { return intervalUs_; }
+    bool inFlight() const { return inFlight_; }
+    bool congested() const { return congested_; }
+    uint16_t lastLossPermille() const { return lastLossPermille_; }
+    uint32_t framesSent() const { return framesSent_; }
+    uint32_t framesFailed() const { return framesFailed_; }
+
+private:
+    void backOff(uint32_t increaseUs)
+    {
+        uint32_t next = intervalUs_ + increaseUs;
+        intervalUs_ = next < config_.maxIntervalUs ? next : config_.maxIntervalUs;
+    }
+
+    SendRateConfig config_;
+    uint32_t intervalUs_;
+    uint32_t lastSendUs_;
+    bool inFlight_;
+    bool congested_;
+    uint16_t lastLossPermille_;
+    uint32_t framesSent_;
+    uint32_t framesFailed_;
+};
@@ -0,0 +1,152 @@
+#include "SensorCapture.h"
+#include <atomic>
+
+static_assert(POT_SAMPLE_RATE <= SENSOR_BURST_MAX_SAMPLES, "POT_SAMPLE_RATE doesn't fit a captured burst");
+static_assert((RAW_CAPTURE_BUFFER_BYTES & (RAW_CAPTURE_BUFFER_BYTES - 1)) == 0, "RAW_CAPTURE_BUFFER_BYTES must be a power of 2");
+
+// Ring bytes, one when capture is compiled out so the ring takes no RAM
+#define CAPTURE_RING_BYTES (RAW_SENSOR_CAPTURE ? RAW_CAPTURE_BUFFER_BYTES : 1)
+
+// Run passes between repeats of the calibration record, so a recorder started late still gets it(~5 s)
+#define CALIBRATION_REPEAT_PASSES 250
+
+// Single producer(acquisition task) single consumer(capture task) byte ring, head and tail count bytes ever
+// written and read
+static uint8_t ring[CAPTURE_RING_BYTES];
+static std::atomic<uint32_t> ringHead(0);
+static std::atomic<uint32_t> ringTail(0);
+
+// Pass being collected and the calibration, owned by the acquisition task
+static SensorPass pass;
+static SensorCalibration calibration;
+static bool haveCalibration = false;
+static uint32_t runPasses = 0;
+
+// Description: Frames a record into the ring, or drops it whole if the ring is too full
+// Parameters: record and its length
+// Return: none
+static void pushRecord(const uint8_t *record, size_t length)
+{
+    static uint8_t frame[SENSOR_FRAME_MAX_BYTES];
+    size_t framed = frameSensorRecord(record, length, frame, sizeof(frame));
+    uint32_t head = ringHead.load(std::memory_order_relaxed);
+    uint32_t used = head - ringTail.load(std::memory_order_acquire);
+    if (framed == 0 || framed > CAPTURE_RING_BYTES - used)
+    {
+        return;
+    }
+    for (size_t i = 0; i < framed; i++)
+    {
+        ring[(head + i) & (CAPTURE_RING_BYTES - 1)] = frame[i];
+    }
+    ringHead.store(head + framed, std::memory_order_release);
+}
+
+// Description: Queues the calibration record
+// Parameters: none
+// Return: none
+static void pushCalibration()
+{
+    uint8_t record[SENSOR_CALIBRATION_BYTES];
+    size_t length = encodeSensorCalibration(calibration, record, sizeof(record));
+    pushRecord(record, length);
+}
+
+// Description: Adds a raw ADC burst to the pass being collected, called by the acquisition task before filtering
+// Parameters: pin, samples in mV, sample count
+// Return: none
+void captureBurst(uint8_t pin, const int *samples, int count)
+{
+    if (!RAW_SENSOR_CAPTURE || pass.burstCount >= SENSOR_PASS_MAX_BURSTS)
+    {
+        return;
+    }
+    SensorBurst &burst = pass.bursts[pass.burstCount++];
+    burst.pin = pin;
+    burst.count = count < SENSOR_BURST_MAX_SAMPLES ? count : SENSOR_BURST_MAX_SAMPLES;
+    for (uint8_t i = 0; i < burst.count; i++)
+    {
+        burst.samples[i] = samples[i] < 0 ? 0 : samples[i];
+    }
+}
+
+// Description: Closes the pass and queues it with what the glove made of it
+// Parameters: acquisition phase, finger values computed from the pass(NULL during calibration), raw joystick,
+//             DataBroker button bits
+// Return: none
+void captureEndPass(SensorPhase phase, const int *fingerAngles, float joystickX, float joystickY, uint32_t buttonsBitmask)
+{
+    if (!RAW_SENSOR_CAPTURE)
+    {
+        return;
+    }
+    pass.timeUs = micros();
+    pass.phase = phase;
+    pass.joystickXY[0] = (uint16_t)joystickX;
+    pass.joystickXY[1] = (uint16_t)joystickY;
+    pass.buttonsBitmask = buttonsBitmask;
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        pass.fingerAngles[i] = fingerAngles != NULL ? fingerAngles[i] : 0;
+    }
+
+    static uint8_t record[SENSOR_RECORD_MAX_BYTES];
+    size_t length = encodeSensorPass(pass, record, sizeof(record));
+    pushRecord(record, length);
+    pass.sequence++;
+    pass.burstCount = 0;
+
+    if (phase == SENSOR_PHASE_RUN && haveCalibration && ++runPasses % CALIBRATION_REPEAT_PASSES == 0)
+    {
+        pushCalibration();
+    }
+}
+
+// Description: Records the calibration the acquisition task runs with, queued now and repeated every few seconds
+// Parameters: open and closed readings of the five flex sensors
+// Return: none
+void captureCalibration(const long long openValues[5], const long long closedValues[5])
+{
+    if (!RAW_SENSOR_CAPTURE)
+    {
+        return;
+    }
+    calibration.pollMethod = POLL_METHOD;
+    calibration.calibrationMethod = CALIBRATION_METHOD;
+    calibration.sampleRate = POT_SAMPLE_RATE;
+    calibration.flags = SIMULATION ? SENSOR_FLAG_SIMULATION : 0;
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        calibration.openValues[i] = (int32_t)openValues[i];
+        calibration.closedValues[i] = (int32_t)closedValues[i];
+    }
+    haveCalibration = true;
+    pushCalibration();
+}
+
+// Description: Drains the capture ring to the USB Serial every 10 ms
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskSensorCapture(void *pvParameters)
+{
+    // To not get compiler unused variable error
+    (void)pvParameters;
+
+    for (;;)
+    {
+        markTaskLoop();
+
+        uint32_t tail = ringTail.load(std::memory_order_relaxed);
+        uint32_t head = ringHead.load(std::memory_order_acquire);
+        while (tail != head)
+        {
+            // Up to the end of the ring, then the part that wrapped
+            uint32_t start = tail & (CAPTURE_RING_BYTES - 1);
+            uint32_t length = head - tail < CAPTURE_RING_BYTES - start ? head - tail : CAPTURE_RING_BYTES - start;
+            Serial.write(ring + start, length);
+            tail += length;
+            ringTail.store(tail, std::memory_order_release);
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <HardwareSerial.h>
+#include "config.h"
+#include "TaskTable.h"
+#include "SensorRecording.h"
+
+// Raw sensor capture(RAW_SENSOR_CAPTURE in config.h): the acquisition task hands every raw ADC burst to
+// captureBurst() and closes each pass with captureEndPass(), the pass is framed(SensorRecording.h) into a
+// RAW_CAPTURE_BUFFER_BYTES ring that TaskSensorCapture drains to the USB Serial. The acquisition task never waits
+// on the link, a pass that doesn't fit the ring is dropped and shows as a sequence gap.
+
+void captureBurst(uint8_t pin, const int *samples, int count);
+void captureEndPass(SensorPhase phase, const int *fingerAngles, float joystickX, float joystickY, uint32_t buttonsBitmask);
+void captureCalibration(const long long openValues[5], const long long closedValues[5]);
+void TaskSensorCapture(void *pvParameters);
@@ -0,0 +1,143 @@
+#pragma once
+#include <stdint.h>
+#include <limits.h>
+#include <algorithm>
+
+// Flex sensor filtering, calibration and mapping to OpenGloves finger values.
+// The acquisition task reads the ADC and hands the samples to these, so the same code runs on the host.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// Description: Reduces one burst of ADC samples to a single reading(see POLL_METHOD in config.h)
+// Parameters: samples in mV(reordered in place), sample count, noise reduction method
+//             0-> first sample, 1-> average, 2-> median, 3-> trimmed mean
+// Return: filtered reading in mV
+inline int filterSamples(int *samples, int count, int method)
+{
+    switch (method)
+    {
+    case 1:
+    {
+        //--Basic Average
+        long long sum = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sum += samples[i];
+        }
+        return sum / count;
+    }
+    case 2:
+    {
+        //--Median filter
+
+        // Get middle index(round down to middle value if even)
+        int n = count / 2;
+
+        // Sort array to only have that value sorted
+        // Makes values to the left less than median and values to the right greater(still not ordered)
+        std::nth_element(samples, samples + n, samples + count);
+
+        int median = samples[n];
+
+        // If even, average two elements that would be in the mean
+        if (!(count & 1))
+        {
+            int *max_it = std::max_element(samples, samples + n);
+            median = (*max_it + median) / 2;
+        }
+
+        return median;
+    }
+    case 3:
+    {
+        // --Trimmed mean filter
+        std::sort(samples, samples + count);
+
+        // Remove top and bottom 25% of readings to avoid outliers
+        long long sum = 0;
+        int trimIndexStart = count / 4;
+        int trimIndexEnd = count - trimIndexStart;
+        for (int i = trimIndexStart; i < trimIndexEnd; i++)
+        {
+            sum += samples[i];
+        }
+        return sum / (trimIndexEnd - trimIndexStart);
+    }
+    default:
+        return samples[0];
+    }
+}
+
+// Open and closed readings of one flex sensor, collected during the calibration phase
+// (see CALIBRATION_METHOD in config.h)
+class FlexCalibrator
+{
+public:
+    // Description: Starts a new calibration
+    // Parameters: 0-> average of each phase, 1-> most extreme value of each phase
+    // Return: none
+    void begin(int method)
+    {
+        method_ = method;
+        openSum_ = closedSum_ = 0;
+        openCount_ = closedCount_ = 0;
+        openExtreme_ = LLONG_MIN;
+        closedExtreme_ = LLONG_MAX;
+    }
+
+    // Description: Takes a reading from the open hand phase
+    // Parameters: filtered reading in mV
+    // Return: none
+    void addOpen(int reading)
+    {
+        openSum_ += reading;
+        openCount_++;
+        openExtreme_ = reading > openExtreme_ ? reading : openExtreme_;
+    }
+
+    // Description: Takes a reading from the closed hand phase
+    // Parameters: filtered reading in mV
+    // Return: none
+    void addClosed(int reading)
+    {
+        closedSum_ += reading;
+        closedCount_++;
+        closedExtreme_ = reading < closedExtreme_ ? reading : closedExtreme_;
+    }
+
+    // Description: Reading of the open hand
+    // Parameters: none
+    // Return: average or highest open reading
+    long long openValue() const
+    {
+        return method_ == 0 ? (openCount_ ? openSum_ / openCount_ : 0) : openExtreme_;
+    }
+
+    // Description: Reading of the closed hand
+    // Parameters: none
+    // Return: average or lowest closed reading
+    long long closedValue() const
+    {
+        return method_ == 0 ? (closedCount_ ? closedSum_ / closedCount_ : 0) : closedExtreme_;
+    }
+
+private:
+    int method_ = 1;
+    long long openSum_ = 0;
+    long long closedSum_ = 0;
+    long long openCount_ = 0;
+    long long closedCount_ = 0;
+    long long openExtreme_ = LLONG_MIN;
+    long long closedExtreme_ = LLONG_MAX;
+};
+
+// Description: Maps a flex reading onto the OpenGloves finger range with the calibration's end points
+// Same integer math as Arduino's map() and constrain(), a degenerate range maps to 0
+// Parameters: filtered reading in mV, closed and open calibration readings, flip so open is 0
+// Return: finger value from 0-4095
+inline int flexToFinger(int reading, long long closedValue, long long openValue, bool invert)
+{
+    long long run = openValue - closedValue;
+    long long value = run != 0 ? ((reading - closedValue) * 4095) / run : -1;
+    value = value < 0 ? 0 : (value > 4095 ? 4095 : value);
+    return invert ? 4095 - (int)value : (int)value;
+}
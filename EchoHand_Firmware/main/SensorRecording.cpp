@@ -0,0 +1,234 @@
+#include "SensorRecording.h"
+#include "TelemetryCodec.h"
+
+// Little endian writers and readers over a record, advance the position they're given
+static void put16(uint8_t *&out, uint16_t value)
+{
+    *out++ = value & 0xFF;
+    *out++ = value >> 8;
+}
+
+static void put32(uint8_t *&out, uint32_t value)
+{
+    put16(out, value & 0xFFFF);
+    put16(out, value >> 16);
+}
+
+static uint16_t get16(const uint8_t *&in)
+{
+    uint16_t value = in[0] | in[1] << 8;
+    in += 2;
+    return value;
+}
+
+static uint32_t get32(const uint8_t *&in)
+{
+    uint32_t low = get16(in);
+    return low | (uint32_t)get16(in) << 16;
+}
+
+// Description: Bytes a burst's samples take packed two to three bytes
+// Parameters: sample count
+// Return: byte count
+static size_t packedBytes(uint8_t count)
+{
+    return (count * 3 + 1) / 2;
+}
+
+// Description: Encodes a pass as a record
+// Parameters: pass, output buffer and its size(SENSOR_RECORD_MAX_BYTES)
+// Return: record length, 0 if the pass doesn't fit the format or the buffer
+size_t encodeSensorPass(const SensorPass &pass, uint8_t *out, size_t size)
+{
+    if (size < SENSOR_RECORD_MAX_BYTES || pass.burstCount > SENSOR_PASS_MAX_BURSTS)
+    {
+        return 0;
+    }
+
+    uint8_t *p = out;
+    *p++ = SENSOR_RECORD_VERSION;
+    *p++ = SENSOR_RECORD_PASS;
+    put16(p, pass.sequence);
+    put32(p, pass.timeUs);
+    *p++ = pass.phase;
+    *p++ = pass.burstCount;
+    for (uint8_t b = 0; b < pass.burstCount; b++)
+    {
+        const SensorBurst &burst = pass.bursts[b];
+        if (burst.count > SENSOR_BURST_MAX_SAMPLES)
+        {
+            return 0;
+        }
+        *p++ = burst.pin;
+        *p++ = burst.count;
+
+        // Two 12 bit samples in three bytes, an odd last one in two
+        for (uint8_t i = 0; i < burst.count; i += 2)
+        {
+            uint16_t first = burst.samples[i] > 0xFFF ? 0xFFF : burst.samples[i];
+            uint16_t second = i + 1 < burst.count ? (burst.samples[i + 1] > 0xFFF ? 0xFFF : burst.samples[i + 1]) : 0;
+            *p++ = first & 0xFF;
+            *p++ = (first >> 8) | (second & 0xF) << 4;
+            if (i + 1 < burst.count)
+            {
+                *p++ = second >> 4;
+            }
+        }
+    }
+    put16(p, pass.joystickXY[0]);
+    put16(p, pass.joystickXY[1]);
+    *p++ = pass.buttonsBitmask;
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, pass.fingerAngles[i]);
+    }
+    return p - out;
+}
+
+// Description: Reads a pass record
+// Parameters: record and its length, pass to fill
+// Return: true if it is a complete pass record of this version
+bool decodeSensorPass(const uint8_t *record, size_t length, SensorPass &pass)
+{
+    if (length < 10 || record[0] != SENSOR_RECORD_VERSION || record[1] != SENSOR_RECORD_PASS)
+    {
+        return false;
+    }
+    const uint8_t *p = record + 2;
+    const uint8_t *end = record + length;
+    pass.sequence = get16(p);
+    pass.timeUs = get32(p);
+    pass.phase = *p++;
+    pass.burstCount = *p++;
+    if (pass.burstCount > SENSOR_PASS_MAX_BURSTS)
+    {
+        return false;
+    }
+    for (uint8_t b = 0; b < pass.burstCount; b++)
+    {
+        SensorBurst &burst = pass.bursts[b];
+        if (end - p < 2)
+        {
+            return false;
+        }
+        burst.pin = *p++;
+        burst.count = *p++;
+        if (burst.count > SENSOR_BURST_MAX_SAMPLES || (size_t)(end - p) < packedBytes(burst.count))
+        {
+            return false;
+        }
+        for (uint8_t i = 0; i < burst.count; i += 2)
+        {
+            burst.samples[i] = p[0] | (p[1] & 0xF) << 8;
+            if (i + 1 < burst.count)
+            {
+                burst.samples[i + 1] = p[1] >> 4 | p[2] << 4;
+                p++;
+            }
+            p += 2;
+        }
+    }
+    if (end - p != 15)
+    {
+        return false;
+    }
+    pass.joystickXY[0] = get16(p);
+    pass.joystickXY[1] = get16(p);
+    pass.buttonsBitmask = *p++;
+    for (int i = 0; i < 5; i++)
+    {
+        pass.fingerAngles[i] = get16(p);
+    }
+    return true;
+}
+
+// Description: Encodes the calibration as a record
+// Parameters: calibration, output buffer and its size
+// Return: record length, 0 if the buffer is too small
+size_t encodeSensorCalibration(const SensorCalibration &calibration, uint8_t *out, size_t size)
+{
+    if (size < SENSOR_CALIBRATION_BYTES)
+    {
+        return 0;
+    }
+    uint8_t *p = out;
+    *p++ = SENSOR_RECORD_VERSION;
+    *p++ = SENSOR_RECORD_CALIBRATION;
+    *p++ = calibration.pollMethod;
+    *p++ = calibration.calibrationMethod;
+    *p++ = calibration.sampleRate;
+    *p++ = calibration.flags;
+    for (int i = 0; i < 5; i++)
+    {
+        put32(p, (uint32_t)calibration.openValues[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put32(p, (uint32_t)calibration.closedValues[i]);
+    }
+    return p - out;
+}
+
+// Description: Reads a calibration record
+// Parameters: record and its length, calibration to fill
+// Return: true if it is a calibration record of this version
+bool decodeSensorCalibration(const uint8_t *record, size_t length, SensorCalibration &calibration)
+{
+    if (length != SENSOR_CALIBRATION_BYTES || record[0] != SENSOR_RECORD_VERSION || record[1] != SENSOR_RECORD_CALIBRATION)
+    {
+        return false;
+    }
+    const uint8_t *p = record + 2;
+    calibration.pollMethod = *p++;
+    calibration.calibrationMethod = *p++;
+    calibration.sampleRate = *p++;
+    calibration.flags = *p++;
+    for (int i = 0; i < 5; i++)
+    {
+        calibration.openValues[i] = (int32_t)get32(p);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        calibration.closedValues[i] = (int32_t)get32(p);
+    }
+    return true;
+}
+
+// Description: Builds the wire frame of a record: CRC-16 appended, COBS encoded, 0 delimiter
+// Parameters: record and its length, output buffer and its size(SENSOR_FRAME_MAX_BYTES)
+// Return: bytes to send including the delimiter, 0 if the buffer is too small
+size_t frameSensorRecord(const uint8_t *record, size_t length, uint8_t *out, size_t size)
+{
+    uint8_t payload[SENSOR_RECORD_MAX_BYTES + 2];
+    if (length > SENSOR_RECORD_MAX_BYTES || size < length + 2 + (length + 2) / 254 + 2)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        payload[i] = record[i];
+    }
+    uint8_t *p = payload + length;
+    put16(p, telemetryCrc16(record, length));
+    size_t framed = cobsEncode(payload, length + 2, out);
+    out[framed++] = 0;
+    return framed;
+}
+
+// Description: Reads a record back from one COBS block of the wire stream
+// Parameters: block without its 0 delimiter, its length, output with room for SENSOR_FRAME_MAX_BYTES bytes
+// Return: record length, 0 if the block is malformed or fails its CRC
+size_t unframeSensorRecord(const uint8_t *block, size_t length, uint8_t *record)
+{
+    if (length > SENSOR_FRAME_MAX_BYTES)
+    {
+        return 0;
+    }
+    size_t decoded = cobsDecode(block, length, record);
+    if (decoded < 4)
+    {
+        return 0;
+    }
+    const uint8_t *p = record + decoded - 2;
+    return get16(p) == telemetryCrc16(record, decoded - 2) ? decoded - 2 : 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Records of a raw sensor session(RAW_SENSOR_CAPTURE in config.h): every ADC burst the acquisition task read in one
+// pass before it was filtered, with the pass' time and what the glove made of it, plus the calibration the glove
+// used. The glove sends each record COBS framed with a CRC-16 like the telemetry(TelemetryCodec.h),
+// host/SensorRecorder stores the records in a chunked file and host/SensorReplay plays them back through the
+// host build of the filter, calibration and OpenGloves encoding.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// First byte of every record, changes with the layout
+#define SENSOR_RECORD_VERSION 0xA1
+
+// Second byte, kind of record
+#define SENSOR_RECORD_PASS 'P'
+#define SENSOR_RECORD_CALIBRATION 'C'
+
+// Most bursts in one pass(five flex sensors and five servo feedback pots) and samples in one burst
+#define SENSOR_PASS_MAX_BURSTS 10
+#define SENSOR_BURST_MAX_SAMPLES 32
+
+// Longest record, length of a calibration record and the longest frame on the wire(COBS adds a byte per 254 plus
+// the code and the 0 delimiter)
+#define SENSOR_RECORD_MAX_BYTES (10 + SENSOR_PASS_MAX_BURSTS * (2 + SENSOR_BURST_MAX_SAMPLES * 3 / 2) + 15)
+#define SENSOR_CALIBRATION_BYTES 46
+#define SENSOR_FRAME_MAX_BYTES (SENSOR_RECORD_MAX_BYTES + 2 + (SENSOR_RECORD_MAX_BYTES + 2) / 254 + 2)
+
+// Bits of SensorCalibration::flags
+#define SENSOR_FLAG_SIMULATION 0x01 // calibration was skipped(SIMULATION in config.h)
+
+// Acquisition phase a pass was read in
+enum SensorPhase : uint8_t
+{
+    SENSOR_PHASE_OPEN = 0, // first calibration phase, hand open
+    SENSOR_PHASE_CLOSED,   // second calibration phase, hand closed
+    SENSOR_PHASE_RUN       // normal sampling
+};
+
+// One readSmooth() burst, samples in mV as the ADC returned them(12 bits on the wire, the ADC tops out at ~3.1 V)
+struct SensorBurst
+{
+    uint8_t pin;
+    uint8_t count;
+    uint16_t samples[SENSOR_BURST_MAX_SAMPLES];
+};
+
+// One acquisition pass
+struct SensorPass
+{
+    uint16_t sequence;        // counts passes, gaps are passes dropped on the glove or the link
+    uint32_t timeUs;          // micros() at the end of the pass
+    uint8_t phase;            // SensorPhase
+    uint8_t burstCount;       // bursts in read order
+    SensorBurst bursts[SENSOR_PASS_MAX_BURSTS];
+    uint16_t joystickXY[2];   // raw analogRead() values
+    uint8_t buttonsBitmask;   // DataBroker button bits the glove set, trigger included
+    uint16_t fingerAngles[5]; // finger values the glove computed from the pass(run passes only)
+};
+
+// Settings and end points of the calibration the glove runs with
+struct SensorCalibration
+{
+    uint8_t pollMethod;        // POLL_METHOD
+    uint8_t calibrationMethod; // CALIBRATION_METHOD
+    uint8_t sampleRate;        // POT_SAMPLE_RATE
+    uint8_t flags;             // SENSOR_FLAG_ bits
+    int32_t openValues[5];
+    int32_t closedValues[5];
+};
+
+size_t encodeSensorPass(const SensorPass &pass, uint8_t *out, size_t size);
+bool decodeSensorPass(const uint8_t *record, size_t length, SensorPass &pass);
+size_t encodeSensorCalibration(const SensorCalibration &calibration, uint8_t *out, size_t size);
+bool decodeSensorCalibration(const uint8_t *record, size_t length, SensorCalibration &calibration);
+size_t frameSensorRecord(const uint8_t *record, size_t length, uint8_t *out, size_t size);
+size_t unframeSensorRecord(const uint8_t *block, size_t length, uint8_t *record);
@@ -0,0 +1,116 @@
+#include "SerialTransport.h"
+
+SerialTransport::SerialTransport(uart_port_t port, int txPin, int rxPin, int baudRate, int keyPin)
+    : port_(port), txPin_(txPin), rxPin_(rxPin), baudRate_(baudRate), keyPin_(keyPin)
+{
+}
+
+// Description: Installs the UART driver, taking UART0 over from Arduino's Serial if needed
+// Parameters: none
+// Return: true if the link is up
+bool SerialTransport::begin()
+{
+    if (keyPin_ >= 0)
+    {
+        // Set KEY pin to off for non at mode
+        pinMode(keyPin_, OUTPUT);
+        digitalWrite(keyPin_, LOW);
+
+        // Print to usb that we are starting bluetooth serial
+        Serial.println("Starting Bluetooth Serial on another COM port...");
+    }
+
+    if (port_ == UART_NUM_0)
+    {
+        // Arduino's Serial owns UART0 while debug prints or the raw sensor capture are on
+        if (DEBUG_PRINT || RAW_SENSOR_CAPTURE)
+        {
+            return false;
+        }
+
+        // Take UART0 over from Arduino's Serial, debug prints are off in this mode anyway
+        Serial.flush();
+        Serial.end();
+    }
+
+    if (!link_.begin(port_, baudRate_, txPin_, rxPin_))
+    {
+        Serial.println("Failed to start UART driver");
+        return false;
+    }
+
+    if (keyPin_ >= 0)
+    {
+        // Time to config
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+
+    // set finger splay and leave it
+    const char splay[] = "(AB)511(BB)511(CB)511(DB)511(EB)511\n";
+    link_.write(splay, sizeof(splay) - 1);
+    return true;
+}
+
+// Description: Queues one line in the driver's TX ring buffer
+// Parameters: '\n' terminated line and its length
+// Return: always true, a short write is counted as a send error
+bool SerialTransport::send(const char *line, size_t length)
+{
+    // Send the constructed string as one STRING(SUPER SUPER IMPORTANT for bluetooth serial)
+    if (link_.write(line, length) != length)
+    {
+        stats.sendErrors++;
+    }
+    return true;
+}
+
+// Description: Passes AT commands typed on the USB Serial through to the HC-05, never returns
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskBluetoothSetup(void *pvParameters)
+{
+    // uses parameter to avoid compiler error
+    (void)pvParameters;
+
+    // Set pin for KEY pin on bluetooth serial module, on for at mode
+    pinMode(BLUETOOTH_KEY, OUTPUT);
+    digitalWrite(BLUETOOTH_KEY, HIGH);
+
+    // Set Bluetooth module up
+    Serial.println("Setting up bluetooth module, power cycle device and disable BLUETOOTH_SETUP to continue...");
+
+    Serial1.begin(38400, SERIAL_8N1, BLUETOOTH_RX, BLUETOOTH_TX);
+    Serial1.println("AT+UART=115200,0,0");
+
+    char buffer[100];
+    size_t n = Serial1.readBytesUntil('\n', buffer, sizeof(buffer) - 1);
+    buffer[n] = '\0';
+
+    Serial.print("BT response: ");
+    Serial.println(buffer);
+
+    while (true)
+    {
+        if (Serial.available())
+        {
+            Serial1.println(Serial.readStringUntil('\n'));
+            size_t n = Serial1.readBytesUntil('\n', buffer, sizeof(buffer) - 1);
+            buffer[n] = '\0';
+            Serial.print("BT response: ");
+            Serial.println(buffer);
+        }
+    }
+}
+
+// Description: Runs the UART loopback benchmark once and deletes itself
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskUartLoopbackTest(void *pvParameters)
+{
+    // uses parameter to avoid compiler error
+    (void)pvParameters;
+
+    // Borrow the bluetooth UART with internal loopback, results go out on the USB Serial
+    runUartLoopbackBenchmark(UART_NUM_1, BLUETOOTH_TX, BLUETOOTH_RX);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <HardwareSerial.h>
+#include "config.h"
+#include "UartLink.h"
+#include "Transport.h"
+
+#define START_BYTE 0x06
+#define END_BYTE 0x07
+
+// Wired or HC-05 serial link on one UART, lines go out and come in as plain OpenGloves text
+class SerialTransport
+{
+public:
+    static constexpr bool includeJoystick = true;
+
+    SerialTransport(uart_port_t port, int txPin, int rxPin, int baudRate, int keyPin = -1);
+
+    bool begin();
+    bool receiveLine(char *buffer, size_t size, size_t &length) { return link_.readLine(buffer, size, length); }
+    bool readyToSend(uint32_t nowUs) { return true; }
+    bool send(const char *line, size_t length);
+    void idle() {}
+
+    TransportStats stats{};
+
+private:
+    // Line based UART link, reads never wait on a partial line so sending keeps going
+    UartLink link_;
+    uart_port_t port_;
+    int txPin_;
+    int rxPin_;
+    int baudRate_;
+    int keyPin_;
+};
+
+void TaskBluetoothSetup(void *pvParameters);
+void TaskUartLoopbackTest(void *pvParameters);
@@ -1,83 +1,295 @@
 #include "ServoControl_task.h"
 
+// Per servo change detection, owned by the servo task and read by the debug print
+static ServoWriteFilter writeFilters[5];
+
+// Angle each servo is being driven to in target space, read by the acquisition task's force estimate
+static volatile float commandedAngles[5] = {0, 0, 0, 0, 0};
+
+// Description: Angle the servo task is currently commanding
+// Parameters: finger index(thumb to pinkie)
+// Return: angle in target space(0 = relaxed)
+float getServoCommandedAngle(uint8_t index)
+{
+    return index < 5 ? commandedAngles[index] : 0.0f;
+}
+
+// Description: Copies how many servo writes went through and how many were skipped
+// Parameters: arrays of five to fill in(thumb to pinkie)
+// Return: none
+void getServoWriteStats(uint32_t writes[5], uint32_t skipped[5])
+{
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        writes[i] = writeFilters[i].writes();
+        skipped[i] = writeFilters[i].skipped();
+    }
+}
+
+// Description: Writes an angle to one servo unless the output wouldn't change
+// Parameters: servo, its index, angle in degrees, resting true if the servo will stay there
+// Return: none
+static void writeServo(Servo &servo, uint8_t index, int angle, bool resting)
+{
+    if (writeFilters[index].shouldWrite(angle, resting))
+    {
+        TRACE_BEGIN(TRACE_SERVO_WRITE, index << 8 | (angle & 0xFF));
+        servo.writeAngleFast(angle);
+        TRACE_END(TRACE_SERVO_WRITE, index << 8 | (angle & 0xFF));
+    }
+}
+
+// Description: Extrapolates a finger's curl to when a spool sent there now would arrive
+// Parameters: finger index(thumb to pinkie)
+// Return: predicted curl from 0.0(open)-1.0(closed)
+static float predictFingerCurl(uint8_t index)
+{
+    float curl = DataBroker::instance().getFingerAngle(index) / 4095.0f;
+    float velocity = DataBroker::instance().getFingerVelocity(index) / 4095.0f;
+    float predicted = curl + velocity * (FFB_PREDICT_LEAD_MS / 1000.0f);
+    return predicted < 0 ? 0 : (predicted > 1 ? 1 : predicted);
+}
+
+// Description: Stores a parsed FFB command in the persistant state and wakes the servo task
+// Parameters: command parsed by any transport
+// Return: none
+void applyHapticCommand(const OpenGlovesCommand &command)
+{
+    // Apply servo angles to persistent state
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        if (command.hasServo[i])
+        {
+            DataBroker::instance().setServoTargetAngle(i, command.servoTargetAngles[i]);
+        }
+    }
+
+    // Set all motors to the value expected (in RPM)
+    if (command.hasVibration)
+    {
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            DataBroker::instance().setVibrationRPM(i, command.vibrationRPM);
+        }
+
+        // Start the pulse right away instead of waiting for the next envelope step
+        if (xVibrationTaskHandle != NULL)
+        {
+            xTaskNotifyGive(xVibrationTaskHandle);
+        }
+    }
+
+    // Once last servo has been processed(E, wakeup thread instantly to update value)
+    if (command.hasServo[4] && xServoTaskHandle != NULL)
+    {
+        xTaskNotifyGive(xServoTaskHandle);
+    }
+}
+
+// Description: Times one five servo update through each write path and prints the cost
+// Parameters: the five attached servos
+// Return: none
+void runServoWriteBenchmark(Servo servos[5])
+{
+    const int iterations = 2000;
+    const char *names[] = {"write()", "writeMicroseconds()", "writeAngleFast()"};
+
+    for (int path = 0; path < 3; path++)
+    {
+        uint32_t total = 0;
+        uint32_t best = UINT32_MAX;
+        for (int n = 0; n < iterations; n++)
+        {
+            // Sweep so every call is a real change
+            int angle = n % 181;
+            uint32_t start = esp_cpu_get_cycle_count();
+            for (uint8_t i = 0; i < 5; i++)
+            {
+                if (path == 0)
+                    servos[i].write(angle);
+                else if (path == 1)
+                    servos[i].writeMicroseconds(DEFAULT_uS_LOW + ((DEFAULT_uS_HIGH - DEFAULT_uS_LOW) * angle) / 180);
+                else
+                    servos[i].writeAngleFast(angle);
+            }
+            uint32_t cycles = esp_cpu_get_cycle_count() - start;
+            total += cycles;
+            best = cycles < best ? cycles : best;
+        }
+
+        uint32_t mean = total / iterations;
+        Serial.printf("Servo benchmark %-20s five servos: mean %lu cycles (%lu us), best %lu cycles\n",
+                      names[path], (unsigned long)mean, (unsigned long)(mean / getCpuFrequencyMhz()), (unsigned long)best);
+    }
+}
+
 // Description: Commands all haptic spools
 // Parameters: pvParameters which is a place holder for any pointer to any type
 // Return: none, it will simply pass the information on to the next core for processing
 void TaskServoControl(void *pvParameters)
 {
-
-    // Set pin modes
-    pinMode(THUMB_SERVO, OUTPUT);
-    pinMode(INDEX_SERVO, OUTPUT);
-    pinMode(MIDDLE_SERVO, OUTPUT);
-    pinMode(RING_SERVO, OUTPUT);
-    pinMode(PINKIE_SERVO, OUTPUT);
-
-    // Setup servo objects
-    Servo thumbServo;
-    Servo indexServo;
-    Servo middleServo;
-    Servo ringServo;
-    Servo pinkieServo;
-
-    thumbServo.attach(THUMB_SERVO);
-    indexServo.attach(INDEX_SERVO);
-    middleServo.attach(MIDDLE_SERVO);
-    ringServo.attach(RING_SERVO);
-    pinkieServo.attach(PINKIE_SERVO);
-
     // To not get compiler unused variable error
     (void)pvParameters;
 
-    // Reset all servo angles to 0 so user can use glove
-    // Get servo angle from openhaptics
-    thumbServo.write(180);
-    indexServo.write(180);
-    middleServo.write(180);
-    ringServo.write(180);
-    pinkieServo.write(180);
+    // Servo pins in finger order(thumb, index, middle, ring, pinkie)
+    const uint8_t servoPins[5] = {THUMB_SERVO, INDEX_SERVO, MIDDLE_SERVO, RING_SERVO, PINKIE_SERVO};
 
-    // Fetch analog data from sensors forever
-    for (;;)
+    // Setup servo objects and their motion profiles
+    Servo servos[5];
+    ServoMotionProfile profiles[5];
+    ServoIdlePolicy idlePolicies[5];
+    ServoForcePid forcePids[5];
+    bool forceActive[5] = {false, false, false, false, false};
+    FingerStopLimit stopLimits[5];
+
+    for (uint8_t i = 0; i < 5; i++)
     {
-        // Wait until all servo values have been updates from the communcation task
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // Set pin modes
+        // Width before attach, so the channel is set up once and its tick table built once at that width
+        pinMode(servoPins[i], OUTPUT);
+        servos[i].setTimerWidth(SERVO_TIMER_WIDTH);
+        servos[i].attach(servoPins[i]);
 
-        // Get servo angle from openhaptics
-        int thumbAngle = DataBroker::instance().getServoTargetAngle(0);
-        int indexAngle = DataBroker::instance().getServoTargetAngle(1);
-        int middleAngle = DataBroker::instance().getServoTargetAngle(2);
-        int ringAngle = DataBroker::instance().getServoTargetAngle(3);
-        int pinkieAngle = DataBroker::instance().getServoTargetAngle(4);
-
-        /*
-        if (thumbAngle <= SERVO_DEADZONE)
+        // Reset all servo angles to 0 so user can use glove
+        writeFilters[i].setDeadband(SERVO_WRITE_DEADBAND);
+        writeServo(servos[i], i, 180, true);
+        profiles[i].reset(0);
+        profiles[i].setLimits({SERVO_MAX_VELOCITY[i], SERVO_MAX_ACCELERATION[i]});
+        idlePolicies[i].setReleaseDelayMs(SERVO_IDLE_RELEASE_MS);
+        forcePids[i].setGains({SERVO_FORCE_KP, SERVO_FORCE_KI, SERVO_FORCE_KD});
+        stopLimits[i].setHysteresis(FFB_STOP_HYSTERESIS);
+        stopLimits[i].setCorrectionGain(FFB_STOP_CORRECTION_GAIN);
+    }
+
+    if (SERVO_WRITE_BENCHMARK)
+    {
+        runServoWriteBenchmark(servos);
+        for (uint8_t i = 0; i < 5; i++)
         {
-            thumbAngle = 0;
+            writeFilters[i].reset();
+            writeServo(servos[i], i, 180, true);
         }
-        if (indexAngle <= SERVO_DEADZONE)
+    }
+
+    const TickType_t period = pdMS_TO_TICKS(1000 / SERVO_CONTROL_HZ);
+    const uint32_t periodUs = 1000000 / SERVO_CONTROL_HZ;
+    TickType_t lastWake = xTaskGetTickCount();
+    TickType_t idleWait = portMAX_DELAY;
+    bool moving = false;
+    float targets[5] = {0, 0, 0, 0, 0};
+    float setpoints[5] = {0, 0, 0, 0, 0};
+
+    // Fetch analog data from sensors forever
+    for (;;)
+    {
+        bool newTargets;
+        if (!moving)
         {
-            indexAngle = 0;
+            // Nothing left to move, sleep until the communcation task has new servo values,
+            // the acquisition task has a new finger sample or the next finger is due to be released
+            newTargets = ulTaskNotifyTake(pdTRUE, idleWait) > 0;
+            lastWake = xTaskGetTickCount();
+            restartTaskLoop();
         }
-        if (middleAngle <= SERVO_DEADZONE)
+        else
         {
-            middleAngle = 0;
+            // Fixed control rate while a spool is still moving or tracking a force, pick up new targets without waiting
+            xTaskDelayUntil(&lastWake, period);
+            markTaskLoop();
+            newTargets = ulTaskNotifyTake(pdTRUE, 0) > 0;
         }
-        if (ringAngle <= SERVO_DEADZONE)
+
+        // Get servo angle from openhaptics
+        for (uint8_t i = 0; newTargets && i < 5; i++)
         {
-            ringAngle = 0;
+            targets[i] = DataBroker::instance().getServoTargetAngle(i);
+            if (targets[i] <= SERVO_DEADZONE)
+            {
+                targets[i] = 0;
+            }
+
+            // Pre-positioned spools shadow the finger near the target and only stop on it, no target leaves them at 0
+            setpoints[i] = targets[i];
+            if (FFB_TARGET_MODE == 1)
+            {
+                setpoints[i] = prePositionAngle(targets[i], predictFingerCurl(i), FFB_PREPOSITION_SLACK, FFB_PREPOSITION_REACH);
+            }
+            else if (FFB_TARGET_MODE == 2)
+            {
+                // Target is a stop curl, enforced here on every finger sample without waiting for the PC
+                stopLimits[i].setStop(targets[i] > 0 ? 1.0f - targets[i] / 180.0f : 1.0f);
+                float holdAngle = stopLimits[i].update(DataBroker::instance().getFingerAngle(i) / 4095.0f, micros());
+                setpoints[i] = prePositionAngle(holdAngle, predictFingerCurl(i), FFB_PREPOSITION_SLACK, FFB_PREPOSITION_REACH);
+            }
+
+            if (SERVO_MOTION_PROFILE)
+            {
+                profiles[i].setTarget(setpoints[i], micros());
+            }
         }
-        if (pinkieAngle <= SERVO_DEADZONE)
+
+        // Step every profile(or take the target as is) and command servos, only the ones whose output changes
+        moving = false;
+        uint32_t nowMs = millis();
+        uint32_t nextReleaseMs = UINT32_MAX;
+        for (uint8_t i = 0; i < 5; i++)
         {
-            pinkieAngle = 0;
+            float command = setpoints[i];
+            bool settled = true;
+
+            // Force feedback fingers treat the target as a force and let the PID pick the spool angle
+            bool forceControl = SERVO_FORCE_FEEDBACK && SERVO_FEEDBACK_PINS[i] != SERVO_FEEDBACK_NOT_FITTED && targets[i] > 0;
+            if (forceControl)
+            {
+                if (!forceActive[i])
+                {
+                    forcePids[i].reset(SERVO_MOTION_PROFILE ? profiles[i].position() : commandedAngles[i]);
+                    forceActive[i] = true;
+                }
+                command = forcePids[i].update(targets[i] / 180.0f, DataBroker::instance().getServoForce(i), periodUs);
+                if (SERVO_MOTION_PROFILE)
+                {
+                    profiles[i].setTarget(command, micros());
+                }
+                settled = false;
+                moving = true;
+            }
+            forceActive[i] = forceControl;
+
+            int angle = 180 - (int)command;
+            if (SERVO_MOTION_PROFILE)
+            {
+                angle = 180 - (int)lroundf(profiles[i].update(periodUs));
+                settled = settled && profiles[i].settled();
+                moving = moving || !settled;
+            }
+            commandedAngles[i] = 180 - angle;
+
+            if (SERVO_IDLE_RELEASE)
+            {
+                // Stop the pulses on fingers that have been relaxed for a while, drive them again on force
+                ServoIdleAction action = idlePolicies[i].update(nowMs, setpoints[i] > 0, settled);
+                if (action == SERVO_ACTION_RELEASE)
+                {
+                    servos[i].release();
+                }
+                else if (action == SERVO_ACTION_ENGAGE)
+                {
+                    writeFilters[i].reset();
+                }
+
+                uint32_t untilRelease = idlePolicies[i].msUntilRelease(nowMs);
+                nextReleaseMs = untilRelease < nextReleaseMs ? untilRelease : nextReleaseMs;
+                if (!idlePolicies[i].engaged())
+                {
+                    continue;
+                }
+            }
+
+            writeServo(servos[i], i, angle, settled);
         }
-        */
-
-        // Command servos
-        thumbServo.write(180 - thumbAngle);
-        indexServo.write(180 - indexAngle);
-        middleServo.write(180 - middleAngle);
-        ringServo.write(180 - ringAngle);
-        pinkieServo.write(180 - pinkieAngle);
+
+        // Wake up in time for the next release even if no new targets arrive
+        idleWait = nextReleaseMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(nextReleaseMs) + 1;
     }
-}
\ No newline at end of file
+}
@@ -10,6 +10,19 @@
 #include <string>
 #include "config.h"
 #include "DataBroker.h"
+#include "TaskTable.h"
+#include "OpenGlovesCodec.h"
+#include "ServoMotionProfile.h"
+#include "ServoWriteFilter.h"
+#include "ServoIdlePolicy.h"
+#include "ServoForceControl.h"
+#include "FingerPrediction.h"
+#include "TraceRing.h"
 #include <ESP32Servo.h>
+#include <esp_cpu.h>
 
+void applyHapticCommand(const OpenGlovesCommand &command);
+void runServoWriteBenchmark(Servo servos[5]);
+void getServoWriteStats(uint32_t writes[5], uint32_t skipped[5]);
+float getServoCommandedAngle(uint8_t index);
 void TaskServoControl(void *pvParameters);
@@ -0,0 +1,111 @@
+#pragma once
+#include <stdint.h>
+
+// Closed loop force control for the haptic spools from the servos' own position feedback.
+// A hobby servo pushes back in proportion to how far it is held off its commanded angle, so the gap
+// between the commanded angle and the angle read from the servo pot is an estimate of the string
+// tension, saturating once the servo stalls. Angles are in FFB target space(0 = relaxed, 180 = blocked).
+// No Arduino/FreeRTOS dependencies so host tools(host/SpoolForceSimulation.cpp) can run the same code.
+
+// Feedback pot calibration of one servo
+struct ServoFeedbackCalibration
+{
+    float mvAt0;           // pot voltage with the servo horn at 0 degrees
+    float mvAt180;         // pot voltage with the servo horn at 180 degrees
+    float stallDeflection; // degrees the servo is held off its command when it stalls
+    float filterAlpha;     // low pass weight of each new sample(1 -> no filtering)
+};
+
+// Force estimate for one finger, fed by the acquisition task
+class ServoForceEstimator
+{
+public:
+    // Description: Sets the pot calibration and stall deflection
+    // Parameters: calibration of this servo
+    // Return: none
+    void setCalibration(const ServoFeedbackCalibration &calibration) { calibration_ = calibration; }
+
+    // Description: Takes a pot reading and updates the force estimate
+    // Parameters: pot voltage in mV, angle the servo task is commanding in target space
+    // Return: force from 0.0(no tension) to 1.0(servo stalled)
+    float update(float measuredMv, float commandedAngle)
+    {
+        float horn = (measuredMv - calibration_.mvAt0) * 180.0f / (calibration_.mvAt180 - calibration_.mvAt0);
+        angle_ = 180.0f - horn;
+
+        // The finger can only pull the spool towards relaxed, a spool ahead of its command is still travelling
+        float deflection = commandedAngle - angle_;
+        float sample = deflection / calibration_.stallDeflection;
+        sample = sample < 0 ? 0 : (sample > 1 ? 1 : sample);
+        force_ += calibration_.filterAlpha * (sample - force_);
+        return force_;
+    }
+
+    float angle() const { return angle_; }
+    float force() const { return force_; }
+
+private:
+    ServoFeedbackCalibration calibration_ = {300.0f, 2700.0f, 10.0f, 0.5f};
+    float angle_ = 0;
+    float force_ = 0;
+};
+
+// PID gains of the force loop
+struct ServoForceGains
+{
+    float kp; // degrees per unit of force error
+    float ki; // degrees per second per unit of force error
+    float kd; // degrees per unit of force change per second
+};
+
+// Per finger force PID, moves the commanded spool angle until the estimated force reaches the target
+class ServoForcePid
+{
+public:
+    // Description: Sets the loop gains
+    // Parameters: PID gains
+    // Return: none
+    void setGains(const ServoForceGains &gains) { gains_ = gains; }
+
+    // Description: Starts the loop from the angle the spool is at so the command doesn't jump
+    // Parameters: current spool angle in target space
+    // Return: none
+    void reset(float angle)
+    {
+        integral_ = clamp(angle);
+        lastMeasured_ = 0;
+        hasMeasured_ = false;
+        output_ = integral_;
+    }
+
+    // Description: Advances the loop by one control period
+    // Parameters: target and estimated force(0.0-1.0), control period in microseconds
+    // Return: spool angle to command in target space
+    float update(float targetForce, float measuredForce, uint32_t dtUs)
+    {
+        float dt = dtUs * 1e-6f;
+        float error = targetForce - measuredForce;
+
+        // Clamping the integral to the servo range keeps it from winding up against a stalled finger
+        integral_ = clamp(integral_ + gains_.ki * error * dt);
+
+        // Derivative on the measurement so a new force target doesn't kick the spool
+        float derivative = hasMeasured_ ? (measuredForce - lastMeasured_) / dt : 0;
+        lastMeasured_ = measuredForce;
+        hasMeasured_ = true;
+
+        output_ = clamp(integral_ + gains_.kp * error - gains_.kd * derivative);
+        return output_;
+    }
+
+    float output() const { return output_; }
+
+private:
+    static float clamp(float angle) { return angle < 0 ? 0 : (angle > 180 ? 180 : angle); }
+
+    ServoForceGains gains_ = {10.0f, 800.0f, 0.0f};
+    float integral_ = 0;
+    float lastMeasured_ = 0;
+    bool hasMeasured_ = false;
+    float output_ = 0;
+};
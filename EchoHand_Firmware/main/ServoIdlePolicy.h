@@ -0,0 +1,89 @@
+#pragma once
+#include <stdint.h>
+
+// What the servo task should do with a finger's PWM after an update
+enum ServoIdleAction
+{
+    SERVO_ACTION_NONE,    // keep doing what it does
+    SERVO_ACTION_RELEASE, // stop the pulses, the finger has been relaxed long enough
+    SERVO_ACTION_ENGAGE   // force was requested on a released finger, drive it again right away
+};
+
+// Idle release policy for one finger.
+// With FFB relaxed the servo sits at its end stop but a 50Hz pulse still makes it actively hold there,
+// so once a finger has been relaxed and at rest for the release delay its pulses are stopped.
+// The LEDC channel stays attached while released, so re-engaging is a single duty write.
+// No Arduino/FreeRTOS dependencies so host tools(host/ServoEnergyModel.cpp) can run the same code.
+class ServoIdlePolicy
+{
+public:
+    // Description: Sets how long a finger has to stay relaxed before its pulses stop
+    // Parameters: delay in milliseconds
+    // Return: none
+    void setReleaseDelayMs(uint32_t delayMs) { releaseDelayMs_ = delayMs; }
+
+    // Description: Feeds the finger's current state
+    // Parameters: current time in ms, forceRequested true if the target asks for resistance,
+    //             resting true once the servo has reached its target
+    // Return: action for the caller to apply now
+    ServoIdleAction update(uint32_t nowMs, bool forceRequested, bool resting)
+    {
+        if (forceRequested)
+        {
+            timing_ = false;
+            if (!engaged_)
+            {
+                engaged_ = true;
+                engages_++;
+                return SERVO_ACTION_ENGAGE;
+            }
+            return SERVO_ACTION_NONE;
+        }
+
+        // Relaxed but still travelling back to the end stop, the clock starts once it's there
+        if (!engaged_ || !resting)
+        {
+            timing_ = false;
+            return SERVO_ACTION_NONE;
+        }
+
+        if (!timing_)
+        {
+            timing_ = true;
+            relaxedSinceMs_ = nowMs;
+        }
+        if (nowMs - relaxedSinceMs_ >= releaseDelayMs_)
+        {
+            timing_ = false;
+            engaged_ = false;
+            releases_++;
+            return SERVO_ACTION_RELEASE;
+        }
+        return SERVO_ACTION_NONE;
+    }
+
+    // Description: Time left until this finger would be released if nothing changes
+    // Parameters: current time in ms
+    // Return: milliseconds, UINT32_MAX if no release is pending
+    uint32_t msUntilRelease(uint32_t nowMs) const
+    {
+        if (!timing_)
+        {
+            return UINT32_MAX;
+        }
+        uint32_t elapsed = nowMs - relaxedSinceMs_;
+        return elapsed >= releaseDelayMs_ ? 0 : releaseDelayMs_ - elapsed;
+    }
+
+    bool engaged() const { return engaged_; }
+    uint32_t releases() const { return releases_; }
+    uint32_t engages() const { return engages_; }
+
+private:
+    uint32_t releaseDelayMs_ = 500;
+    uint32_t relaxedSinceMs_ = 0;
+    bool timing_ = false;
+    bool engaged_ = true;
+    uint32_t releases_ = 0;
+    uint32_t engages_ = 0;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#include <stdint.h>
+#include <math.h>
+
+// Per finger limits of the motion profile
+struct ServoMotionLimits
+{
+    float maxVelocity;     // degrees per second
+    float maxAcceleration; // degrees per second squared
+};
+
+// Motion profile for one haptic spool, stepped at the fixed servo control rate.
+// FFB targets arrive at 30-90Hz, so each new target is ramped to over the measured update period
+// instead of being jumped to, then the servo follows that ramp under velocity/acceleration limits
+// and brakes in time to stop on the target instead of overshooting.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+class ServoMotionProfile
+{
+public:
+    // Shortest and longest update period the target ramp assumes
+    static constexpr uint32_t MIN_RAMP_US = 4000;
+    static constexpr uint32_t MAX_RAMP_US = 50000;
+
+    // Description: Jumps to an angle and stops there(used at startup)
+    // Parameters: angle in degrees
+    // Return: none
+    void reset(float angle)
+    {
+        position_ = angle;
+        velocity_ = 0;
+        rampFrom_ = angle;
+        rampTo_ = angle;
+        rampElapsedUs_ = 0;
+        rampDurationUs_ = MIN_RAMP_US;
+        hasUpdate_ = false;
+    }
+
+    // Description: Sets the per finger limits
+    // Parameters: velocity and acceleration limits
+    // Return: none
+    void setLimits(const ServoMotionLimits &limits) { limits_ = limits; }
+
+    // Description: Takes a new FFB target, ramping to it over the time since the previous one
+    // Parameters: target angle in degrees, arrival time in microseconds
+    // Return: none
+    void setTarget(float angle, uint32_t nowUs)
+    {
+        uint32_t period = hasUpdate_ ? nowUs - lastUpdateUs_ : MIN_RAMP_US;
+        if (period < MIN_RAMP_US)
+        {
+            period = MIN_RAMP_US;
+        }
+        if (period > MAX_RAMP_US)
+        {
+            period = MAX_RAMP_US;
+        }
+
+        // Start the new ramp where the old one currently is so the setpoint never jumps
+        rampFrom_ = setpoint();
+        rampTo_ = angle;
+        rampElapsedUs_ = 0;
+        rampDurationUs_ = period;
+        lastUpdateUs_ = nowUs;
+        hasUpdate_ = true;
+    }
+
+    // Description: Advances the profile by one control period
+    // Parameters: control period in microseconds
+    // Return: angle to command in degrees
+    float update(uint32_t dtUs)
+    {
+        float dt = dtUs * 1e-6f;
+        rampElapsedUs_ = rampElapsedUs_ + dtUs < rampDurationUs_ ? rampElapsedUs_ + dtUs : rampDurationUs_;
+
+        float error = setpoint() - position_;
+        float distance = fabsf(error);
+
+        // Fastest speed that can still stop on the setpoint, capped by the velocity limit
+        float desired = sqrtf(2.0f * limits_.maxAcceleration * distance);
+        if (desired > limits_.maxVelocity)
+        {
+            desired = limits_.maxVelocity;
+        }
+        if (error < 0)
+        {
+            desired = -desired;
+        }
+
+        // Acceleration limit on the change of velocity
+        float maxChange = limits_.maxAcceleration * dt;
+        float change = desired - velocity_;
+        if (change > maxChange)
+        {
+            change = maxChange;
+        }
+        if (change < -maxChange)
+        {
+            change = -maxChange;
+        }
+        velocity_ += change;
+
+        // Land on the setpoint instead of overshooting it on the last step
+        float step = velocity_ * dt;
+        if (fabsf(step) >= distance && (step > 0) == (error > 0))
+        {
+            position_ = setpoint();
+            velocity_ = 0;
+        }
+        else
+        {
+            position_ += step;
+        }
+        return position_;
+    }
+
+    // Description: Checks if the spool has reached the end of its ramp and stopped
+    // Parameters: none
+    // Return: true once nothing will move until the next target
+    bool settled() const { return rampElapsedUs_ >= rampDurationUs_ && velocity_ == 0 && position_ == rampTo_; }
+
+    float position() const { return position_; }
+    float velocity() const { return velocity_; }
+    float target() const { return rampTo_; }
+
+private:
+    // Description: Interpolated point on the current target ramp, the target itself once the ramp is done(the
+    // interpolation at 1.0 can be a ULP off, and settled() needs the position to land on the target exactly)
+    // Parameters: none
+    // Return: angle in degrees
+    float setpoint() const
+    {
+        if (rampElapsedUs_ >= rampDurationUs_)
+        {
+            return rampTo_;
+        }
+        return rampFrom_ + (rampTo_ - rampFrom_) * ((float)rampElapsedUs_ / (float)rampDurationUs_);
+    }
+
+    ServoMotionLimits limits_ = {600.0f, 20000.0f};
+    float position_ = 0;
+    float velocity_ = 0;
+    float rampFrom_ = 0;
+    float rampTo_ = 0;
+    uint32_t rampElapsedUs_ = 0;
+    uint32_t rampDurationUs_ = MIN_RAMP_US;
+    uint32_t lastUpdateUs_ = 0;
+    bool hasUpdate_ = false;
+};
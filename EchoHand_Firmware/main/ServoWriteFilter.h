@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+
+// Change detection in front of one servo's LEDC channel.
+// Most FFB lines repeat the previous targets and the motion profile often lands on the same whole
+// degree twice, so a write only goes through when the output actually changes by more than the deadband.
+// The last step onto a resting position always goes through so the deadband never leaves a finger short.
+class ServoWriteFilter
+{
+public:
+    // Description: Sets how far(degrees) the output may drift before a moving servo is rewritten
+    // Parameters: deadband in degrees, 0 writes on every change
+    // Return: none
+    void setDeadband(int deadband) { deadband_ = deadband; }
+
+    // Description: Forgets the last written angle so the next write always goes through
+    // Parameters: none
+    // Return: none
+    void reset() { hasWritten_ = false; }
+
+    // Description: Decides if an angle should reach the servo and records it if so
+    // Parameters: angle about to be written, resting true if the servo will stay at this angle
+    // Return: true if the caller should write
+    bool shouldWrite(int angle, bool resting)
+    {
+        int difference = angle > last_ ? angle - last_ : last_ - angle;
+        if (hasWritten_ && (difference == 0 || (difference <= deadband_ && !resting)))
+        {
+            skipped_++;
+            return false;
+        }
+        last_ = angle;
+        hasWritten_ = true;
+        writes_++;
+        return true;
+    }
+
+    int lastWritten() const { return last_; }
+    uint32_t writes() const { return writes_; }
+    uint32_t skipped() const { return skipped_; }
+
+private:
+    int deadband_ = 0;
+    int last_ = 0;
+    bool hasWritten_ = false;
+    uint32_t writes_ = 0;
+    uint32_t skipped_ = 0;
+};
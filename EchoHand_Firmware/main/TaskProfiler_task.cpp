@@ -0,0 +1,146 @@
+#include "TaskProfiler_task.h"
+
+#if TASK_PROFILER
+#if !configUSE_TRACE_FACILITY || !configGENERATE_RUN_TIME_STATS
+#error "TASK_PROFILER needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS in sdkconfig"
+#endif
+
+// Snapshots of every task in the system, static so profiling never touches the heap
+static TaskStatus_t statuses[PROFILER_MAX_TASKS];
+static TaskHandle_t lastHandles[PROFILER_MAX_TASKS];
+static uint32_t lastRunTime[PROFILER_MAX_TASKS];
+static UBaseType_t lastCount = 0;
+
+// Description: Run time a task had at the previous profile
+// Parameters: task handle
+// Return: run time counter, 0 if the task is new
+static uint32_t previousRunTime(TaskHandle_t handle)
+{
+    for (UBaseType_t i = 0; i < lastCount; i++)
+    {
+        if (lastHandles[i] == handle)
+        {
+            return lastRunTime[i];
+        }
+    }
+    return 0;
+}
+
+// Description: Share of one core a task used over the window
+// Parameters: task status, run time of the window(esp_timer microseconds)
+// Return: percent of one core
+static float cpuPercent(const TaskStatus_t &status, uint32_t window)
+{
+    uint32_t used = status.ulRunTimeCounter - previousRunTime(status.xHandle);
+    return window ? 100.0f * used / window : 0.0f;
+}
+
+// Description: Row of the task table a task was started from
+// Parameters: task handle
+// Return: row index, getTaskCount() if the task isn't from the table
+static size_t tableIndex(TaskHandle_t handle)
+{
+    size_t i = 0;
+    while (i < getTaskCount() && getTaskHandle(i) != handle)
+    {
+        i++;
+    }
+    return i;
+}
+
+// Description: Prints CPU share, stack use and loop timing of every task every TASK_PROFILER_PERIOD_MS
+// Run time comes from FreeRTOS' run time stats(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, esp_timer clock),
+// loop timing from the tasks' markTaskLoop() calls
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskProfiler(void *pvParameters)
+{
+    // To not get compiler unused variable error
+    (void)pvParameters;
+
+    TickType_t lastWake = xTaskGetTickCount();
+    uint32_t lastTotal = 0;
+
+    for (;;)
+    {
+        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TASK_PROFILER_PERIOD_MS));
+        markTaskLoop();
+
+        uint32_t total = 0;
+        UBaseType_t count = uxTaskGetSystemState(statuses, PROFILER_MAX_TASKS, &total);
+        if (count == 0)
+        {
+            Serial.printf("Task profiler: more than %d tasks\n", PROFILER_MAX_TASKS);
+            continue;
+        }
+        uint32_t window = total - lastTotal;
+
+        // Core load is whatever its idle task didn't get
+        float coreLoad[portNUM_PROCESSORS];
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(core);
+            coreLoad[core] = 100.0f;
+            for (UBaseType_t i = 0; i < count; i++)
+            {
+                if (statuses[i].xHandle == idle)
+                {
+                    coreLoad[core] -= cpuPercent(statuses[i], window);
+                }
+            }
+        }
+
+        Serial.printf("--- Task profile %lums: core0 %.1f%% core1 %.1f%% heap %lu free %lu min\n",
+                      (unsigned long)(window / 1000), coreLoad[0], coreLoad[1],
+                      (unsigned long)esp_get_free_heap_size(), (unsigned long)esp_get_minimum_free_heap_size());
+        Serial.printf("%-16s %4s %4s %6s %13s %8s %8s %8s\n",
+                      "Task", "Core", "Prio", "CPU%", "Stack used", "LoopMs", "MaxMs", "LateMs");
+
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            const TaskStatus_t &status = statuses[i];
+            BaseType_t core = xTaskGetCoreID(status.xHandle);
+            char coreName[4];
+            snprintf(coreName, sizeof(coreName), core == tskNO_AFFINITY ? "-" : "%d", (int)core);
+
+            // Only tasks from the table have a known stack size and loop timing, high water mark is in bytes on IDF
+            size_t row = tableIndex(status.xHandle);
+            if (row == getTaskCount())
+            {
+                Serial.printf("%-16s %4s %4u %6.1f %6lu free\n", status.pcTaskName, coreName,
+                              (unsigned)status.uxCurrentPriority, cpuPercent(status, window),
+                              (unsigned long)status.usStackHighWaterMark);
+                continue;
+            }
+
+            const TaskSpec &spec = getTaskSpec(row);
+            TaskLoopStats loop = takeTaskLoopStats(row);
+            float meanMs = loop.loops ? loop.sumUs / 1000.0f / loop.loops : 0.0f;
+            float maxMs = loop.maxUs / 1000.0f;
+            float lateMs = spec.periodMs && maxMs > spec.periodMs ? maxMs - spec.periodMs : 0.0f;
+            Serial.printf("%-16s %4s %4u %6.1f %6lu/%-6lu %8.2f %8.2f %8.2f\n", status.pcTaskName, coreName,
+                          (unsigned)status.uxCurrentPriority, cpuPercent(status, window),
+                          (unsigned long)(spec.stackBytes - status.usStackHighWaterMark), (unsigned long)spec.stackBytes,
+                          meanMs, maxMs, lateMs);
+        }
+
+        // Keep this profile's counters for the next window
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            lastHandles[i] = statuses[i].xHandle;
+            lastRunTime[i] = statuses[i].ulRunTimeCounter;
+        }
+        lastCount = count;
+        lastTotal = total;
+    }
+}
+#else
+// Description: Stand-in while the profiler is compiled out, its task table row is disabled so it never runs
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskProfiler(void *pvParameters)
+{
+    (void)pvParameters;
+    vTaskDelete(NULL);
+}
+#endif
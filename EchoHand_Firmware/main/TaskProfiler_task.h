@@ -0,0 +1,14 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_system.h>
+#include "config.h"
+#include "TaskTable.h"
+
+// Most tasks one profile can hold, the app's own plus IDF's(idle, timer, esp_timer, WiFi, BT...)
+#define PROFILER_MAX_TASKS 32
+
+void TaskProfiler(void *pvParameters);
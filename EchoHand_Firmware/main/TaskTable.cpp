@@ -0,0 +1,254 @@
+#include "TaskTable.h"
+#include <atomic>
+
+// Table started by startTasks() and the handles its tasks got
+static const TaskSpec *taskTable = NULL;
+static size_t taskCount = 0;
+static TaskHandle_t taskHandles[TASK_TABLE_MAX];
+
+// Set once every handle is stored, a task not found after that isn't in the table
+static std::atomic<bool> tasksStarted(false);
+
+// Row of the calling task, looked up once per task so markTaskLoop() and the trace records don't scan the table
+static thread_local size_t cachedTaskRow = SIZE_MAX;
+
+// Loop timing per task as running totals, only the task itself writes them and the profiler takes the
+// difference from its last take, so neither side locks(sumUs wraps after 71 minutes, takes come far sooner)
+struct TaskLoopCounters
+{
+    std::atomic<uint32_t> loops;
+    std::atomic<uint32_t> sumUs;
+    std::atomic<uint32_t> maxUs; // cleared by each take
+};
+static TaskLoopCounters loopCounters[TASK_TABLE_MAX];
+static uint32_t takenLoops[TASK_TABLE_MAX];
+static uint32_t takenSumUs[TASK_TABLE_MAX];
+
+// Interval start of the calling task's loop
+static thread_local uint32_t lastLoopUs = 0;
+static thread_local bool loopStarted = false;
+
+// Heap free tasks past their first loop pass, any allocation they make trips HEAP_WATCH
+static volatile bool heapWatched[TASK_TABLE_MAX];
+
+#if TASK_STATIC_ALLOCATION
+// Control blocks of the tables' tasks, stacks come from the pool main.cpp reserves
+static StaticTask_t taskBuffers[TASK_TABLE_MAX];
+#endif
+
+// Description: Creates one task of the table, on a stack carved from the pool if there is one
+// Parameters: row index, stack pool(NULL to allocate from the heap) and what is left of it in bytes
+// Return: task handle, NULL if it couldn't be created
+static TaskHandle_t createTask(size_t index, StackType_t *&stackPool, size_t &poolLeft)
+{
+    const TaskSpec &spec = taskTable[index];
+#if TASK_STATIC_ALLOCATION
+    if (stackPool != NULL)
+    {
+        // Stack depth is in bytes on IDF, StackType_t is a byte
+        uint32_t bytes = poolStackBytes(spec.stackBytes);
+        if (bytes > poolLeft)
+        {
+            return NULL;
+        }
+        StackType_t *stack = stackPool;
+        stackPool += bytes;
+        poolLeft -= bytes;
+        return xTaskCreateStaticPinnedToCore(spec.function, spec.name, spec.stackBytes, spec.parameters,
+                                             spec.priority, stack, &taskBuffers[index], spec.core);
+    }
+#endif
+
+    TaskHandle_t handle = NULL;
+    if (xTaskCreatePinnedToCore(spec.function, spec.name, spec.stackBytes, spec.parameters,
+                                spec.priority, &handle, spec.core) != pdPASS)
+    {
+        return NULL;
+    }
+    return handle;
+}
+
+// Description: Creates every enabled task of the table in order, pinned to its core
+// Parameters: task table(must outlive the tasks) and its length,
+//             static stack pool of taskStackPoolBytes() and its size(NULL to allocate stacks from the heap)
+// Return: none
+void startTasks(const TaskSpec *tasks, size_t count, StackType_t *stackPool, size_t poolBytes)
+{
+    taskTable = tasks;
+    taskCount = count < TASK_TABLE_MAX ? count : TASK_TABLE_MAX;
+    if (count > TASK_TABLE_MAX)
+    {
+        // main.cpp checks its table at compile time, this catches the host tools' tables
+        Serial.printf("Task table has %u rows, only the first %u are started\n", (unsigned)count, (unsigned)TASK_TABLE_MAX);
+    }
+
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        const TaskSpec &spec = tasks[i];
+        taskHandles[i] = NULL;
+        if (!spec.enabled)
+        {
+            continue;
+        }
+
+        taskHandles[i] = createTask(i, stackPool, poolBytes);
+        if (taskHandles[i] == NULL)
+        {
+            Serial.printf("Failed to create task %s(%lu byte stack)\n", spec.name, (unsigned long)spec.stackBytes);
+            continue;
+        }
+        if (spec.handle != NULL)
+        {
+            *spec.handle = taskHandles[i];
+        }
+    }
+    tasksStarted.store(true);
+}
+
+// Description: Number of rows in the running task table
+// Parameters: none
+// Return: row count
+size_t getTaskCount()
+{
+    return taskCount;
+}
+
+// Description: Row of the running task table
+// Parameters: row index
+// Return: task spec
+const TaskSpec &getTaskSpec(size_t index)
+{
+    return taskTable[index];
+}
+
+// Description: Handle of a task from the table
+// Parameters: row index
+// Return: handle, NULL if the task is disabled or failed to start
+TaskHandle_t getTaskHandle(size_t index)
+{
+    return index < taskCount ? taskHandles[index] : NULL;
+}
+
+// Description: Looks up the calling task in the table, the first call of each task scans it
+// Parameters: none
+// Return: row index, getTaskCount() if the task isn't in the table
+size_t currentTaskIndex()
+{
+    if (cachedTaskRow != SIZE_MAX)
+    {
+        return cachedTaskRow;
+    }
+
+    // Keep scanning while startTasks() may still be storing the caller's handle
+    bool started = tasksStarted.load();
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    size_t i = 0;
+    while (i < taskCount && taskHandles[i] != self)
+    {
+        i++;
+    }
+    if (i < taskCount || started)
+    {
+        cachedTaskRow = i;
+    }
+    return i;
+}
+
+// Description: Records a loop pass of the calling task, the time since its previous pass is one interval
+// Parameters: none
+// Return: none
+void markTaskLoop()
+{
+    size_t i = currentTaskIndex();
+    if (i == taskCount)
+    {
+        return;
+    }
+
+    uint32_t now = micros();
+    heapWatched[i] = loopStarted && taskTable[i].heapFree;
+    if (loopStarted)
+    {
+        uint32_t interval = now - lastLoopUs;
+        TaskLoopCounters &counters = loopCounters[i];
+        counters.sumUs.store(counters.sumUs.load(std::memory_order_relaxed) + interval, std::memory_order_relaxed);
+        counters.loops.store(counters.loops.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        if (interval > counters.maxUs.load(std::memory_order_relaxed))
+        {
+            counters.maxUs.store(interval, std::memory_order_relaxed);
+        }
+    }
+    lastLoopUs = now;
+    loopStarted = true;
+}
+
+// Description: Starts a new interval without recording the previous one, for event driven tasks
+// waking up from an idle wait that shouldn't count as a late loop
+// Parameters: none
+// Return: none
+void restartTaskLoop()
+{
+    size_t i = currentTaskIndex();
+    if (i == taskCount)
+    {
+        return;
+    }
+
+    heapWatched[i] = loopStarted && taskTable[i].heapFree;
+    lastLoopUs = micros();
+    loopStarted = true;
+}
+
+// Description: Takes a task's loop timing since the previous take, from the profiler only.
+// A pass recorded while the take reads may land in the next window
+// Parameters: row index
+// Return: loop timing since the last take
+TaskLoopStats takeTaskLoopStats(size_t index)
+{
+    TaskLoopStats taken = {0, 0, 0};
+    if (index >= taskCount)
+    {
+        return taken;
+    }
+
+    TaskLoopCounters &counters = loopCounters[index];
+    uint32_t loops = counters.loops.load(std::memory_order_acquire);
+    uint32_t sumUs = counters.sumUs.load(std::memory_order_relaxed);
+    taken.loops = loops - takenLoops[index];
+    taken.sumUs = sumUs - takenSumUs[index];
+    taken.maxUs = counters.maxUs.exchange(0, std::memory_order_relaxed);
+    takenLoops[index] = loops;
+    takenSumUs[index] = sumUs;
+    return taken;
+}
+
+#if HEAP_WATCH
+#if defined(ESP_PLATFORM) && !CONFIG_HEAP_USE_HOOKS
+#error "HEAP_WATCH needs CONFIG_HEAP_USE_HOOKS in sdkconfig"
+#endif
+
+// Description: IDF heap hook(CONFIG_HEAP_USE_HOOKS), called after every successful allocation.
+// Aborts as soon as a heap free task allocates after its first loop pass(setup and lazy driver init are done
+// by then), the panic backtrace points straight at the allocation
+// Parameters: allocated block, its size and capabilities
+// Return: none
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+    (void)ptr;
+    (void)caps;
+    if (xPortInIsrContext())
+    {
+        return;
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        if (taskHandles[i] == self && heapWatched[i])
+        {
+            esp_rom_printf("Heap watch: %s allocated %u bytes after boot\n", pcTaskGetName(self), (unsigned)size);
+            abort();
+        }
+    }
+}
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_attr.h>
+#include <esp_rom_sys.h>
+#include "config.h"
+
+// Task signal to notify servo's to activate
+extern TaskHandle_t xServoTaskHandle;
+
+// Task signal to notify vibration motors of a new F command
+extern TaskHandle_t xVibrationTaskHandle;
+
+// Most tasks a task table can hold
+#define TASK_TABLE_MAX 12
+
+// One row of the task table in main.cpp, everything needed to create and profile a task
+struct TaskSpec
+{
+    TaskFunction_t function; // task entry point
+    const char *name;        // name shown by the profiler(max 15 characters)
+    uint32_t stackBytes;     // stack size in bytes
+    UBaseType_t priority;    // 0-> lowest, shares its core with the idle task
+    BaseType_t core;         // core the task is pinned to
+    uint32_t periodMs;       // loop period the profiler measures lateness against, 0 if the loop has none
+    void *parameters;        // passed to the task
+    TaskHandle_t *handle;    // where to store the handle, NULL if nobody notifies the task
+    bool enabled;            // skipped when false(config.h switches)
+    bool heapFree;           // loop never allocates, checked by HEAP_WATCH from its second loop pass
+};
+
+// Description: Stack of one task rounded up so every stack carved from the static pool stays 16 byte aligned
+// Parameters: stack size in bytes
+// Return: size it takes in the pool
+inline constexpr uint32_t poolStackBytes(uint32_t stackBytes)
+{
+    return (stackBytes + 15) & ~15u;
+}
+
+// Description: Static stack pool a task table needs with TASK_STATIC_ALLOCATION, evaluated at compile time
+// Parameters: task table and its length
+// Return: pool size in bytes
+inline constexpr size_t taskStackPoolBytes(const TaskSpec *tasks, size_t count)
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        bytes += tasks[i].enabled ? poolStackBytes(tasks[i].stackBytes) : 0;
+    }
+    return bytes;
+}
+
+// Loop timing a task reports through markTaskLoop()
+struct TaskLoopStats
+{
+    uint32_t loops; // intervals measured since the last take
+    uint32_t sumUs; // sum of the intervals
+    uint32_t maxUs; // longest interval
+};
+
+void startTasks(const TaskSpec *tasks, size_t count, StackType_t *stackPool = NULL, size_t poolBytes = 0);
+size_t getTaskCount();
+const TaskSpec &getTaskSpec(size_t index);
+TaskHandle_t getTaskHandle(size_t index);
+size_t currentTaskIndex();
+void markTaskLoop();
+void restartTaskLoop();
+TaskLoopStats takeTaskLoopStats(size_t index);
@@ -0,0 +1,233 @@
+#include "TelemetryCodec.h"
+
+// Description: Rounds a value to fixed point and clamps it to a 16 bit field
+// Parameters: value, units per count
+// Return: field value
+static int16_t toFixed16(float value, float scale)
+{
+    float counts = value / scale + (value < 0 ? -0.5f : 0.5f);
+    return counts > 32767.0f ? 32767 : (counts < -32768.0f ? -32768 : (int16_t)counts);
+}
+
+// Little endian writers and readers over the payload, advance the position they're given
+static void put16(uint8_t *&out, uint16_t value)
+{
+    *out++ = value & 0xFF;
+    *out++ = value >> 8;
+}
+
+static void put32(uint8_t *&out, uint32_t value)
+{
+    put16(out, value & 0xFFFF);
+    put16(out, value >> 16);
+}
+
+static uint16_t get16(const uint8_t *&in)
+{
+    uint16_t value = in[0] | in[1] << 8;
+    in += 2;
+    return value;
+}
+
+static uint32_t get32(const uint8_t *&in)
+{
+    uint32_t low = get16(in);
+    return low | (uint32_t)get16(in) << 16;
+}
+
+// Description: CRC-16/CCITT-FALSE(polynomial 0x1021, start 0xFFFF) of a payload
+// Parameters: data and its length
+// Return: CRC
+uint16_t telemetryCrc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Description: COBS encodes a block so it holds no 0 bytes
+// Parameters: data, its length, output with room for length + length / 254 + 1 bytes
+// Return: encoded length(without a delimiter)
+size_t cobsEncode(const uint8_t *data, size_t length, uint8_t *out)
+{
+    // A block ends at a 0 or after 254 data bytes, its code byte holds the distance to the next block
+    size_t code = 0;
+    size_t used = 1;
+    uint8_t run = 1;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != 0)
+        {
+            out[used++] = data[i];
+            run++;
+        }
+        if (data[i] == 0 || run == 0xFF)
+        {
+            out[code] = run;
+            code = used++;
+            run = 1;
+        }
+    }
+    out[code] = run;
+    return used;
+}
+
+// Description: Decodes one COBS block
+// Parameters: encoded data without its delimiter, its length, output with room for length bytes
+// Return: decoded length, 0 if the block is malformed
+size_t cobsDecode(const uint8_t *data, size_t length, uint8_t *out)
+{
+    size_t used = 0;
+    size_t i = 0;
+    while (i < length)
+    {
+        uint8_t code = data[i++];
+        if (code == 0 || i + code - 1 > length)
+        {
+            return 0;
+        }
+        for (uint8_t n = 1; n < code; n++)
+        {
+            out[used++] = data[i++];
+        }
+        if (code != 0xFF && i < length)
+        {
+            out[used++] = 0;
+        }
+    }
+    return used;
+}
+
+// Description: Builds the wire frame of a telemetry frame
+// Parameters: frame, output buffer and its size(TELEMETRY_MAX_FRAME)
+// Return: bytes to send including the 0 delimiter, 0 if the buffer is too small
+size_t encodeTelemetryFrame(const TelemetryFrame &frame, uint8_t *out, size_t size)
+{
+    if (size < TELEMETRY_MAX_FRAME)
+    {
+        return 0;
+    }
+
+    uint8_t payload[TELEMETRY_PAYLOAD_BYTES];
+    uint8_t *p = payload;
+    *p++ = TELEMETRY_VERSION;
+    put16(p, frame.sequence);
+    put32(p, frame.timeMs);
+    put32(p, frame.revision);
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, frame.fingerAngles[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, toFixed16(frame.fingerVelocities[i], 1.0f));
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, toFixed16(frame.servoTargetAngles[i], 0.1f));
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, toFixed16(frame.servoForces[i], 0.001f));
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put16(p, frame.vibrationRPMs[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        *p++ = frame.vibrationPercent[i];
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        put16(p, toFixed16(frame.joystickXY[i], 1.0f));
+    }
+    *p++ = frame.buttonsBitmask;
+    *p++ = frame.batteryPercent;
+    for (int i = 0; i < 5; i++)
+    {
+        put32(p, frame.servoWrites[i]);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        put32(p, frame.servoSkipped[i]);
+    }
+    put32(p, frame.freeHeap);
+    *p++ = frame.flags;
+    put16(p, telemetryCrc16(payload, p - payload));
+
+    size_t length = cobsEncode(payload, sizeof(payload), out);
+    out[length++] = 0;
+    return length;
+}
+
+// Description: Reads a telemetry frame from one COBS block
+// Parameters: block without its 0 delimiter, its length, frame to fill
+// Return: true if the block is a frame of this version with a good CRC
+bool decodeTelemetryFrame(const uint8_t *data, size_t length, TelemetryFrame &frame)
+{
+    uint8_t payload[TELEMETRY_MAX_FRAME];
+    if (length > sizeof(payload) || cobsDecode(data, length, payload) != TELEMETRY_PAYLOAD_BYTES ||
+        payload[0] != TELEMETRY_VERSION)
+    {
+        return false;
+    }
+    const uint8_t *p = payload + TELEMETRY_PAYLOAD_BYTES - 2;
+    if (get16(p) != telemetryCrc16(payload, TELEMETRY_PAYLOAD_BYTES - 2))
+    {
+        return false;
+    }
+
+    p = payload + 1;
+    frame.sequence = get16(p);
+    frame.timeMs = get32(p);
+    frame.revision = get32(p);
+    for (int i = 0; i < 5; i++)
+    {
+        frame.fingerAngles[i] = get16(p);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.fingerVelocities[i] = (int16_t)get16(p);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.servoTargetAngles[i] = (int16_t)get16(p) * 0.1f;
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.servoForces[i] = (int16_t)get16(p) * 0.001f;
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.vibrationRPMs[i] = get16(p);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.vibrationPercent[i] = *p++;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        frame.joystickXY[i] = (int16_t)get16(p);
+    }
+    frame.buttonsBitmask = *p++;
+    frame.batteryPercent = *p++;
+    for (int i = 0; i < 5; i++)
+    {
+        frame.servoWrites[i] = get32(p);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        frame.servoSkipped[i] = get32(p);
+    }
+    frame.freeHeap = get32(p);
+    frame.flags = *p++;
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Binary telemetry the debug task(DataBrokerPrint.cpp) streams on the USB Serial in place of formatted text:
+// one frame per period with the DataBroker snapshot and the servo/vibration stats, fixed point little endian
+// fields with a CRC-16, COBS encoded and ended by a 0 byte so a reader can resync on any 0 and text printed by
+// other tasks between frames can't be mistaken for one. host/TelemetryDecode renders the frames.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+
+// First byte of every payload, changes with the layout
+#define TELEMETRY_VERSION 0xE1
+
+// Payload bytes before COBS(version, fields, CRC)
+#define TELEMETRY_PAYLOAD_BYTES 119
+
+// Longest frame on the wire, COBS adds one byte per 254 plus the leading code and the 0 delimiter
+#define TELEMETRY_MAX_FRAME (TELEMETRY_PAYLOAD_BYTES + TELEMETRY_PAYLOAD_BYTES / 254 + 2)
+
+// Bits of TelemetryFrame::flags
+#define TELEMETRY_FLAG_FORCE_FEEDBACK 0x01 // servo force estimates are measured
+#define TELEMETRY_FLAG_VIBRATION 0x02      // vibration motors are fitted
+
+// One telemetry frame in engineering units, quantised on the wire to the resolution noted per field
+struct TelemetryFrame
+{
+    uint16_t sequence;           // counts frames, gaps are frames lost on the link
+    uint32_t timeMs;             // glove uptime
+    uint32_t revision;           // DataBroker revision of the snapshot
+    uint16_t fingerAngles[5];    // 0-4095
+    float fingerVelocities[5];   // finger units per second, whole units within +-32767
+    float servoTargetAngles[5];  // degrees, 0.1
+    float servoForces[5];        // 1.0 = stalled, 0.001
+    uint16_t vibrationRPMs[5];   // commanded RPM
+    uint8_t vibrationPercent[5]; // pulse envelope in percent
+    float joystickXY[2];         // raw ADC, whole counts
+    uint8_t buttonsBitmask;      // DataBroker button bits
+    uint8_t batteryPercent;
+    uint32_t servoWrites[5];     // writes that reached the LEDC registers
+    uint32_t servoSkipped[5];    // writes dropped by change detection
+    uint32_t freeHeap;           // bytes
+    uint8_t flags;               // TELEMETRY_FLAG_ bits
+};
+
+uint16_t telemetryCrc16(const uint8_t *data, size_t length);
+size_t cobsEncode(const uint8_t *data, size_t length, uint8_t *out);
+size_t cobsDecode(const uint8_t *data, size_t length, uint8_t *out);
+size_t encodeTelemetryFrame(const TelemetryFrame &frame, uint8_t *out, size_t size);
+bool decodeTelemetryFrame(const uint8_t *data, size_t length, TelemetryFrame &frame);
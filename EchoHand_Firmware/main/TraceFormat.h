@@ -0,0 +1,65 @@
+#pragma once
+#include <stdint.h>
+
+// Records of the hot path trace(see TraceRing.h) and the text dump they are streamed in, shared with the host
+// decoder(host/TraceDecode.cpp). No Arduino/FreeRTOS dependencies so host tools can run the same code.
+//
+// Dump, printed on the USB Serial between the marker lines:
+//   C <cpu MHz>                          cycle counter rate
+//   S <core> <time us> <cycle count>     one per core, read together on that core(the counters aren't in step)
+//   N <task row> <name>                  task table rows the records refer to
+//   D <core> <dropped>                   records overwritten before the dump
+//   R <core> <record hex>...             up to 16 records per line, oldest first
+// A record is 16 hex digits: cycle count(8), arg(4), event(2), task row << 2 | phase(2).
+
+#define TRACE_DUMP_BEGIN "--- TRACE BEGIN ---"
+#define TRACE_DUMP_END "--- TRACE END ---"
+
+// Records per hex line of the dump
+#define TRACE_DUMP_RECORDS_PER_LINE 16
+
+// Command line the PC sends on any link to ask for a dump
+#define TRACE_DUMP_COMMAND '!'
+
+// Task field of records from tasks outside the task table(WiFi task callbacks)
+#define TRACE_TASK_OTHER 0x3F
+
+enum TraceEvent : uint8_t
+{
+    TRACE_SAMPLE = 0,      // acquisition pass, arg: none
+    TRACE_FILTER,          // filtering one ADC burst, arg: pin
+    TRACE_BROKER_COMMIT,   // DataBroker writes of a pass, arg: none
+    TRACE_ENCODE,          // encoding an input line, arg: line length(end)
+    TRACE_ESPNOW_SEND,     // esp_now_send() call, arg: frame sequence number
+    TRACE_ESPNOW_SENT,     // send callback, arg: 1 acknowledged, 0 failed
+    TRACE_ESPNOW_RECEIVE,  // receive callback, arg: packet length
+    TRACE_PARSE,           // parsing and applying an FFB line, arg: line length
+    TRACE_SERVO_WRITE,     // servo write, arg: finger << 8 | angle
+    TRACE_EVENT_COUNT
+};
+
+enum TracePhase : uint8_t
+{
+    TRACE_PHASE_BEGIN = 0,
+    TRACE_PHASE_END,
+    TRACE_PHASE_INSTANT
+};
+
+struct TraceRecord
+{
+    uint32_t cycles;
+    uint16_t arg;
+    uint8_t event;
+    uint8_t taskPhase; // task table row << 2 | phase
+};
+
+// Description: Name of a trace event as the decoder shows it
+// Parameters: event id
+// Return: name, "unknown" for ids from a newer firmware
+inline const char *traceEventName(uint8_t event)
+{
+    static const char *const names[TRACE_EVENT_COUNT] = {
+        "sample", "filter", "broker commit", "encode", "esp_now_send", "esp_now sent", "esp_now receive", "parse", "servo write",
+    };
+    return event < TRACE_EVENT_COUNT ? names[event] : "unknown";
+}
@@ -0,0 +1,160 @@
+#include "TraceRing.h"
+#include <atomic>
+#include <esp_ipc.h>
+#include "TaskTable.h"
+
+static_assert((TRACE_RING_RECORDS & (TRACE_RING_RECORDS - 1)) == 0, "TRACE_RING_RECORDS must be a power of 2");
+
+// Records per ring, one when tracing is compiled out so the rings take no RAM
+#define TRACE_RING_SLOTS (HOT_PATH_TRACE ? TRACE_RING_RECORDS : 1)
+
+// One ring per core, only tasks on that core write it. head counts every record ever claimed, the slot is its
+// low bits so the ring overwrites its oldest records
+struct TraceRing
+{
+    std::atomic<uint32_t> head;
+    TraceRecord records[TRACE_RING_SLOTS];
+};
+
+static TraceRing rings[portNUM_PROCESSORS];
+
+// Off while a dump reads the rings
+static std::atomic<bool> tracing(true);
+
+TaskHandle_t xTraceDumpTaskHandle = NULL;
+
+// Time and cycle count of one core read back to back
+struct TraceSync
+{
+    uint32_t us;
+    uint32_t cycles;
+};
+
+// Description: Task table row of the calling task for its records, looked up once per task by currentTaskIndex()
+// Parameters: none
+// Return: row, TRACE_TASK_OTHER outside the table(WiFi task callbacks, IPC)
+uint8_t traceTaskRow()
+{
+    size_t row = currentTaskIndex();
+    return row < getTaskCount() && row < TRACE_TASK_OTHER ? (uint8_t)row : TRACE_TASK_OTHER;
+}
+
+// Description: Writes one record to the ring of the calling core, a preempting writer on the same core just
+// claims the next slot. The slot is claimed before the cycle count is read so only a writer preempting between
+// the two can land a few cycles out of order, records of one task always stay in order
+// Parameters: event, phase, argument
+// Return: none
+void traceRecord(TraceEvent event, TracePhase phase, uint16_t arg)
+{
+    if (!tracing.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    uint8_t taskPhase = (uint8_t)(traceTaskRow() << 2 | phase);
+    TraceRing &ring = rings[xPortGetCoreID()];
+    uint32_t slot = ring.head.fetch_add(1, std::memory_order_relaxed) & (TRACE_RING_SLOTS - 1);
+    ring.records[slot] = {esp_cpu_get_cycle_count(), arg, (uint8_t)event, taskPhase};
+}
+
+// Description: Asks the dump task to print the rings, from any task
+// Parameters: none
+// Return: none
+void requestTraceDump()
+{
+    if (HOT_PATH_TRACE && xTraceDumpTaskHandle != NULL)
+    {
+        xTaskNotifyGive(xTraceDumpTaskHandle);
+    }
+}
+
+// Description: Reads the clock and the cycle counter of the core it runs on
+// Parameters: TraceSync to fill
+// Return: none
+static void readSync(void *arg)
+{
+    TraceSync &sync = *static_cast<TraceSync *>(arg);
+    sync.cycles = esp_cpu_get_cycle_count();
+    sync.us = micros();
+}
+
+// Description: Prints one core's ring oldest record first, TRACE_DUMP_RECORDS_PER_LINE records per line
+// Parameters: core
+// Return: none
+static void printRing(BaseType_t core)
+{
+    const TraceRing &ring = rings[core];
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+    uint32_t count = head < TRACE_RING_SLOTS ? head : TRACE_RING_SLOTS;
+    Serial.printf("D %d %lu\n", (int)core, (unsigned long)(head - count));
+
+    // "R <core>" plus 16 hex digits and a space per record
+    char line[8 + TRACE_DUMP_RECORDS_PER_LINE * 17];
+    for (uint32_t first = head - count; first != head;)
+    {
+        int used = snprintf(line, sizeof(line), "R %d", (int)core);
+        for (int n = 0; n < TRACE_DUMP_RECORDS_PER_LINE && first != head; n++, first++)
+        {
+            const TraceRecord &r = ring.records[first & (TRACE_RING_SLOTS - 1)];
+            used += snprintf(line + used, sizeof(line) - used, " %08lx%04x%02x%02x", (unsigned long)r.cycles,
+                             (unsigned)r.arg, (unsigned)r.event, (unsigned)r.taskPhase);
+        }
+        Serial.println(line);
+    }
+}
+
+// Description: Prints the trace rings on the USB Serial when requestTraceDump() is called(the PC sends a
+// TRACE_DUMP_COMMAND line) or every TRACE_DUMP_PERIOD_MS, then starts them over
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskTraceDump(void *pvParameters)
+{
+    // To not get compiler unused variable error
+    (void)pvParameters;
+
+    const TickType_t wait = TRACE_DUMP_PERIOD_MS ? pdMS_TO_TICKS(TRACE_DUMP_PERIOD_MS) : portMAX_DELAY;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        // Writers that passed the check before the stop finish within a tick
+        tracing.store(false);
+        vTaskDelay(1);
+
+        // Each core's cycle counter against the shared microsecond clock, read on that core
+        TraceSync syncs[portNUM_PROCESSORS];
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            if (core == xPortGetCoreID())
+            {
+                readSync(&syncs[core]);
+            }
+            else
+            {
+                esp_ipc_call_blocking(core, readSync, &syncs[core]);
+            }
+        }
+
+        Serial.println(TRACE_DUMP_BEGIN);
+        Serial.printf("C %lu\n", (unsigned long)getCpuFrequencyMhz());
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            Serial.printf("S %d %lu %lu\n", (int)core, (unsigned long)syncs[core].us, (unsigned long)syncs[core].cycles);
+        }
+        for (size_t i = 0; i < getTaskCount(); i++)
+        {
+            Serial.printf("N %u %s\n", (unsigned)i, getTaskSpec(i).name);
+        }
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            printRing(core);
+        }
+        Serial.println(TRACE_DUMP_END);
+
+        for (TraceRing &ring : rings)
+        {
+            ring.head.store(0);
+        }
+        tracing.store(true);
+    }
+}
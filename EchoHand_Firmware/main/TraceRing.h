@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_cpu.h>
+#include "config.h"
+#include "TraceFormat.h"
+
+// Hot path trace: every core has a ring of TRACE_RING_RECORDS {cycle count, event, arg} records the hot path
+// writes through the TRACE_ macros below, a writer claims its slot with one atomic add so tracing never takes a
+// lock or blocks. TaskTraceDump prints the rings on the USB Serial(format in TraceFormat.h) for
+// host/TraceDecode to turn into a Chrome trace/Perfetto timeline.
+// With HOT_PATH_TRACE at 0 the macros compile to nothing.
+
+// Task signal to dump the rings
+extern TaskHandle_t xTraceDumpTaskHandle;
+
+uint8_t traceTaskRow();
+void traceRecord(TraceEvent event, TracePhase phase, uint16_t arg);
+void requestTraceDump();
+void TaskTraceDump(void *pvParameters);
+
+#if HOT_PATH_TRACE
+#define TRACE_BEGIN(event, arg) traceRecord((event), TRACE_PHASE_BEGIN, (uint16_t)(arg))
+#define TRACE_END(event, arg) traceRecord((event), TRACE_PHASE_END, (uint16_t)(arg))
+#define TRACE_INSTANT(event, arg) traceRecord((event), TRACE_PHASE_INSTANT, (uint16_t)(arg))
+#else
+#define TRACE_BEGIN(event, arg) ((void)0)
+#define TRACE_END(event, arg) ((void)0)
+#define TRACE_INSTANT(event, arg) ((void)0)
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <concepts>
+
+// Running counters every transport keeps, the comms task fills in the generic ones
+struct TransportStats
+{
+    uint32_t framesSent;     // input lines handed to the link
+    uint32_t framesDeferred; // slots where the link took nothing, the next slot sends the newest state
+    uint32_t linesReceived;  // haptic lines passed to the parser
+    uint32_t sendErrors;     // lines the link accepted but failed to queue(driver/stack errors)
+    uint32_t bytesSent;
+};
+
+// What TaskCommunication needs from a link, checked at compile time so the hot loop is
+// specialised per transport with no virtual dispatch:
+//   includeJoystick      adds the F/G axes and H button to the input line
+//   begin()              brings the link up from the comms task, false if it can't run
+//   receiveLine(...)     non-blocking, copies the next complete haptic line(no '\n') if there is one
+//   readyToSend(nowUs)   cheap check if a send slot is open, lets the task skip snapshot and encode
+//   send(line, length)   sends one '\n' terminated line, false if the link had no room(retry later)
+//   idle()               end of each loop pass, gives the CPU away if the link needs it to
+//   stats                TransportStats member
+template <typename T>
+concept Transport = requires(T transport, const char *line, char *buffer, size_t size, size_t &length, uint32_t nowUs) {
+    { T::includeJoystick } -> std::convertible_to<bool>;
+    { transport.begin() } -> std::same_as<bool>;
+    { transport.receiveLine(buffer, size, length) } -> std::same_as<bool>;
+    { transport.readyToSend(nowUs) } -> std::same_as<bool>;
+    { transport.send(line, size) } -> std::same_as<bool>;
+    { transport.idle() };
+    { transport.stats } -> std::convertible_to<TransportStats>;
+};
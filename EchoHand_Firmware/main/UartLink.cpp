@@ -0,0 +1,247 @@
+#include "UartLink.h"
+
+UartLink::UartLink()
+    : port_(UART_NUM_0),
+      eventQueue_(NULL),
+      installed_(false),
+      stats_{0, 0, 0, 0, 0} {}
+
+UartLink::~UartLink()
+{
+  end();
+}
+
+// Description: Installs the UART driver with an event queue and '\n' pattern detection
+// Parameters: UART port, baud rate and GPIOs(UART_PIN_NO_CHANGE keeps the default routing)
+// Return: true if the driver is up
+bool UartLink::begin(uart_port_t port, int baudRate, int txPin, int rxPin)
+{
+  end();
+  port_ = port;
+  memset(&stats_, 0, sizeof(stats_));
+
+  uart_config_t uartConfig = {};
+  uartConfig.baud_rate = baudRate;
+  uartConfig.data_bits = UART_DATA_8_BITS;
+  uartConfig.parity = UART_PARITY_DISABLE;
+  uartConfig.stop_bits = UART_STOP_BITS_1;
+  uartConfig.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+  uartConfig.source_clk = UART_SCLK_DEFAULT;
+
+  if (uart_driver_install(port_, UART_RX_BUFFER_SIZE, UART_TX_BUFFER_SIZE, UART_EVENT_QUEUE_LENGTH, &eventQueue_, 0) != ESP_OK)
+  {
+    return false;
+  }
+  installed_ = true;
+
+  if (uart_param_config(port_, &uartConfig) != ESP_OK ||
+      uart_set_pin(port_, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK)
+  {
+    end();
+    return false;
+  }
+
+  // One '\n' with no gap requirements(chr_tout 9, post/pre idle 0) as in the IDF pattern example
+  uart_enable_pattern_det_baud_intr(port_, '\n', 1, 9, 0, 0);
+  uart_pattern_queue_reset(port_, UART_EVENT_QUEUE_LENGTH);
+  return true;
+}
+
+// Description: Uninstalls the driver if it was installed by begin()
+void UartLink::end()
+{
+  if (installed_)
+  {
+    uart_driver_delete(port_);
+    installed_ = false;
+    eventQueue_ = NULL;
+  }
+}
+
+// Description: Hands out the next complete line without blocking
+// Parameters: buffer to copy the line into(null terminated, '\n' and '\r' stripped), its size, length of the line
+// Return: true if a line was copied, false if no complete line is waiting
+bool UartLink::readLine(char *buffer, size_t size, size_t &length)
+{
+  uart_event_t event;
+
+  if (!installed_ || size == 0)
+  {
+    return false;
+  }
+
+  // Only look at what already happened, never wait on the queue
+  while (xQueueReceive(eventQueue_, &event, 0) == pdTRUE)
+  {
+    switch (event.type)
+    {
+    case UART_PATTERN_DET:
+    {
+      // Position of the '\n' in the RX ring buffer, -1 if the position queue overflowed
+      int position = uart_pattern_pop_pos(port_);
+      if (position < 0)
+      {
+        flushInput();
+        break;
+      }
+
+      // Line too long for the caller, drop it along with its '\n'
+      if ((size_t)position >= size)
+      {
+        discard(position + 1);
+        stats_.linesDropped++;
+        break;
+      }
+
+      // Line and its terminator are already in the ring buffer so these reads return immediately
+      int read = uart_read_bytes(port_, buffer, position, 0);
+      char terminator;
+      uart_read_bytes(port_, &terminator, 1, 0);
+
+      length = read > 0 ? read : 0;
+      if (length > 0 && buffer[length - 1] == '\r')
+      {
+        length--;
+      }
+      buffer[length] = '\0';
+
+      stats_.bytesRead += position + 1;
+      stats_.linesRead++;
+      return true;
+    }
+    case UART_FIFO_OVF:
+    case UART_BUFFER_FULL:
+      // Lost bytes, whatever is buffered can't be trusted to line up with the pattern positions
+      stats_.overflows++;
+      flushInput();
+      break;
+    default:
+      // Plain data events just mean a partial line, wait for its '\n'
+      break;
+    }
+  }
+  return false;
+}
+
+// Description: Queues bytes for transmission, returns as soon as they are in the TX ring buffer
+// Parameters: data and its length
+// Return: number of bytes queued
+size_t UartLink::write(const char *data, size_t length)
+{
+  if (!installed_)
+  {
+    return 0;
+  }
+  int written = uart_write_bytes(port_, data, length);
+  if (written > 0)
+  {
+    stats_.bytesWritten += written;
+    return written;
+  }
+  return 0;
+}
+
+// Description: Routes TX straight back into RX inside the UART, used for the loopback benchmark
+void UartLink::setLoopback(bool enable)
+{
+  if (installed_)
+  {
+    uart_set_loop_back(port_, enable);
+  }
+}
+
+void UartLink::flushInput()
+{
+  uart_flush_input(port_);
+  xQueueReset(eventQueue_);
+  uart_pattern_queue_reset(port_, UART_EVENT_QUEUE_LENGTH);
+}
+
+void UartLink::discard(size_t length)
+{
+  char scratch[64];
+  while (length > 0)
+  {
+    int read = uart_read_bytes(port_, scratch, length < sizeof(scratch) ? length : sizeof(scratch), 0);
+    if (read <= 0)
+    {
+      break;
+    }
+    length -= read;
+  }
+}
+
+// Description: Measures line throughput and the longest readLine call over an internal UART loopback
+// Parameters: UART port to borrow and its GPIOs, results are printed on the USB Serial
+// Return: none
+void runUartLoopbackBenchmark(uart_port_t port, int txPin, int rxPin)
+{
+  // Typical glove packet, the loopback stands in for the PC
+  const char packet[] = "A4095B2048C1024D512E0F2048G2048LHJK\n";
+  const size_t packetLength = sizeof(packet) - 1;
+  const int lineCount = 2000;
+  const int baudRates[] = {115200, 921600};
+
+  UartLink link;
+  char line[64];
+  size_t length = 0;
+
+  for (int baudRate : baudRates)
+  {
+    if (!link.begin(port, baudRate, txPin, rxPin))
+    {
+      Serial.println("UART loopback: failed to install driver");
+      return;
+    }
+    link.setLoopback(true);
+
+    // Throughput: keep the TX ring buffer topped up and drain lines as they arrive
+    int sent = 0;
+    int received = 0;
+    unsigned long worstCallUs = 0;
+    unsigned long start = micros();
+    while (received < lineCount && micros() - start < 10000000)
+    {
+      if (sent < lineCount && link.write(packet, packetLength) == packetLength)
+      {
+        sent++;
+      }
+
+      unsigned long callStart = micros();
+      bool gotLine = link.readLine(line, sizeof(line), length);
+      unsigned long callUs = micros() - callStart;
+      worstCallUs = callUs > worstCallUs ? callUs : worstCallUs;
+
+      if (gotLine)
+      {
+        received++;
+      }
+    }
+    unsigned long elapsedUs = micros() - start;
+
+    // Stall: half a line sits in the buffer for 100 ms, readLine must keep returning immediately
+    unsigned long worstPartialUs = 0;
+    link.write(packet, packetLength / 2);
+    start = micros();
+    while (micros() - start < 100000)
+    {
+      unsigned long callStart = micros();
+      link.readLine(line, sizeof(line), length);
+      unsigned long callUs = micros() - callStart;
+      worstPartialUs = callUs > worstPartialUs ? callUs : worstPartialUs;
+    }
+    link.write(packet + packetLength / 2, packetLength - packetLength / 2);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    bool completed = link.readLine(line, sizeof(line), length);
+
+    Serial.printf("UART loopback @%d: %d/%d lines in %lu us (%lu lines/s, %lu B/s), worst readLine %lu us\n",
+                  baudRate, received, lineCount, elapsedUs,
+                  elapsedUs ? (unsigned long)((uint64_t)received * 1000000 / elapsedUs) : 0,
+                  elapsedUs ? (unsigned long)((uint64_t)received * packetLength * 1000000 / elapsedUs) : 0,
+                  worstCallUs);
+    Serial.printf("UART loopback @%d: partial line held 100 ms, worst readLine %lu us, completed %s, overflows %lu\n",
+                  baudRate, worstPartialUs, completed ? "yes" : "no", (unsigned long)link.stats().overflows);
+
+    link.end();
+  }
+}
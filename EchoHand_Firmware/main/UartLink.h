@@ -0,0 +1,53 @@
+#pragma once
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <driver/uart.h>
+#include "config.h"
+
+// Driver ring buffers and event queue depth
+// RX holds several full OpenGloves lines so a burst from the PC never overflows before the task polls
+#define UART_RX_BUFFER_SIZE 1024
+#define UART_TX_BUFFER_SIZE 1024
+#define UART_EVENT_QUEUE_LENGTH 32
+
+// Running counters for the link, reset only on begin()
+struct UartLinkStats
+{
+  uint32_t bytesRead;
+  uint32_t linesRead;
+  uint32_t bytesWritten;
+  uint32_t linesDropped;
+  uint32_t overflows;
+};
+
+// Line based UART link on the ESP-IDF driver.
+// The UART hardware flags every '\n' (pattern detection) and the driver queues an event for it,
+// so readLine only ever copies lines that are already complete and never waits on a partial one.
+// Writes go into the driver's TX ring buffer and are drained by the UART interrupt.
+class UartLink
+{
+public:
+  UartLink();
+  ~UartLink();
+
+  bool begin(uart_port_t port, int baudRate, int txPin, int rxPin);
+  void end();
+  bool readLine(char *buffer, size_t size, size_t &length);
+  size_t write(const char *data, size_t length);
+  void setLoopback(bool enable);
+  const UartLinkStats &stats() const { return stats_; }
+
+private:
+  void flushInput();
+  void discard(size_t length);
+
+  uart_port_t port_;
+  QueueHandle_t eventQueue_;
+  bool installed_;
+  UartLinkStats stats_;
+};
+
+void runUartLoopbackBenchmark(uart_port_t port, int txPin, int rxPin);
@@ -0,0 +1,133 @@
+#include "VibrationControl_task.h"
+
+// Motor PWM channels and envelopes, owned by the vibration task and read by the debug print
+static ESP32PWM motors[5];
+static VibrationEnvelope envelopes[5];
+
+// LEDC budget as ESP32PWM hands it out on the S3, running out halts allocatenext() in a while(1) during setup
+#define LEDC_TIMER_COUNT 4
+#define LEDC_CHANNELS_PER_TIMER 2
+
+// Description: Number of motors in VIBRATION_MOTOR_PINS
+// Parameters: none
+// Return: fitted motor count
+static constexpr uint8_t fittedVibrationMotors()
+{
+    uint8_t count = 0;
+    for (uint8_t pin : VIBRATION_MOTOR_PINS)
+    {
+        count += pin != VIBRATION_NOT_FITTED;
+    }
+    return count;
+}
+
+// Description: LEDC timers a group of channels at one frequency takes
+// Parameters: channel count
+// Return: timer count
+static constexpr uint8_t ledcTimersFor(uint8_t channels)
+{
+    return (channels + LEDC_CHANNELS_PER_TIMER - 1) / LEDC_CHANNELS_PER_TIMER;
+}
+
+// The servos run at 50Hz, motors at another frequency can't share their timers
+static_assert(!VIBRATION_ENABLE || ledcTimersFor(5) + ledcTimersFor(fittedVibrationMotors()) <= LEDC_TIMER_COUNT,
+              "Too many vibration motors for the LEDC timers left by the servos");
+
+// Description: Claims the LEDC channels of the fitted vibration motors and turns them off
+// Called from setup() before the servo task starts so the two never race over ESP32PWM's channel table
+// Parameters: none
+// Return: none
+void setupVibrationMotors()
+{
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        if (VIBRATION_MOTOR_PINS[i] == VIBRATION_NOT_FITTED)
+        {
+            continue;
+        }
+        pinMode(VIBRATION_MOTOR_PINS[i], OUTPUT);
+        motors[i].attachPin(VIBRATION_MOTOR_PINS[i], VIBRATION_PWM_HZ, VIBRATION_PWM_BITS);
+        motors[i].writeFast(0);
+        envelopes[i].setTiming({VIBRATION_ATTACK_MS * 1000, VIBRATION_HOLD_MS * 1000, VIBRATION_DECAY_MS * 1000});
+    }
+}
+
+// Description: Current strength of one motor's envelope
+// Parameters: finger index(thumb to pinkie)
+// Return: strength from 0.0-1.0
+float getVibrationLevel(uint8_t index)
+{
+    return index < 5 ? envelopes[index].level() : 0.0f;
+}
+
+// Description: Turns an envelope strength into a motor duty, lifting weak pulses to the start duty
+// Parameters: strength from 0.0-1.0
+// Return: LEDC duty at VIBRATION_PWM_BITS
+static uint32_t levelToDuty(float level)
+{
+    const uint32_t maxDuty = (1u << VIBRATION_PWM_BITS) - 1;
+    const uint32_t minDuty = (maxDuty * VIBRATION_MIN_DUTY_PERCENT) / 100;
+    if (level <= 0)
+    {
+        return 0;
+    }
+    return minDuty + (uint32_t)lroundf(level * (maxDuty - minDuty));
+}
+
+// Description: Drives the vibration motors from the F commands stored in the DataBroker
+// Parameters: pvParameters which is a place holder for any pointer to any type
+// Return: none
+void TaskVibrationControl(void *pvParameters)
+{
+    // To not get compiler unused variable error
+    (void)pvParameters;
+
+    const TickType_t period = pdMS_TO_TICKS(1000 / VIBRATION_CONTROL_HZ);
+    const uint32_t periodUs = 1000000 / VIBRATION_CONTROL_HZ;
+    TickType_t lastWake = xTaskGetTickCount();
+    uint32_t lastDuty[5] = {0, 0, 0, 0, 0};
+    bool running = false;
+
+    for (;;)
+    {
+        bool newCommand;
+        if (!running)
+        {
+            // Every motor is off, sleep until the communcation task has a new F command
+            newCommand = ulTaskNotifyTake(pdTRUE, portMAX_DELAY) > 0;
+            lastWake = xTaskGetTickCount();
+            restartTaskLoop();
+        }
+        else
+        {
+            // Fixed envelope rate while a motor is running, pick up new commands without waiting
+            xTaskDelayUntil(&lastWake, period);
+            markTaskLoop();
+            newCommand = ulTaskNotifyTake(pdTRUE, 0) > 0;
+        }
+
+        running = false;
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            if (VIBRATION_MOTOR_PINS[i] == VIBRATION_NOT_FITTED)
+            {
+                continue;
+            }
+
+            // Every F command retriggers the pulse, even if its value didn't change
+            if (newCommand)
+            {
+                envelopes[i].trigger((float)DataBroker::instance().getVibrationRPM(i) / VIBRATION_MAX_RPM);
+            }
+
+            // Only touch the LEDC channel when the duty actually changes
+            uint32_t duty = levelToDuty(envelopes[i].update(periodUs));
+            if (duty != lastDuty[i])
+            {
+                motors[i].writeFast(duty);
+                lastDuty[i] = duty;
+            }
+            running = running || !envelopes[i].idle();
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstring>
+#include <cstdio>
+#include <Arduino.h>
+#include <math.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "DataBroker.h"
+#include "TaskTable.h"
+#include "VibrationEnvelope.h"
+#include <ESP32PWM.h>
+
+void setupVibrationMotors();
+float getVibrationLevel(uint8_t index);
+void TaskVibrationControl(void *pvParameters);
@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+
+// Envelope timing of one vibration motor
+struct VibrationEnvelopeTiming
+{
+    uint32_t attackUs; // time to ramp from off to full strength
+    uint32_t holdUs;   // how long a pulse keeps its strength after the last F command
+    uint32_t decayUs;  // time to ramp from full strength back to off
+};
+
+// Attack/hold/decay envelope for one vibration motor, stepped at the fixed vibration control rate.
+// Every F command (re)triggers a pulse at its strength: the level ramps up at the attack slope, holds
+// while F commands keep arriving and decays at the decay slope once they stop or F0 is sent,
+// so a host that goes quiet can never leave a motor running.
+// No Arduino/FreeRTOS dependencies so host tools can run the same code.
+class VibrationEnvelope
+{
+public:
+    // Description: Sets the envelope slopes and the pulse hold time
+    // Parameters: envelope timing
+    // Return: none
+    void setTiming(const VibrationEnvelopeTiming &timing) { timing_ = timing; }
+
+    // Description: Starts or refreshes a pulse
+    // Parameters: strength from 0.0-1.0, 0 lets the current pulse decay right away
+    // Return: none
+    void trigger(float strength)
+    {
+        strength = strength < 0 ? 0 : (strength > 1 ? 1 : strength);
+        peak_ = strength;
+        holdLeftUs_ = strength > 0 ? timing_.holdUs : 0;
+    }
+
+    // Description: Advances the envelope by one control period
+    // Parameters: control period in microseconds
+    // Return: motor strength from 0.0-1.0
+    float update(uint32_t dtUs)
+    {
+        float target = holdLeftUs_ > 0 ? peak_ : 0;
+        holdLeftUs_ = holdLeftUs_ > dtUs ? holdLeftUs_ - dtUs : 0;
+
+        if (level_ < target)
+        {
+            float step = timing_.attackUs > 0 ? (float)dtUs / timing_.attackUs : 1.0f;
+            level_ = level_ + step < target ? level_ + step : target;
+        }
+        else if (level_ > target)
+        {
+            float step = timing_.decayUs > 0 ? (float)dtUs / timing_.decayUs : 1.0f;
+            level_ = level_ - step > target ? level_ - step : target;
+        }
+        return level_;
+    }
+
+    // Description: Checks if the motor is off and nothing will start it until the next trigger
+    // Parameters: none
+    // Return: true when the envelope has nothing left to do
+    bool idle() const { return level_ == 0 && holdLeftUs_ == 0; }
+
+    float level() const { return level_; }
+
+private:
+    VibrationEnvelopeTiming timing_ = {15000, 100000, 60000};
+    float peak_ = 0;
+    float level_ = 0;
+    uint32_t holdLeftUs_ = 0;
+};
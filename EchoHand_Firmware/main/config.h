@@ -1,10 +1,10 @@
 #pragma once
 
-// Stops outputting in openglove format and outputs the persistant state values read
+// Streams the persistant state and servo stats as binary telemetry frames on the USB Serial
+// (TelemetryCodec.h) TELEMETRY_RATE_HZ times a second, host/TelemetryDecode shows them as a table, Serial
+// Plotter lines or CSV. Takes the USB Serial, so the wired link(COMMUNCATION 0) doesn't start
 #define DEBUG_PRINT 0
-
-// Serial Plot values instead of having a readable format
-#define USE_SERIAL_PLOTTER 0
+#define TELEMETRY_RATE_HZ 50
 
 // Use for setting UP AT commands on external bluetooth device
 #define BLUETOOTH_SETUP 0
@@ -13,9 +13,52 @@
 // 0->Wired over Serial
 // 1->Bluetooth Serial
 // 2-> WIFI (ESPNOW)
+// 3-> Native BLE(GATT notifications, no external module)
 // Enable WIFI mode(note bluetooth serial must be set to 0)
 #define COMMUNCATION 2
 
+// ESP-NOW channel(1-13), must match CONFIG_ESPNOW_CHANNEL on the receiver
+#define ESPNOW_CHANNEL 1
+
+// ESP-NOW PHY rate, must match CONFIG_ESPNOW_PHY_RATE on the receiver
+// Lower rates reach further, higher rates spend less time on air per packet
+// 0-> 1 Mbps (802.11b, default)
+// 1-> 2 Mbps (802.11b)
+// 2-> 11 Mbps (802.11b)
+// 3-> 6 Mbps (802.11g)
+// 4-> 24 Mbps (802.11g)
+// 5-> 54 Mbps (802.11g)
+// 6-> MCS7 short GI (802.11n)
+#define ESPNOW_PHY_RATE 0
+
+// Espressif long range mode(500Kbps), overrides ESPNOW_PHY_RATE when enabled
+#define ESPNOW_LONG_RANGE 0
+
+// ESP-NOW send scheduling
+// 0-> Send on every DataBroker change
+// 1-> Adaptive, backs off on failed sends and receiver reported loss (see SendRateController.h)
+#define ADAPTIVE_SEND_RATE 1
+
+// Also run the wired USB serial transport next to the one picked by COMMUNCATION(e.g. USB + ESP-NOW)
+// Needs DEBUG_PRINT 0 since it takes UART0 over from Arduino's Serial
+#define USB_SERIAL_TRANSPORT 0
+
+// Native BLE name the glove advertises as
+#define BLE_DEVICE_NAME "EchoHand"
+
+// Connection interval requested from the central in 1.25ms units(6 -> 7.5ms, the shortest BLE allows)
+#define BLE_CONN_INTERVAL_UNITS 6
+
+// Supervision timeout requested with the interval in 10ms units
+#define BLE_SUPERVISION_TIMEOUT 400
+
+// ATT MTU offered to the central, 185 fits a whole input line in one notification
+#define BLE_MTU 185
+
+// Runs the UART loopback throughput/stall benchmark on the bluetooth UART instead of the serial task
+// Requires COMMUNCATION 0 or 1, results are printed on the USB Serial
+#define UART_LOOPBACK_TEST 0
+
 // Averages values read from flex sensor by x amount
 #define POT_SAMPLE_RATE 16
 
@@ -34,9 +77,146 @@
 // If running Wokawai Simulation
 #define SIMULATION 0
 
-// Servo deadzone used for haptics
+// Servo deadzone used for haptics, targets at or below this many degrees release the finger fully(0)
 #define SERVO_DEADZONE 0
 
+// Servo write deadband in degrees, a moving servo is only rewritten once its output changed by more
+// than this(0-> write on every change, repeats of the same angle are always skipped)
+#define SERVO_WRITE_DEADBAND 0
+
+// Servo motion profile, smooths FFB steps into rate/acceleration limited moves
+// 0-> Write targets straight to the servos on every update
+// 1-> Step the profile at SERVO_CONTROL_HZ (see ServoMotionProfile.h)
+#define SERVO_MOTION_PROFILE 1
+
+// Fixed servo control rate in Hz(must divide the 1kHz FreeRTOS tick)
+#define SERVO_CONTROL_HZ 250
+
+// Idle release, stops the servo pulses on fingers with no resistance requested(see ServoIdlePolicy.h)
+// 0-> Servos always hold position
+// 1-> Release after SERVO_IDLE_RELEASE_MS relaxed, re-engage on the next force request
+#define SERVO_IDLE_RELEASE 1
+#define SERVO_IDLE_RELEASE_MS 500
+
+// Closed loop force control from the servos' pot feedback(see ServoForceControl.h)
+// 0-> Open loop, FFB targets are spool positions
+// 1-> Fingers with a pin in SERVO_FEEDBACK_PINS treat their FFB target as a force(0-180 -> none to stall)
+//     and a PID moves the spool until the force estimated by the acquisition task matches it
+#define SERVO_FORCE_FEEDBACK 0
+
+// Feedback pot voltage with the servo horn at 0 and 180 degrees
+#define SERVO_FEEDBACK_MV_AT_0 300
+#define SERVO_FEEDBACK_MV_AT_180 2700
+
+// Degrees a servo is held off its command when it stalls(full force)
+#define SERVO_STALL_DEFLECTION_DEG 10
+
+// Force estimate low pass, weight of each new sample(1-> no filtering)
+#define SERVO_FORCE_FILTER 0.5f
+
+// Force PID gains, tuned with host/SpoolForceSimulation.cpp
+#define SERVO_FORCE_KP 10.0f
+#define SERVO_FORCE_KI 800.0f
+#define SERVO_FORCE_KD 0.0f
+
+// How FFB targets drive fingers without force feedback
+// 0-> The spool goes straight to the commanded angle when the target arrives
+// 1-> Pre-positioned, once the finger's predicted curl is within FFB_PREPOSITION_REACH of a commanded limit the
+//     spool shadows it FFB_PREPOSITION_SLACK ahead and settles on the limit as the finger reaches it, so a late
+//     target only has the slack to travel(see FingerPrediction.h, keeps the servos engaged near the limit)
+// 2-> Local stop, pre-positioned like 1 but the target is a stop curl the glove enforces itself:
+//     the spool locks when the measured curl reaches it, tightens out any give and unlocks when the finger opens
+// Modes 1 and 2 are untested on the glove, keep 0 until they are
+#define FFB_TARGET_MODE 0
+
+// How far ahead the finger's curl is predicted, covers the servo's travel and the control period
+#define FFB_PREDICT_LEAD_MS 40
+
+// Free curl(0.0-1.0) kept between the finger and the pre-positioned spool
+#define FFB_PREPOSITION_SLACK 0.15f
+
+// Curl(0.0-1.0) short of the limit where the spool starts shadowing the finger, further away it stays at 0
+#define FFB_PREPOSITION_REACH 0.3f
+
+// Local stop(FFB_TARGET_MODE 2), curl the finger has to open past the stop to unlock and
+// how fast curl past the stop tightens the spool(degrees per second per unit of curl)
+#define FFB_STOP_HYSTERESIS 0.05f
+#define FFB_STOP_CORRECTION_GAIN 600.0f
+
+// Finger velocity low pass, weight of each new sample(1-> no filtering)
+#define FFB_VELOCITY_FILTER 0.5f
+
+// LEDC timer width for the servos in bits(10-14 on the S3), 14 gives about 8 ticks per degree
+#define SERVO_TIMER_WIDTH 14
+
+// Times write(), writeMicroseconds() and the integer writeAngleFast() for all five servos
+// at startup and prints the results on the USB Serial before the servo task starts
+#define SERVO_WRITE_BENCHMARK 0
+
+// Vibration motors(ERM) driven by the OpenGloves F command(see VibrationEnvelope.h)
+// 0-> F is only stored in the DataBroker
+// 1-> Run the vibration task on the motors in VIBRATION_MOTOR_PINS(fit them there first)
+#define VIBRATION_ENABLE 0
+
+// Fixed vibration envelope rate in Hz while a motor is running(must divide the 1kHz FreeRTOS tick)
+#define VIBRATION_CONTROL_HZ 500
+
+// Motor PWM carrier, above hearing so only the motor's own vibration is felt
+#define VIBRATION_PWM_HZ 20000
+#define VIBRATION_PWM_BITS 10
+
+// Motor speed at full duty, F(Hz) * 60 is scaled against this for the pulse strength
+#define VIBRATION_MAX_RPM 12000
+
+// Lowest duty in percent that still starts the motor, weaker pulses are lifted to it
+#define VIBRATION_MIN_DUTY_PERCENT 30
+
+// Pulse envelope, a pulse holds for VIBRATION_HOLD_MS after the last F command then decays
+#define VIBRATION_ATTACK_MS 15
+#define VIBRATION_HOLD_MS 100
+#define VIBRATION_DECAY_MS 60
+
+// Task profiler, prints each task's CPU share, stack use and loop timing plus the heap on the USB Serial
+// every TASK_PROFILER_PERIOD_MS(interleaves with the wired stream)
+// Needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, left off in sdkconfig since
+// they add run time accounting to every context switch, turn them on in menuconfig with the profiler
+#define TASK_PROFILER 0
+#define TASK_PROFILER_PERIOD_MS 2000
+
+// Hot path microbenchmarks(filters, calibration, DataBroker, OpenGloves codec, readSmooth with the ADC, see
+// HotPathBenchmarks.h), run once at boot on core 1 and printed on the USB Serial with CPU cycle counts and as JSON
+// for Testing/bench_compare.py. Holds off the other core 1 tasks while it runs
+#define HOT_PATH_BENCHMARK 0
+
+// Hot path trace, per core rings of cycle stamped events(sampling, filters, DataBroker, encode, esp_now_send,
+// FFB parse, servo writes, see TraceRing.h) printed on the USB Serial when the PC sends a "!" line on any link(over
+// ESP-NOW the receiver forwards it) or every TRACE_DUMP_PERIOD_MS(0-> on request only), host/TraceDecode turns a
+// dump into a Perfetto timeline.
+// The rings keep the newest TRACE_RING_RECORDS records per core(power of 2, 8 bytes each), a dump should follow
+// its oldest record within ~17 s, the cycle counter's wrap at 240 MHz
+#define HOT_PATH_TRACE 0
+#define TRACE_RING_RECORDS 2048
+#define TRACE_DUMP_PERIOD_MS 0
+
+// Raw sensor capture, streams every ADC burst of each acquisition pass before filtering, the glove's finger values
+// and its calibration as framed records(SensorRecording.h) on the USB Serial for host/SensorRecorder, replayed by
+// host/SensorReplay and host/FirmwareSimulation. Passes that don't fit the RAW_CAPTURE_BUFFER_BYTES ring(power of 2)
+// are dropped, calibration reads faster than the link so most of its passes are. Takes the USB Serial like
+// DEBUG_PRINT
+#define RAW_SENSOR_CAPTURE 0
+#define RAW_CAPTURE_BUFFER_BYTES 8192
+
+// Task allocation
+// 0-> Task stacks and control blocks are allocated from the heap
+// 1-> Reserved statically at link time(xTaskCreateStaticPinnedToCore), the boot no longer fragments the heap
+#define TASK_STATIC_ALLOCATION 1
+
+// Heap watch, aborts with a backtrace as soon as a task marked heap free in main.cpp's task table allocates
+// after its first loop pass, for catching allocations that would fragment the heap over long sessions
+// Needs CONFIG_HEAP_USE_HOOKS, left off in sdkconfig since it puts a hook call in every malloc and free,
+// turn it on in menuconfig with the watch
+#define HEAP_WATCH 0
+
 // Pot enabled
 #define JOYSTICK_ENABLE 0
 
@@ -56,6 +236,24 @@ inline constexpr uint8_t MIDDLE_SERVO = 36;
 inline constexpr uint8_t RING_SERVO = 37;
 inline constexpr uint8_t PINKIE_SERVO = 38;
 
+// Servo motion limits per finger(thumb, index, middle, ring, pinkie)
+// Velocity in degrees/s, acceleration in degrees/s^2
+inline constexpr float SERVO_MAX_VELOCITY[5] = {600.0f, 600.0f, 600.0f, 600.0f, 600.0f};
+inline constexpr float SERVO_MAX_ACCELERATION[5] = {20000.0f, 20000.0f, 20000.0f, 20000.0f, 20000.0f};
+
+// Servo pot feedback ADC channels per finger(thumb, index, middle, ring, pinkie), SERVO_FEEDBACK_NOT_FITTED for none
+// Use ADC1 pins(GPIO1-10), ADC2 can't be read while WiFi/ESP-NOW is running
+inline constexpr uint8_t SERVO_FEEDBACK_NOT_FITTED = 0xFF;
+inline constexpr uint8_t SERVO_FEEDBACK_PINS[5] = {SERVO_FEEDBACK_NOT_FITTED, SERVO_FEEDBACK_NOT_FITTED, SERVO_FEEDBACK_NOT_FITTED,
+                                                   SERVO_FEEDBACK_NOT_FITTED, SERVO_FEEDBACK_NOT_FITTED};
+
+// Vibration motors per finger(thumb, index, middle, ring, pinkie), VIBRATION_NOT_FITTED for none
+// The S3 has 4 LEDC timers with 2 channels each and a timer runs at one frequency, the 5 servos at 50Hz take 3 of
+// them so at most 2 motors can be fitted(checked at compile time in VibrationControl_task.cpp)
+inline constexpr uint8_t VIBRATION_NOT_FITTED = 0xFF;
+inline constexpr uint8_t VIBRATION_MOTOR_PINS[5] = {VIBRATION_NOT_FITTED, VIBRATION_NOT_FITTED, VIBRATION_NOT_FITTED,
+                                                    VIBRATION_NOT_FITTED, VIBRATION_NOT_FITTED};
+
 // Joystick and buttons
 inline constexpr uint8_t JOYSTICK_BUTTON = 11;
 inline constexpr uint8_t JOYSTICK_X = 9;
@@ -63,6 +261,11 @@ inline constexpr uint8_t JOYSTICK_Y = 10;
 inline constexpr uint8_t A_BUTTON = 12;
 inline constexpr uint8_t B_BUTTON = 15;
 
+// USB serial(UART0 through the devkit's USB bridge)
+inline constexpr uint8_t USB_UART_TX = 43;
+inline constexpr uint8_t USB_UART_RX = 44;
+
 // Bluetooth Buttons
 inline constexpr uint8_t BLUETOOTH_RX = 18;
 inline constexpr uint8_t BLUETOOTH_TX = 17;
+inline constexpr uint8_t BLUETOOTH_KEY = 42;
@@ -8,13 +8,74 @@
 
 // Import all tasks
 #include "AnalogRead_task.h"
-#include "SerialCommunication_task.h"
 #include "DataBrokerPrint_task.h"
 #include "ServoControl_task.h"
-#include "WifiCommuncation.h"
+#include "VibrationControl_task.h"
+#include "Communication_task.h"
+#include "TaskProfiler_task.h"
+#include "Benchmark_task.h"
+#include "TraceRing.h"
+#include "SensorCapture.h"
+#include "TaskTable.h"
+
+// Import all transports
+#include "SerialTransport.h"
+#include "EspNowTransport.h"
+#include "BleTransport.h"
 
 // Allocate memory for servo task handler
 TaskHandle_t xServoTaskHandle = NULL;
+TaskHandle_t xVibrationTaskHandle = NULL;
+
+// Link picked by COMMUNCATION, resolved at compile time so its comms loop has no virtual calls
+#if COMMUNCATION == 0
+static SerialTransport mainTransport(UART_NUM_0, USB_UART_TX, USB_UART_RX, 115200);
+#elif COMMUNCATION == 1
+static SerialTransport mainTransport(UART_NUM_1, BLUETOOTH_TX, BLUETOOTH_RX, 115200, BLUETOOTH_KEY);
+#elif COMMUNCATION == 2
+static EspNowTransport mainTransport;
+#else
+static BleTransport mainTransport;
+#endif
+
+// Optional USB serial link running next to the main one
+#if USB_SERIAL_TRANSPORT && COMMUNCATION != 0
+static SerialTransport usbTransport(UART_NUM_0, USB_UART_TX, USB_UART_RX, 115200);
+#endif
+
+// Every task the glove runs, created in this order by startTasks()
+// The communcation loops of the serial and ESP-NOW transports never block, they stay at priority 0 so they
+// share core 0 with its idle task instead of starving it.
+// Heap free loops are checked by HEAP_WATCH, the ESP-NOW and BLE stacks allocate per packet and Serial.printf
+// allocates for long lines so those loops aren't
+static constexpr TaskSpec tasks[] = {
+    // Function, name, stack(bytes), priority(0->lowest), core, loop period(ms, 0-> none), parameters, handle, enabled, heap free
+    {TaskDataBrokerPrint, "DataBrokerPrint", 4096, 0, 0, 1000 / TELEMETRY_RATE_HZ, NULL, NULL, DEBUG_PRINT, true},
+    {TaskAnalogRead, "AnalogRead", 8192, 0, 1, 20, NULL, NULL, true, true},
+    {TaskBluetoothSetup, "BluetoothSetup", 8192, 0, 0, 0, NULL, NULL, BLUETOOTH_SETUP, false},
+    {TaskUartLoopbackTest, "UartLoopbackTest", 8192, 0, 0, 0, NULL, NULL, !BLUETOOTH_SETUP && UART_LOOPBACK_TEST, false},
+    // Comms loop specialised for the main transport
+    {TaskCommunication<decltype(mainTransport)>, "Communication", 8192, 0, 0, 0, &mainTransport, NULL,
+     !BLUETOOTH_SETUP && !UART_LOOPBACK_TEST, COMMUNCATION == 0 || COMMUNCATION == 1},
+#if USB_SERIAL_TRANSPORT && COMMUNCATION != 0
+    // Comms loop specialised for the USB serial transport
+    {TaskCommunication<SerialTransport>, "UsbCommunication", 8192, 0, 0, 0, &usbTransport, NULL,
+     !BLUETOOTH_SETUP && !UART_LOOPBACK_TEST, true},
+#endif
+    {TaskVibrationControl, "VibrationControl", 4096, 1, 1, 1000 / VIBRATION_CONTROL_HZ, NULL, &xVibrationTaskHandle, VIBRATION_ENABLE, true},
+    {TaskServoControl, "ServoControl", 8192, 1, 1, 1000 / SERVO_CONTROL_HZ, NULL, &xServoTaskHandle, true, true},
+    {TaskProfiler, "TaskProfiler", 4096, 0, 0, TASK_PROFILER_PERIOD_MS, NULL, NULL, TASK_PROFILER, false},
+    {TaskBenchmark, "Benchmark", 8192, 2, 1, 0, NULL, NULL, HOT_PATH_BENCHMARK, false},
+    {TaskTraceDump, "TraceDump", 4096, 0, 0, TRACE_DUMP_PERIOD_MS, NULL, &xTraceDumpTaskHandle, HOT_PATH_TRACE, false},
+    {TaskSensorCapture, "SensorCapture", 4096, 0, 0, 10, NULL, NULL, RAW_SENSOR_CAPTURE, true},
+};
+static constexpr size_t taskCount = sizeof(tasks) / sizeof(tasks[0]);
+static_assert(taskCount <= TASK_TABLE_MAX, "Task table has more rows than TASK_TABLE_MAX");
+
+#if TASK_STATIC_ALLOCATION
+// Stacks of every enabled task, stack depth is in bytes on IDF
+alignas(16) static StackType_t taskStacks[taskStackPoolBytes(tasks, taskCount)];
+#endif
 
 void setup()
 {
@@ -24,64 +85,17 @@ void setup()
     // Debug Print
     Serial.println("Starting FreeRTOS Setup...");
 
-    if (DEBUG_PRINT)
-    {
-        xTaskCreatePinnedToCore(
-            TaskDataBrokerPrint, // Fucntion name of Task
-            "DataBrokerPrint",   // Name of Task
-            8192,                // Stack size (bytes) for task
-            NULL,                // Parameters(none)
-            0,                   // Priority level(0->Lowest)
-            NULL,                // Task handle(for RTOS API maniuplation)
-            0                    // Run on core 0
-        );
-    }
-
-    // Create the task
-    xTaskCreatePinnedToCore(
-        TaskAnalogRead, // Fucntion name of Task
-        "AnalogRead",   // Name of Task
-        8192,           // Stack size (bytes) for task
-        NULL,           // Parameters(none)
-        0,              // Priority level(0->lowest)
-        NULL,           // Task handle(for RTOS API maniuplation)
-        1               // Run on core 1
-    );
-
-    if (COMMUNCATION <= 1)
-    {
-        xTaskCreatePinnedToCore(
-            TaskSerialCommunication, // Fucntion name of Task
-            "SerialCommunication",   // Name of Task
-            8192,                    // Stack size (bytes) for task
-            NULL,                    // Parameters(none)
-            0,                       // Priority level(1->highest)
-            NULL,                    // Task handle(for RTOS API maniuplation)
-            0                        // Run on core 0
-        );
-    }
-    else
+    if (VIBRATION_ENABLE)
     {
-        xTaskCreatePinnedToCore(
-            TaskWifiCommunication, // Fucntion name of Task
-            "WifiCommunication",   // Name of Task
-            8192,                  // Stack size (bytes) for task
-            NULL,                  // Parameters(none)
-            0,                     // Priority level(1->highest)
-            NULL,                  // Task handle(for RTOS API maniuplation)
-            0                      // Run on core 0
-        );
+        // Motor channels are claimed before the servo task attaches its own
+        setupVibrationMotors();
     }
 
-    xTaskCreatePinnedToCore(
-        TaskServoControl,  // Fucntion name of Task
-        "ServoControl",    // Name of Task
-        8192,              // Stack size (bytes) for task
-        NULL,              // Parameters(none)
-        1,                 // Priority level(1->highest)
-        &xServoTaskHandle, // Task handle(for RTOS API maniuplation)
-        1                  // Run on core 1
-    );
+#if TASK_STATIC_ALLOCATION
+    startTasks(tasks, taskCount, taskStacks, sizeof(taskStacks));
+#else
+    startTasks(tasks, taskCount);
+#endif
 }
 
 extern "C" void app_main()
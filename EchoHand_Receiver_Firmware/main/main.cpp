@@ -4,7 +4,28 @@
 #include <string>
 #include <WiFi.h>
 #include <esp_now.h>
+#include <esp_wifi.h>
+#include "sdkconfig.h"
 #include "Arduino.h"
+#include "EspNowLink.h"
+
+// How long to wait for the glove's ack before dropping a radio command(ms)
+#define RADIO_ACK_TIMEOUT_MS 200
+
+// PHY rate table, index is CONFIG_ESPNOW_PHY_RATE
+// Keep in sync with the table in EchoHand_Firmware/main/EspNowRadio.cpp
+static const esp_now_rate_config_t phyRateTable[ESPNOW_PHY_RATE_COUNT] = {
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_1M_L, false, false},
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_2M, false, false},
+    {WIFI_PHY_MODE_11B, WIFI_PHY_RATE_11M_L, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_6M, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_24M, false, false},
+    {WIFI_PHY_MODE_11G, WIFI_PHY_RATE_54M, false, false},
+    {WIFI_PHY_MODE_HT20, WIFI_PHY_RATE_MCS7_SGI, false, false},
+};
+
+// Long range trades rate for sensitivity, 500Kbps is the faster of the two LR rates
+static const esp_now_rate_config_t longRangeRate = {WIFI_PHY_MODE_LR, WIFI_PHY_RATE_LORA_500K, false, false};
 
 // Global to copy analog data
 char analog_data[56];
@@ -12,9 +33,53 @@ char analog_data[56];
 // Is there valid data
 volatile bool new_data = false;
 
+// How often the measured loss is reported back to the glove
+#define LINK_FEEDBACK_PERIOD_MS 200
+
+// Running frame counters from the glove's sequence numbers, only written by the receive callback
+volatile uint32_t frames_received = 0;
+volatile uint32_t frames_lost = 0;
+bool sequence_valid = false;
+uint16_t last_sequence = 0;
+
+// Frames of any kind from the glove, tells the radio switch there is traffic on the new settings
+volatile uint32_t radio_frames = 0;
+
+// Last ack from the glove(null terminated) and whether a probe needs answering, written by the receive callback
+char radio_ack[16];
+volatile bool radio_ack_new = false;
+volatile bool radio_probe_received = false;
+
+// Runtime radio switch: waits for the glove's ack, then keeps the new settings on trial until a frame arrives on them
+enum RadioSwitchState
+{
+  RADIO_STEADY,
+  RADIO_AWAITING_ACK,
+  RADIO_ON_TRIAL
+};
+
 // Global for received data(finger angles, buttons and etc)
 void on_data_receive(const esp_now_recv_info_t *esp_now_info, const uint8_t *incoming_data, int len)
 {
+  radio_frames = radio_frames + 1;
+
+  // Radio acks and probes stay between the radios, OpenGloves never sees them
+  if (len > 0 && incoming_data[0] == RADIO_ACK_PREFIX)
+  {
+    if (len > 2)
+    {
+      int ack_len = len < (int)sizeof(radio_ack) - 1 ? len : (int)sizeof(radio_ack) - 1;
+      memcpy(radio_ack, incoming_data, ack_len);
+      radio_ack[ack_len] = '\0';
+      radio_ack_new = true;
+    }
+    else
+    {
+      radio_probe_received = true;
+    }
+    return;
+  }
+
   // Prevent buffer overflow and ensure null-termination
   int copy_len = len < 55 ? len : 55;
 
@@ -24,10 +89,105 @@ void on_data_receive(const esp_now_recv_info_t *esp_now_info, const uint8_t *inc
   // Ensure null-terminator
   analog_data[copy_len] = '\0';
 
+  // Frames from the glove carry a little endian sequence number right after the null terminator
+  int string_len = strnlen((const char *)incoming_data, len);
+  if (len >= string_len + 3)
+  {
+    uint16_t sequence = incoming_data[string_len + 1] | (incoming_data[string_len + 2] << 8);
+    uint16_t gap = sequence - last_sequence - 1;
+
+    // Ignore huge gaps, that's the glove rebooting rather than frames going missing
+    if (sequence_valid && gap < 1000)
+    {
+      frames_lost = frames_lost + gap;
+    }
+    last_sequence = sequence;
+    sequence_valid = true;
+    frames_received = frames_received + 1;
+  }
+
   // Print valid data
   new_data = true;
 }
 
+// Parses radio fields ("C<channel>R<rate>L<0/1>", what follows the prefix of a command or ack), any may be left out
+// Returns false and leaves settings untouched if the fields are malformed
+bool parse_radio_fields(const char *fields, EspNowRadioSettings &settings)
+{
+  EspNowRadioSettings parsed = settings;
+  const char *currentByte = fields;
+
+  while (*currentByte != '\0' && *currentByte != '\n' && *currentByte != '\r')
+  {
+    char field = *currentByte;
+    currentByte++;
+
+    if (*currentByte < '0' || *currentByte > '9')
+    {
+      return false;
+    }
+
+    int intValue = 0;
+    while (*currentByte >= '0' && *currentByte <= '9')
+    {
+      intValue = (intValue * 10) + (*currentByte - '0');
+      currentByte++;
+    }
+
+    switch (field)
+    {
+    case 'C':
+      if (intValue < 1 || intValue > 13)
+        return false;
+      parsed.channel = intValue;
+      break;
+    case 'R':
+      if (intValue >= ESPNOW_PHY_RATE_COUNT)
+        return false;
+      parsed.phyRate = intValue;
+      break;
+    case 'L':
+      parsed.longRange = (intValue != 0);
+      break;
+    default:
+      return false;
+    }
+  }
+
+  settings = parsed;
+  return true;
+}
+
+// Parses a radio control line ("$C<channel>R<rate>L<0/1>")
+bool parse_radio_command(const char *command, EspNowRadioSettings &settings)
+{
+  return *command == RADIO_COMMAND_PREFIX && parse_radio_fields(command + 1, settings);
+}
+
+bool same_radio_settings(const EspNowRadioSettings &a, const EspNowRadioSettings &b)
+{
+  return a.channel == b.channel && a.phyRate == b.phyRate && a.longRange == b.longRange;
+}
+
+// Applies channel, long range mode and PHY rate to the Wi-Fi driver and the glove peer
+void apply_radio_settings(esp_now_peer_info_t &peerInfo, const EspNowRadioSettings &settings)
+{
+  uint8_t protocol = WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N;
+  if (settings.longRange)
+  {
+    protocol |= WIFI_PROTOCOL_LR;
+  }
+  esp_wifi_set_protocol(WIFI_IF_STA, protocol);
+  esp_wifi_set_channel(settings.channel, WIFI_SECOND_CHAN_NONE);
+
+  // Peer has to follow the channel or esp_now_send will reject it
+  peerInfo.channel = settings.channel;
+  esp_now_mod_peer(&peerInfo);
+
+  esp_now_rate_config_t rateConfig = settings.longRange ? longRangeRate : phyRateTable[settings.phyRate];
+  esp_now_set_peer_rate_config(peerInfo.peer_addr, &rateConfig);
+}
+
 extern "C" void app_main()
 {
   // Initalize Arduino
@@ -73,17 +233,45 @@ extern "C" void app_main()
     Serial.println("Failed to add peer MAC Address.");
   }
 
+  // Apply channel, PHY rate and long range mode from menuconfig
+#if CONFIG_ESPNOW_ENABLE_LONG_RANGE
+  EspNowRadioSettings radioSettings = {CONFIG_ESPNOW_CHANNEL, CONFIG_ESPNOW_PHY_RATE, true};
+#else
+  EspNowRadioSettings radioSettings = {CONFIG_ESPNOW_CHANNEL, CONFIG_ESPNOW_PHY_RATE, false};
+#endif
+  apply_radio_settings(peerInfo, radioSettings);
+
+#if CONFIG_ESPNOW_ENABLE_POWER_SAVE
+  // Only listen during the wake window of every wake interval
+  esp_now_set_wake_window(CONFIG_ESPNOW_WAKE_WINDOW);
+  esp_wifi_connectionless_module_set_wake_interval(CONFIG_ESPNOW_WAKE_INTERVAL);
+#endif
+
   // Register callback for data received
   esp_now_register_recv_cb(on_data_receive);
 
   // String for Servo payload
   char output_string[256];
 
+  // Radio switch in progress
+  RadioSwitchState radio_state = RADIO_STEADY;
+  EspNowRadioSettings pending_radio = radioSettings;
+  EspNowRadioSettings previous_radio = radioSettings;
+  unsigned long radio_state_since = 0;
+  uint32_t trial_frames = 0;
+
+  // Counters at the last loss report
+  uint32_t reported_received = 0;
+  uint32_t reported_lost = 0;
+  unsigned long last_feedback = millis();
+
   for (;;)
   {
     // Check if we got a servo packet
     // If we have data available to read, parse it and update servo targets
-    if (Serial.available() > 10)
+    // Radio and trace dump commands are shorter than a servo packet so let them through as soon as they arrive
+    int next = Serial.available() > 0 ? Serial.peek() : -1;
+    if (Serial.available() > 10 || next == RADIO_COMMAND_PREFIX || next == TRACE_DUMP_COMMAND)
     {
       // Use readBytesUntil to safely read a full line into the buffer with a timeout, unlike with just using read
       size_t len = Serial.readBytesUntil('\n', output_string, sizeof(output_string) - 1);
@@ -94,6 +282,60 @@ extern "C" void app_main()
       // Send the constructed string as one STRING(+ null terminator)
       // len+1 since arrays are 0 indexed
       esp_now_send(broadcastAddress, (uint8_t *)output_string, len + 1);
+
+      // Radio command, forwarded to the glove on the old settings, we only follow once the glove acks it
+      EspNowRadioSettings newSettings = radioSettings;
+      if (parse_radio_command(output_string, newSettings))
+      {
+        pending_radio = newSettings;
+        radio_state = RADIO_AWAITING_ACK;
+        radio_state_since = millis();
+      }
+    }
+
+    // The glove acked on the old settings and is switching, follow it and keep the old settings to fall back on
+    if (radio_ack_new)
+    {
+      radio_ack_new = false;
+      EspNowRadioSettings acked = radioSettings;
+      if (radio_state == RADIO_AWAITING_ACK && parse_radio_fields(radio_ack + 1, acked) && same_radio_settings(acked, pending_radio))
+      {
+        previous_radio = radioSettings;
+        radioSettings = pending_radio;
+        apply_radio_settings(peerInfo, radioSettings);
+        trial_frames = radio_frames;
+        radio_state = RADIO_ON_TRIAL;
+        radio_state_since = millis();
+      }
+    }
+
+    // No ack, the glove didn't get the command(or we didn't get the ack and the glove will revert on its own)
+    if (radio_state == RADIO_AWAITING_ACK && millis() - radio_state_since >= RADIO_ACK_TIMEOUT_MS)
+    {
+      radio_state = RADIO_STEADY;
+    }
+
+    // Any frame from the glove on the new settings confirms them, without one both ends go back
+    if (radio_state == RADIO_ON_TRIAL)
+    {
+      if (radio_frames != trial_frames)
+      {
+        radio_state = RADIO_STEADY;
+      }
+      else if (millis() - radio_state_since >= RADIO_REVERT_TIMEOUT_MS)
+      {
+        radioSettings = previous_radio;
+        apply_radio_settings(peerInfo, radioSettings);
+        radio_state = RADIO_STEADY;
+      }
+    }
+
+    // Answer the glove's probes so it knows the new settings work at this end too
+    if (radio_probe_received)
+    {
+      radio_probe_received = false;
+      static const char probe[] = {RADIO_ACK_PREFIX, '\0'};
+      esp_now_send(broadcastAddress, (const uint8_t *)probe, sizeof(probe));
     }
 
     if (new_data == true)
@@ -105,6 +347,24 @@ extern "C" void app_main()
       new_data = false;
     }
 
+    // Periodically tell the glove how many of its frames went missing so it can adapt its send rate
+    if (millis() - last_feedback >= LINK_FEEDBACK_PERIOD_MS)
+    {
+      last_feedback = millis();
+
+      uint32_t received = frames_received - reported_received;
+      uint32_t lost = frames_lost - reported_lost;
+      reported_received += received;
+      reported_lost += lost;
+
+      if (received + lost > 0)
+      {
+        char feedback[16];
+        int feedback_len = snprintf(feedback, sizeof(feedback), "%cL%lu", LINK_FEEDBACK_PREFIX, (unsigned long)((lost * 1000) / (received + lost)));
+        esp_now_send(broadcastAddress, (uint8_t *)feedback, feedback_len + 1);
+      }
+    }
+
     vTaskDelay(1);
   }
 }
@@ -1,36 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <raylib.h>
 #include <raymath.h>
 #include <iostream>
 #include <cstring>
-
-struct OpenGlovesData
-{
-    // Thumb, Index, Middle, Ring, Pinky (0-1)
-    std::array<float, 5> fingerCurl = {0};       
-    
-    // Individual joints
-    std::array<std::array<float, 4>, 5> jointCurl = {{{0}}}; 
-    
-    // Finger splay
-    std::array<float, 5> splay = {0};            
-    
-    float joystickX = 0.0f;
-    float joystickY = 0.0f;
-    bool joystickButton = false;
-    
-    bool buttonTrigger = false;
-    bool buttonA = false;
-    bool buttonB = false;
-    bool buttonGrab = false;
-    bool buttonSystem = false;
-    bool buttonCalibrate = false;
-    
-    float triggerAnalog = 0.0f;
-};
+#include "opengloves.h"
 
 // Camera controller
 struct CameraController
@@ -103,25 +80,31 @@ struct ProceduralHand
     bool isInitialized = false;
 };
 
+// Distance between the copies of the hand(--hands)
+#define HAND_SPACING 0.6f
+
+class HandRenderer;
+
 // Legacy HandModel for compatibility (not used in procedural version)
 struct HandModel
 {
     bool isLoaded = false;
 };
 
-void initializeWindow();
+void initializeWindow(int targetFps = 60, int handCount = 1);
 bool userAttemptedClose();
 void initGloveRendering();
 void cleanupGloveRendering();
 void updateGloveObject(const char *payload);
 void updateGloveObject(const std::string &payload);
+void applyGloveData(const OpenGlovesData &data);
+void setLinkStats(uint64_t packets, float packetsPerSecond, bool open);
 void drawGloveObject();
 
 // Internal functions
 void initProceduralHand(ProceduralHand &hand);
 void updateHandPose(ProceduralHand &hand, const OpenGlovesData &data);
-void drawProceduralHand(const ProceduralHand &hand);
-void parseOpenGlovesPayload(const char *payload, OpenGlovesData &data);
+void drawProceduralHand(HandRenderer &renderer, const ProceduralHand &hand);
 void updateCamera(CameraController &controller, float deltaTime);
 void drawUI(const OpenGlovesData &data);
 
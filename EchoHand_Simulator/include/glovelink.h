@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "opengloves.h"
+
+// Glove link on its own I/O thread, kept free of raylib and the transports so host tools can build it
+// The I/O thread reads lines from the serial port or TCP socket and parses every one of them, the render loop
+// picks up the newest state at its own frame rate. A slow link no longer freezes the window and a fast one no
+// longer ties frame draws to packet arrival.
+
+// Latest value handed from one writer thread to one reader thread without locks(triple buffer)
+// The writer fills writeBuffer() and publishes it, the reader takes the newest published buffer, neither waits
+template <typename T>
+class LatestSlot
+{
+    static constexpr uint8_t FRESH = 0x4;
+
+    T buffers[3];
+
+    // Buffer between the two sides, FRESH while the writer published it and the reader hasn't taken it
+    std::atomic<uint8_t> middle{1};
+    uint8_t writeIndex = 0;
+    uint8_t readIndex = 2;
+
+public:
+    T &writeBuffer() { return buffers[writeIndex]; }
+
+    void publish()
+    {
+        writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & 3;
+    }
+
+    // True if a newer value was published since the last call, read() returns it
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_acquire) & FRESH))
+        {
+            return false;
+        }
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & 3;
+        return true;
+    }
+
+    const T &read() const { return buffers[readIndex]; }
+};
+
+// Longest run of bytes without a new line LineBuffer keeps, anything longer isn't OpenGloves data
+#define LINE_BUFFER_MAX_BYTES 65536
+
+// Splits a byte stream into lines, bytes are appended at the end and lines taken from the front
+// Taken lines are dropped by moving a read offset, the buffer is only compacted once that passes half of it, so
+// a burst of many lines costs linear time instead of an erase per line
+class LineBuffer
+{
+    std::vector<char> data;
+    size_t start = 0;
+    size_t scanned = 0;
+
+public:
+    void append(const char *bytes, size_t length);
+    bool next(std::string &line);
+};
+
+// Where the I/O thread reads lines from
+// Returns 1 with a line(without its '\n'), 0 if none came in for a while, -1 once the link is closed
+typedef std::function<int(std::string &line)> GloveLineSource;
+
+class GloveLink
+{
+    std::thread ioThread;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> open{false};
+    std::atomic<uint64_t> packets{0};
+    LatestSlot<OpenGlovesData> latest;
+
+    void run(GloveLineSource source);
+
+public:
+    ~GloveLink();
+    void start(GloveLineSource source);
+    void stop();
+    bool isOpen() const { return open.load(); }
+    uint64_t packetCount() const { return packets.load(); }
+    bool takeLatest(OpenGlovesData &data);
+};
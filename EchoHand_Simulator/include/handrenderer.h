@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <raylib.h>
+#include <raymath.h>
+
+// Instanced drawing of the procedural hands
+// The hand is made of a few unit meshes(sphere, cylinder, tapered cylinder, cube) that are generated and uploaded
+// once. Each frame the hands add their parts as transforms, parts of the same mesh and color are drawn together with
+// one DrawMeshInstanced call. The draw calls stay the same whatever the number of hands and no geometry is built on
+// the CPU per frame, unlike DrawSphere/DrawCylinderEx/DrawCapsule which rebuild every part through rlgl.
+
+// Rings and slices of the sphere mesh and slices of the cylinder mesh, what DrawSphere and the finger capsules used
+#define HAND_SPHERE_RINGS 16
+#define HAND_SPHERE_SLICES 16
+#define HAND_CYLINDER_SLICES 16
+
+// Top radius over bottom radius and slices of the tapered cylinder mesh, what the wrist's DrawCylinderEx used
+#define HAND_TAPER_RATIO 0.8f
+#define HAND_WRIST_SLICES 12
+
+enum HandMesh
+{
+    HAND_MESH_SPHERE,
+    HAND_MESH_CYLINDER,
+    HAND_MESH_TAPERED_CYLINDER,
+    HAND_MESH_CUBE,
+    HAND_MESH_COUNT
+};
+
+class HandRenderer
+{
+    // Parts of one mesh in one color
+    struct Batch
+    {
+        HandMesh mesh;
+        Color color;
+        std::vector<Matrix> transforms;
+    };
+
+    Mesh meshes[HAND_MESH_COUNT] = {};
+    Material material = {};
+    Shader instancingShader = {};
+    bool loaded = false;
+
+    // False if the GPU can't take the instancing shader, parts are then drawn one DrawMesh each
+    bool instanced = false;
+
+    // Batches are kept from frame to frame so adding parts doesn't allocate once the first frame sized them
+    std::vector<Batch> batches;
+
+    int lastInstances = 0;
+    int lastDrawCalls = 0;
+
+    void add(HandMesh mesh, const Matrix &transform, Color color);
+
+public:
+    // Needs the window's GL context
+    void load();
+    void unload();
+
+    void addSphere(Vector3 center, float radius, Color color);
+    void addCylinder(Vector3 start, Vector3 end, float radius, Color color);
+
+    // Radius at end is startRadius * HAND_TAPER_RATIO
+    void addTaperedCylinder(Vector3 start, Vector3 end, float startRadius, Color color);
+
+    // Transform of a unit cube centered on the origin
+    void addBox(const Matrix &transform, Color color);
+
+    // Draws every part added since the last call, inside BeginMode3D
+    void draw();
+
+    // Parts and draw calls of the last draw()
+    int instanceCount() const { return lastInstances; }
+    int drawCallCount() const { return lastDrawCalls; }
+};
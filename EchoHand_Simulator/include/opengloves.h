@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+// OpenGloves input payload parsing, kept free of raylib so host tools can build and benchmark it
+
+struct OpenGlovesData
+{
+    // Thumb, Index, Middle, Ring, Pinky (0-1)
+    std::array<float, 5> fingerCurl = {0};       
+    
+    // Individual joints
+    std::array<std::array<float, 4>, 5> jointCurl = {{{0}}}; 
+    
+    // Finger splay
+    std::array<float, 5> splay = {0};            
+    
+    float joystickX = 0.0f;
+    float joystickY = 0.0f;
+    bool joystickButton = false;
+    
+    bool buttonTrigger = false;
+    bool buttonA = false;
+    bool buttonB = false;
+    bool buttonGrab = false;
+    bool buttonSystem = false;
+    bool buttonCalibrate = false;
+    
+    float triggerAnalog = 0.0f;
+};
+
+// Updates data with the fields a line has, buttons not in it are released. Single pass over the line, no
+// allocations or logging so the link's I/O thread can parse every packet
+void parseOpenGlovesPayload(std::string_view payload, OpenGlovesData &data);
+void parseOpenGlovesPayload(const char *payload, OpenGlovesData &data);
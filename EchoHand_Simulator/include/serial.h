@@ -1,10 +1,20 @@
 #pragma once
 #include <string>
 #include <cstdint>
-#include <windows.h>
 #include <iostream>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Bytes buffered between the port and readLine(power of 2), a few hundred lines of the glove's output
+#define SERIAL_RING_BYTES 65536
+
+// How long readLine waits for more data before giving up(ms)
+#define SERIAL_READ_TIMEOUT_MS 50
 
 // SerialDevice class for handling serial port communication
+// The port is read in bulk into a ring buffer and lines are split out of it, one read call per burst of data
+// instead of one per character. Win32 uses a COM port handle, Linux/POSIX a termios tty watched with epoll.
 class SerialDevice
 {
     // User Parameters
@@ -15,16 +25,33 @@ class SerialDevice
     int stopbits = 0;
     bool flowcontrol = false;
 
+#ifdef _WIN32
     // Windows Serial COM Stuff
     HANDLE hSerial;
     DCB dcbSerialParams;
     COMMTIMEOUTS timeouts;
+#else
+    // POSIX tty and the epoll instance waiting on it
+    int fd = -1;
+    int epollFd = -1;
+#endif
+
+    // Received bytes not yet returned as lines, head and tail count bytes ever written and read
+    char ring[SERIAL_RING_BYTES];
+    uint32_t head = 0;
+    uint32_t tail = 0;
+
+    // Bytes from tail already searched for a new line
+    uint32_t scanned = 0;
+
+    bool fill();
 
 public:
     SerialDevice(const std::string &portName, unsigned int baudRate, bool parity, int databits, int stopbits, bool flowcontrol);
     ~SerialDevice();
     bool connect();
     std::string readLine();
+    bool readLine(std::string &line);
     bool close();
     bool isConnected();
-};
\ No newline at end of file
+};
@@ -1,36 +1,48 @@
 #include "glove.h"
+#include "handrenderer.h"
 #include <cmath>
-#include <rlgl.h>
 
 // Global state
 static CameraController g_cameraController;
 static OpenGlovesData g_gloveData;
 static ProceduralHand g_hand;
+static HandRenderer g_handRenderer;
 static RenderTexture2D g_renderTarget;
 static bool g_windowInitialized = false;
 
 // Toggle with D key
 static bool g_showProtocolDiagram = false; 
 
+// Link status shown next to the FPS
+static uint64_t g_linkPackets = 0;
+static float g_linkPacketsPerSecond = 0.0f;
+static bool g_linkOpen = false;
+
+// Copies of the hand drawn side by side, all in the glove's pose
+static int g_handCount = 1;
+
+// CPU time of adding and submitting the hands last frame(ms)
+static float g_handDrawMs = 0.0f;
+
 // Draw a smooth capsule between two points
-void DrawSmoothCapsule(Vector3 start, Vector3 end, float radius, Color color)
+void DrawSmoothCapsule(HandRenderer &renderer, Vector3 start, Vector3 end, float radius, Color color)
 {
-    DrawCylinderEx(start, end, radius, radius, 16, color);
-    DrawSphere(start, radius, color);
-    DrawSphere(end, radius, color);
+    renderer.addCylinder(start, end, radius, color);
+    renderer.addSphere(start, radius, color);
+    renderer.addSphere(end, radius, color);
 }
 
 // Draw a joint sphere with highlight
-void DrawJoint(Vector3 pos, float radius, Color baseColor)
+void DrawJoint(HandRenderer &renderer, Vector3 pos, float radius, Color baseColor)
 {
-    DrawSphere(pos, radius, baseColor);
+    renderer.addSphere(pos, radius, baseColor);
     Color highlight = {
         (unsigned char)fmin(255, baseColor.r + 40),
         (unsigned char)fmin(255, baseColor.g + 40),
         (unsigned char)fmin(255, baseColor.b + 40),
         baseColor.a
     };
-    DrawSphere({pos.x, pos.y + radius * 0.3f, pos.z}, radius * 0.6f, highlight);
+    renderer.addSphere({pos.x, pos.y + radius * 0.3f, pos.z}, radius * 0.6f, highlight);
 }
 
 void initProceduralHand(ProceduralHand &hand)
@@ -122,7 +134,7 @@ void updateHandPose(ProceduralHand &hand, const OpenGlovesData &data)
     }
 }
 
-void drawFinger(const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex, Matrix handRotation)
+void drawFinger(HandRenderer &renderer, const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex, Matrix handRotation)
 {
     bool isThumb = (fingerIndex == 0);
     
@@ -146,8 +158,8 @@ void drawFinger(const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex
     if (finger.hasMetacarpal && finger.metacarpal.length > 0.01f)
     {
         Vector3 endPos = Vector3Add(pos, Vector3Scale(dir, finger.metacarpal.length));
-        DrawSmoothCapsule(pos, endPos, finger.metacarpal.radius, finger.metacarpal.color);
-        DrawJoint(endPos, finger.metacarpal.radius * 1.1f, finger.proximal.color);
+        DrawSmoothCapsule(renderer, pos, endPos, finger.metacarpal.radius, finger.metacarpal.color);
+        DrawJoint(renderer, endPos, finger.metacarpal.radius * 1.1f, finger.proximal.color);
         pos = endPos;
         
         Vector3 curlAxis = isThumb ? Vector3{0.0f, 0.0f, 1.0f} : Vector3{1.0f, 0.0f, 0.0f};
@@ -159,8 +171,8 @@ void drawFinger(const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex
     // Proximal
     {
         Vector3 endPos = Vector3Add(pos, Vector3Scale(dir, finger.proximal.length));
-        DrawSmoothCapsule(pos, endPos, finger.proximal.radius, finger.proximal.color);
-        DrawJoint(endPos, finger.proximal.radius * 1.1f, finger.intermediate.color);
+        DrawSmoothCapsule(renderer, pos, endPos, finger.proximal.radius, finger.proximal.color);
+        DrawJoint(renderer, endPos, finger.proximal.radius * 1.1f, finger.intermediate.color);
         pos = endPos;
         
         Vector3 curlAxis = isThumb ? Vector3{0.0f, 0.0f, 1.0f} : Vector3{1.0f, 0.0f, 0.0f};
@@ -172,12 +184,12 @@ void drawFinger(const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex
     // Intermediate
     {
         Vector3 endPos = Vector3Add(pos, Vector3Scale(dir, finger.intermediate.length));
-        DrawSmoothCapsule(pos, endPos, finger.intermediate.radius, finger.intermediate.color);
+        DrawSmoothCapsule(renderer, pos, endPos, finger.intermediate.radius, finger.intermediate.color);
         pos = endPos;
         
         if (!isThumb)
         {
-            DrawJoint(endPos, finger.intermediate.radius * 1.1f, finger.distal.color);
+            DrawJoint(renderer, endPos, finger.intermediate.radius * 1.1f, finger.distal.color);
             Vector3 curlAxis = {1.0f, 0.0f, 0.0f};
             
             // Negative to curl toward palm
@@ -197,18 +209,18 @@ void drawFinger(const ProceduralFinger &finger, Vector3 palmPos, int fingerIndex
     if (!isThumb && finger.distal.length > 0.01f)
     {
         Vector3 endPos = Vector3Add(pos, Vector3Scale(dir, finger.distal.length));
-        DrawSmoothCapsule(pos, endPos, finger.distal.radius, finger.distal.color);
+        DrawSmoothCapsule(renderer, pos, endPos, finger.distal.radius, finger.distal.color);
         Color brightTip = {150, 240, 255, 255};
-        DrawSphere(endPos, finger.distal.radius * 1.2f, brightTip);
+        renderer.addSphere(endPos, finger.distal.radius * 1.2f, brightTip);
     }
     else if (isThumb)
     {
         Color brightTip = {150, 240, 255, 255};
-        DrawSphere(pos, finger.intermediate.radius * 1.3f, brightTip);
+        renderer.addSphere(pos, finger.intermediate.radius * 1.3f, brightTip);
     }
 }
 
-void drawPalm(const ProceduralHand &hand, Matrix handRotation)
+void drawPalm(HandRenderer &renderer, const ProceduralHand &hand, Matrix handRotation)
 {
     Vector3 pos = hand.position;
     Color palmColor = hand.skinColor;
@@ -218,37 +230,36 @@ void drawPalm(const ProceduralHand &hand, Matrix handRotation)
     float w = hand.palmWidth;
     float h = hand.palmHeight;
     
-    // Flat palm box
-    rlPushMatrix();
-    rlTranslatef(pos.x, pos.y, pos.z);
-    rlRotatef(90.0f, 1.0f, 0.0f, 0.0f);
-    DrawCube({0, 0, 0}, w * 1.2f, w * 1.0f, h * 1.5f, palmColor);
-    rlPopMatrix();
+    // Flat palm box, the unit cube scaled, turned flat and moved to the palm
+    Matrix palmBox = MatrixMultiply(MatrixMultiply(MatrixScale(w * 1.2f, w * 1.0f, h * 1.5f), MatrixRotateX(90.0f * DEG2RAD)),
+                                    MatrixTranslate(pos.x, pos.y, pos.z));
+    renderer.addBox(palmBox, palmColor);
     
     // Rounded edges
     float edgeR = h * 0.8f;
     
     Vector3 leftEdge = Vector3Transform({-w * 0.5f, 0.0f, 0.0f}, handRotation);
-    DrawCapsule(Vector3Add(pos, Vector3Add(leftEdge, Vector3Transform({0, -w*0.35f, 0}, handRotation))),
-                Vector3Add(pos, Vector3Add(leftEdge, Vector3Transform({0, w*0.35f, 0}, handRotation))),
-                edgeR, 8, 8, darkColor);
+    DrawSmoothCapsule(renderer, Vector3Add(pos, Vector3Add(leftEdge, Vector3Transform({0, -w*0.35f, 0}, handRotation))),
+                      Vector3Add(pos, Vector3Add(leftEdge, Vector3Transform({0, w*0.35f, 0}, handRotation))),
+                      edgeR, darkColor);
     
     Vector3 rightEdge = Vector3Transform({w * 0.5f, 0.0f, 0.0f}, handRotation);
-    DrawCapsule(Vector3Add(pos, Vector3Add(rightEdge, Vector3Transform({0, -w*0.35f, 0}, handRotation))),
-                Vector3Add(pos, Vector3Add(rightEdge, Vector3Transform({0, w*0.35f, 0}, handRotation))),
-                edgeR, 8, 8, darkColor);
+    DrawSmoothCapsule(renderer, Vector3Add(pos, Vector3Add(rightEdge, Vector3Transform({0, -w*0.35f, 0}, handRotation))),
+                      Vector3Add(pos, Vector3Add(rightEdge, Vector3Transform({0, w*0.35f, 0}, handRotation))),
+                      edgeR, darkColor);
     
-    // Wrist
+    // Wrist, narrowing to HAND_TAPER_RATIO of its base(w * 0.28)
     Vector3 wristStart = Vector3Add(pos, Vector3Transform({0.0f, w * 0.4f, 0.0f}, handRotation));
     Vector3 wristEnd = Vector3Add(pos, Vector3Transform({0.0f, w * 0.7f, 0.0f}, handRotation));
-    DrawCylinderEx(wristStart, wristEnd, w * 0.35f, w * 0.28f, 12, darkColor);
+    renderer.addTaperedCylinder(wristStart, wristEnd, w * 0.35f, darkColor);
     
     // Thumb mount
     Vector3 thumbMount = Vector3Transform({w * 0.45f, 0.12f, 0.0f}, handRotation);
-    DrawSphere(Vector3Add(pos, thumbMount), w * 0.18f, lightColor);
+    renderer.addSphere(Vector3Add(pos, thumbMount), w * 0.18f, lightColor);
 }
 
-void drawProceduralHand(const ProceduralHand &hand)
+// Adds the hand's parts to the renderer, they are drawn with the other hands' by renderer.draw()
+void drawProceduralHand(HandRenderer &renderer, const ProceduralHand &hand)
 {
     if (!hand.isInitialized) 
     {
@@ -257,11 +268,11 @@ void drawProceduralHand(const ProceduralHand &hand)
     
     Matrix handRotation = MatrixRotateX(hand.rotation.x);
     
-    drawPalm(hand, handRotation);
+    drawPalm(renderer, hand, handRotation);
     
     for (int f = 0; f < 5; f++)
     {
-        drawFinger(hand.fingers[f], hand.position, f, handRotation);
+        drawFinger(renderer, hand.fingers[f], hand.position, f, handRotation);
     }
 }
 
@@ -322,65 +333,6 @@ void updateCamera(CameraController &controller, float deltaTime)
     controller.camera.target = Vector3Add(controller.position, lookDir);
 }
 
-void parseOpenGlovesPayload(const char *payload, OpenGlovesData &data)
-{
-    if (!payload || strlen(payload) == 0) return;
-
-    std::string payloadStr(payload);
-
-    std::cout << "Received payload: " << payloadStr << std::endl;
-    
-    // Reset buttons to false before parsing
-    data.joystickButton = false;
-    data.buttonTrigger = false;
-    data.buttonA = false;
-    data.buttonB = false;
-    data.buttonGrab = false;
-    data.buttonSystem = false;
-    data.buttonCalibrate = false;
-    
-    size_t pos = 0;
-    while (pos < payloadStr.length())
-    {
-        while (pos < payloadStr.length() && !isalpha(payloadStr[pos])) pos++;
-        if (pos >= payloadStr.length()) break;
-
-        char key = payloadStr[pos++];
-        
-        size_t valueStart = pos;
-        while (pos < payloadStr.length() && (isdigit(payloadStr[pos]) || payloadStr[pos] == '.')) pos++;
-        
-        float value = 0;
-        if (valueStart < pos)
-        {
-            std::string sub = payloadStr.substr(valueStart, pos - valueStart);
-            char* endPtr;
-            value = strtof(sub.c_str(), &endPtr);
-        }
-
-        switch (key)
-        {
-        case 'A': data.fingerCurl[0] = value / 4095.0f; break;
-        case 'B': data.fingerCurl[1] = value / 4095.0f; break;
-        case 'C': data.fingerCurl[2] = value / 4095.0f; break;
-        case 'D': data.fingerCurl[3] = value / 4095.0f; break;
-        case 'E': data.fingerCurl[4] = value / 4095.0f; break;
-        case 'F': data.joystickX = value / 4095.0f * 2.0f - 1.0f; break;
-        case 'G': data.joystickY = value / 4095.0f * 2.0f - 1.0f; break;
-        case 'H': data.joystickButton = value > 0 || valueStart == pos; break;
-        case 'I': data.buttonTrigger = value > 0 || valueStart == pos; break;
-        case 'J': data.buttonA = value > 0 || valueStart == pos; break;
-        case 'K': data.buttonB = value > 0 || valueStart == pos; break;
-        case 'L': data.buttonGrab = value > 0 || valueStart == pos; break;
-        case 'N': data.buttonSystem = value > 0 || valueStart == pos; break;
-        case 'O': data.buttonCalibrate = value > 0 || valueStart == pos; break;
-        case 'P': data.triggerAnalog = value / 4095.0f; break;
-        default: break;
-        }
-    }
-}
-
-
 void drawUI(const OpenGlovesData &data)
 {
     int y = 10;
@@ -533,6 +485,7 @@ void initGloveRendering()
     std::cout << "Initializing VR glove rendering...\n";
     
     g_renderTarget = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+    g_handRenderer.load();
     initProceduralHand(g_hand);
     
     g_cameraController.position = {0.0f, 0.3f, 1.2f};
@@ -547,6 +500,7 @@ void initGloveRendering()
 
 void cleanupGloveRendering()
 {
+    g_handRenderer.unload();
     UnloadRenderTexture(g_renderTarget);
 }
 
@@ -561,12 +515,28 @@ void updateGloveObject(const std::string &payload)
     updateGloveObject(payload.c_str());
 }
 
-void initializeWindow()
+void applyGloveData(const OpenGlovesData &data)
+{
+    // State already parsed off the render thread(GloveLink)
+    g_gloveData = data;
+    updateHandPose(g_hand, g_gloveData);
+}
+
+void setLinkStats(uint64_t packets, float packetsPerSecond, bool open)
+{
+    g_linkPackets = packets;
+    g_linkPacketsPerSecond = packetsPerSecond;
+    g_linkOpen = open;
+}
+
+void initializeWindow(int targetFps, int handCount)
 {
     if (g_windowInitialized) return;
     
+    g_handCount = handCount > 0 ? handCount : 1;
+    
     InitWindow(1280, 720, "OpenGloves VR Hand Simulator");
-    SetTargetFPS(60);
+    SetTargetFPS(targetFps);
     
     initGloveRendering();
     g_windowInitialized = true;
@@ -594,7 +564,17 @@ void drawGloveObject()
     BeginMode3D(g_cameraController.camera);
     
     DrawGrid(10, 0.2f);
-    drawProceduralHand(g_hand);
+
+    // Every copy goes into the same batches, the draw calls don't grow with the hand count
+    double handStart = GetTime();
+    ProceduralHand hand = g_hand;
+    for (int i = 0; i < g_handCount; i++)
+    {
+        hand.position.x = g_hand.position.x + (i - (g_handCount - 1) * 0.5f) * HAND_SPACING;
+        drawProceduralHand(g_handRenderer, hand);
+    }
+    g_handRenderer.draw();
+    g_handDrawMs = (float)((GetTime() - handStart) * 1000.0);
 
     EndMode3D();
     EndTextureMode();
@@ -612,5 +592,15 @@ void drawGloveObject()
     }
     
     DrawFPS(GetScreenWidth() - 90, 10);
+
+    char linkText[64];
+    snprintf(linkText, sizeof(linkText), "%s  %llu packets  %.0f/s", g_linkOpen ? "Link up" : "Link closed",
+             (unsigned long long)g_linkPackets, g_linkPacketsPerSecond);
+    DrawText(linkText, GetScreenWidth() - MeasureText(linkText, 14) - 10, 34, 14, g_linkOpen ? LIME : RED);
+
+    char handText[96];
+    snprintf(handText, sizeof(handText), "%d %s  %d parts  %d draws  %.2f ms", g_handCount, g_handCount == 1 ? "hand" : "hands",
+             g_handRenderer.instanceCount(), g_handRenderer.drawCallCount(), g_handDrawMs);
+    DrawText(handText, GetScreenWidth() - MeasureText(handText, 14) - 10, 52, 14, GRAY);
     EndDrawing();
 }
\ No newline at end of file
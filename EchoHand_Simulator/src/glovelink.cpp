@@ -0,0 +1,99 @@
+#include "glovelink.h"
+#include <cstring>
+
+void LineBuffer::append(const char *bytes, size_t length)
+{
+    // Drop the lines already taken once they are half the buffer, one move for many lines
+    if (start > 0 && start >= data.size() / 2)
+    {
+        data.erase(data.begin(), data.begin() + start);
+        start = 0;
+    }
+    data.insert(data.end(), bytes, bytes + length);
+
+    // A stream without new lines would grow forever, drop it
+    if (data.size() - start > LINE_BUFFER_MAX_BYTES)
+    {
+        data.clear();
+        start = 0;
+        scanned = 0;
+    }
+}
+
+bool LineBuffer::next(std::string &line)
+{
+    // Search only the bytes that came in since the last search
+    if (start + scanned >= data.size())
+    {
+        return false;
+    }
+    const char *begin = data.data() + start;
+    const char *end = static_cast<const char *>(memchr(begin + scanned, '\n', data.size() - start - scanned));
+    if (end == nullptr)
+    {
+        scanned = data.size() - start;
+        return false;
+    }
+    line.assign(begin, end - begin);
+    start += (end - begin) + 1;
+    scanned = 0;
+    return true;
+}
+
+GloveLink::~GloveLink()
+{
+    stop();
+}
+
+void GloveLink::start(GloveLineSource source)
+{
+    stopRequested = false;
+    open = true;
+    ioThread = std::thread(&GloveLink::run, this, std::move(source));
+}
+
+void GloveLink::stop()
+{
+    // The source has to return for the thread to see the request, close a blocking one(socket) first
+    stopRequested = true;
+    if (ioThread.joinable())
+    {
+        ioThread.join();
+    }
+}
+
+void GloveLink::run(GloveLineSource source)
+{
+    // The parser only updates the fields a line has, so the state carries over from line to line
+    OpenGlovesData state;
+    std::string line;
+    while (!stopRequested)
+    {
+        int result = source(line);
+        if (result < 0)
+        {
+            break;
+        }
+        if (result == 0 || line.empty())
+        {
+            continue;
+        }
+
+        // Every line is parsed, the render loop only sees the newest state
+        parseOpenGlovesPayload(line, state);
+        latest.writeBuffer() = state;
+        latest.publish();
+        packets.fetch_add(1, std::memory_order_relaxed);
+    }
+    open = false;
+}
+
+bool GloveLink::takeLatest(OpenGlovesData &data)
+{
+    if (!latest.update())
+    {
+        return false;
+    }
+    data = latest.read();
+    return true;
+}
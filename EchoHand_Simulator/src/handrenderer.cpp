@@ -0,0 +1,192 @@
+#include "handrenderer.h"
+#include <cmath>
+#include <rlgl.h>
+
+// Per instance model matrix in place of the model uniform, flat color like the DrawSphere/DrawCylinderEx parts had
+static const char *INSTANCING_VS = R"(#version 330
+in vec3 vertexPosition;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+void main()
+{
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char *INSTANCING_FS = R"(#version 330
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = colDiffuse;
+}
+)";
+
+// Cylinder from y = 0(radius 1) to y = 1(radius topRadius) with both caps, the shape DrawCylinderEx draws
+static Mesh genMeshTaperedCylinder(float topRadius, int slices)
+{
+    Mesh mesh = {};
+    mesh.triangleCount = slices * 4;
+    mesh.vertexCount = mesh.triangleCount * 3;
+    mesh.vertices = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+
+    float *v = mesh.vertices;
+    auto vertex = [&v](float x, float y, float z) {
+        *v++ = x;
+        *v++ = y;
+        *v++ = z;
+    };
+    for (int i = 0; i < slices; i++)
+    {
+        float a0 = 2.0f * PI * i / slices;
+        float a1 = 2.0f * PI * (i + 1) / slices;
+        float s0 = sinf(a0), c0 = cosf(a0);
+        float s1 = sinf(a1), c1 = cosf(a1);
+
+        // Side, counter clockwise seen from outside
+        vertex(s0, 0.0f, c0);
+        vertex(s1, 0.0f, c1);
+        vertex(s1 * topRadius, 1.0f, c1 * topRadius);
+        vertex(s0, 0.0f, c0);
+        vertex(s1 * topRadius, 1.0f, c1 * topRadius);
+        vertex(s0 * topRadius, 1.0f, c0 * topRadius);
+
+        // Caps
+        vertex(0.0f, 1.0f, 0.0f);
+        vertex(s0 * topRadius, 1.0f, c0 * topRadius);
+        vertex(s1 * topRadius, 1.0f, c1 * topRadius);
+        vertex(0.0f, 0.0f, 0.0f);
+        vertex(s1, 0.0f, c1);
+        vertex(s0, 0.0f, c0);
+    }
+    UploadMesh(&mesh, false);
+    return mesh;
+}
+
+// Takes a unit mesh along y(0 to 1) onto start-end, scaled to radius across
+static Matrix segmentTransform(Vector3 start, Vector3 end, float radius)
+{
+    Vector3 axis = Vector3Subtract(end, start);
+    float length = Vector3Length(axis);
+    Vector3 y = length > 0.0f ? Vector3Scale(axis, 1.0f / length) : Vector3{0.0f, 1.0f, 0.0f};
+
+    // Any two axes across will do for a round mesh, this keeps the basis right handed so culling still works
+    Vector3 helper = fabsf(y.y) < 0.9f ? Vector3{0.0f, 1.0f, 0.0f} : Vector3{1.0f, 0.0f, 0.0f};
+    Vector3 x = Vector3Normalize(Vector3CrossProduct(helper, y));
+    Vector3 z = Vector3CrossProduct(x, y);
+    return {
+        x.x * radius, y.x * length, z.x * radius, start.x,
+        x.y * radius, y.y * length, z.y * radius, start.y,
+        x.z * radius, y.z * length, z.z * radius, start.z,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+}
+
+void HandRenderer::load()
+{
+    if (loaded) return;
+
+    meshes[HAND_MESH_SPHERE] = GenMeshSphere(1.0f, HAND_SPHERE_RINGS, HAND_SPHERE_SLICES);
+    meshes[HAND_MESH_CYLINDER] = genMeshTaperedCylinder(1.0f, HAND_CYLINDER_SLICES);
+    meshes[HAND_MESH_TAPERED_CYLINDER] = genMeshTaperedCylinder(HAND_TAPER_RATIO, HAND_WRIST_SLICES);
+    meshes[HAND_MESH_CUBE] = GenMeshCube(1.0f, 1.0f, 1.0f);
+
+    material = LoadMaterialDefault();
+
+    // A shader that fails to build comes back as the default one
+    Shader shader = LoadShaderFromMemory(INSTANCING_VS, INSTANCING_FS);
+    instanced = shader.id != rlGetShaderIdDefault();
+    if (instanced)
+    {
+        shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader, "mvp");
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+        material.shader = shader;
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "Hand instancing shader unavailable, drawing parts one by one");
+    }
+    loaded = true;
+}
+
+void HandRenderer::unload()
+{
+    if (!loaded) return;
+
+    for (Mesh &mesh : meshes)
+    {
+        UnloadMesh(mesh);
+    }
+
+    // Unloads the instancing shader too
+    UnloadMaterial(material);
+    batches.clear();
+    loaded = false;
+}
+
+void HandRenderer::add(HandMesh mesh, const Matrix &transform, Color color)
+{
+    // A hand has about a dozen mesh and color pairs, a linear search beats hashing them
+    for (Batch &batch : batches)
+    {
+        if (batch.mesh == mesh && ColorToInt(batch.color) == ColorToInt(color))
+        {
+            batch.transforms.push_back(transform);
+            return;
+        }
+    }
+    batches.push_back({mesh, color, {transform}});
+}
+
+void HandRenderer::addSphere(Vector3 center, float radius, Color color)
+{
+    add(HAND_MESH_SPHERE, {radius, 0.0f, 0.0f, center.x, 0.0f, radius, 0.0f, center.y, 0.0f, 0.0f, radius, center.z, 0.0f, 0.0f, 0.0f, 1.0f}, color);
+}
+
+void HandRenderer::addCylinder(Vector3 start, Vector3 end, float radius, Color color)
+{
+    add(HAND_MESH_CYLINDER, segmentTransform(start, end, radius), color);
+}
+
+void HandRenderer::addTaperedCylinder(Vector3 start, Vector3 end, float startRadius, Color color)
+{
+    add(HAND_MESH_TAPERED_CYLINDER, segmentTransform(start, end, startRadius), color);
+}
+
+void HandRenderer::addBox(const Matrix &transform, Color color)
+{
+    add(HAND_MESH_CUBE, transform, color);
+}
+
+void HandRenderer::draw()
+{
+    lastInstances = 0;
+    lastDrawCalls = 0;
+    if (!loaded) return;
+
+    for (Batch &batch : batches)
+    {
+        if (batch.transforms.empty()) continue;
+
+        material.maps[MATERIAL_MAP_DIFFUSE].color = batch.color;
+        const Mesh &mesh = meshes[batch.mesh];
+        int count = (int)batch.transforms.size();
+        if (instanced)
+        {
+            DrawMeshInstanced(mesh, material, batch.transforms.data(), count);
+            lastDrawCalls++;
+        }
+        else
+        {
+            for (const Matrix &transform : batch.transforms)
+            {
+                DrawMesh(mesh, material, transform);
+            }
+            lastDrawCalls += count;
+        }
+        lastInstances += count;
+
+        // Keeps the capacity for the next frame
+        batch.transforms.clear();
+    }
+}
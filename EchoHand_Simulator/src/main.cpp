@@ -23,6 +23,7 @@
 #undef DrawTextEx
 
 #include "glove.h"
+#include "glovelink.h"
 
 // Standard C libraries for mem management and io
 #include <stdlib.h>
@@ -32,6 +33,44 @@
 #include <iostream>
 #include <unistd.h>
 
+// Seconds between updates of the packet rate shown in the window
+#define LINK_RATE_PERIOD_S 0.5
+
+// Draws frames at the target rate until the user closes the window, picking up the newest glove state each frame
+static void runRenderLoop(GloveLink &link, int targetFps, int handCount)
+{
+    initializeWindow(targetFps, handCount);
+
+    OpenGlovesData data;
+    uint64_t ratePackets = 0;
+    double rateTime = GetTime();
+    float packetsPerSecond = 0.0f;
+
+    // Only break if user wants to close window(either alt-f4, ESC or close button)
+    while (!userAttemptedClose())
+    {
+        if (link.takeLatest(data))
+        {
+            applyGloveData(data);
+        }
+
+        double now = GetTime();
+        uint64_t packets = link.packetCount();
+        if (now - rateTime >= LINK_RATE_PERIOD_S)
+        {
+            packetsPerSecond = (packets - ratePackets) / (now - rateTime);
+            ratePackets = packets;
+            rateTime = now;
+        }
+        setLinkStats(packets, packetsPerSecond, link.isOpen());
+
+        // Draw the updated scene (MUST be called every frame!)
+        drawGloveObject();
+    }
+    cleanupGloveRendering();
+    CloseWindow();
+}
+
 int main(int argc, char *argv[])
 {
     // Check if user wants to either serial port or TCP connection
@@ -49,8 +88,31 @@ int main(int argc, char *argv[])
     // Seventh arg: Flow control (0 = none, 1 = hardware, 2 = software)
     // Second possible arg: --tcp or -t to use TCP connection (default)
     // first arg(not required): PORT number (usually 4000)
+    // Last args(not required): --fps and the render frame rate (60 default, 144 for fast monitors)
+    // and --hands and the number of hands drawn side by side (1 default, more to check the frame time)
     */
 
+    // Render frame rate, independent of how fast the glove sends
+    int targetFps = 60;
+    int handCount = 1;
+    while (argc >= 3)
+    {
+        std::string option = argv[argc - 2];
+        if (option == "--fps")
+        {
+            targetFps = std::stoi(argv[argc - 1]);
+        }
+        else if (option == "--hands")
+        {
+            handCount = std::stoi(argv[argc - 1]);
+        }
+        else
+        {
+            break;
+        }
+        argc -= 2;
+    }
+
     // Making variable to hold serial or tcp parameters if needed
     std::string portName;
     unsigned int baudRate = 115200;
@@ -69,13 +131,17 @@ int main(int argc, char *argv[])
             useTCPConnection = false;
             if (argc != 8)
             {
-                std::cout << "Usage: " << argv[0] << " --serial <PORT_NAME> <BAUD_RATE> <PARITY> <DATA_BITS> <STOP_BITS> <FLOW_CONTROL>\n";
-                std::cout << "Example: " << argv[0] << " --serial COM3 115200 0 8 1 0\n";
+                std::cout << "Usage: " << argv[0] << " --serial <PORT_NAME> <BAUD_RATE> <PARITY> <DATA_BITS> <STOP_BITS> <FLOW_CONTROL> [--fps <RATE>] [--hands <COUNT>]\n";
+                std::cout << "Example: " << argv[0] << " --serial COM3 115200 0 8 1 0 --fps 144\n";
                 return -1;
             }
             else
             {
+#ifdef _WIN32
                 portName = R"(\\.\)" + std::string(argv[2]);
+#else
+                portName = argv[2];
+#endif
                 baudRate = std::stoi(argv[3]);
                 parity = (std::stoi(argv[4]) != 0);
                 databits = std::stoi(argv[5]);
@@ -96,70 +162,44 @@ int main(int argc, char *argv[])
         else
         {
             std::cout << "Invalid argument: " << firstArg << "\n";
-            std::cout << "Usage: " << argv[0] << " [--serial | --tcp]\n";
+            std::cout << "Usage: " << argv[0] << " [--serial | --tcp] [--fps <RATE>] [--hands <COUNT>]\n";
             return -1;
         }
     }
     printf("Starting OpenGloves Echo Hand Simulator...\n");
     printf("Using serial port: %s\n", portName.c_str());
 
-    // Declare Raylib initialization flag
-    bool isRaylibInit = false;
-
+    // Every line is parsed on the link's I/O thread, the window renders the newest state at its own frame rate
+    GloveLink link;
     if (useTCPConnection)
     {
-        Socket EchoHandSocket = Socket(4000);
+        Socket EchoHandSocket = Socket(portNumber);
         if (!EchoHandSocket.connect())
         {
             return -1;
         }
-        else
-        {
-            char echoHandPayload[256];
-            std::string dataBuffer = "";
 
-            // Now let's get the TCP continuous stream of data from the simulated ESP32
-            // Keeping receing data until an error or disconnection occurs(aka not 0)
-            while (EchoHandSocket.receiveData(echoHandPayload, 256))
+        // Now let's get the TCP continuous stream of data from the simulated ESP32
+        // Keeping receing data until an error or disconnection occurs(aka not 0)
+        auto nextLine = [&EchoHandSocket, lines = LineBuffer()](std::string &line) mutable -> int
+        {
+            while (!lines.next(line))
             {
-                dataBuffer += echoHandPayload;
-
-                // Process all complete lines in the buffer
-                size_t pos = 0;
-                while ((pos = dataBuffer.find('\n')) != std::string::npos)
+                char echoHandPayload[256];
+                if (!EchoHandSocket.receiveData(echoHandPayload, sizeof(echoHandPayload)))
                 {
-                    std::string line = dataBuffer.substr(0, pos);
-                    dataBuffer.erase(0, pos + 1);
-
-                    // Update glove object with the complete line
-                    if (!line.empty())
-                    {
-                        updateGloveObject(line);
-                    }
-                }
-
-                // Create or update Raylib scene
-                if (!isRaylibInit)
-                {
-                    // Create scene once and never again
-                    isRaylibInit = true;
-                    initializeWindow();
-                    drawGloveObject();
-                }
-                else
-                {
-                    // Only break if user wants to close window(either alt-f4, ESC or close button)
-                    if (userAttemptedClose())
-                    {
-                        break;
-                    }
-                    // Draw the updated scene (MUST be called every frame!)
-                    drawGloveObject();
+                    return -1;
                 }
+                lines.append(echoHandPayload, strlen(echoHandPayload));
             }
-            EchoHandSocket.closeConnection();
-            return 0;
-        }
+            return 1;
+        };
+        link.start(nextLine);
+        runRenderLoop(link, targetFps, handCount);
+
+        // Closing the socket wakes the I/O thread out of recv
+        EchoHandSocket.closeConnection();
+        link.stop();
     }
     else
     {
@@ -168,46 +208,27 @@ int main(int argc, char *argv[])
         {
             return -1;
         }
-        else
+
+        // Now let's get the serial continuous stream of data from the real ESP32
+        // readLine times out every SERIAL_READ_TIMEOUT_MS so the I/O thread sees a stop request
+        auto nextLine = [&serialDevice](std::string &line) -> int
         {
-            // Now let's get the serial continuous stream of data from the real ESP32
-            while (serialDevice.isConnected())
+            if (serialDevice.readLine(line))
             {
-                std::string echoHandPayload = serialDevice.readLine();
-                if (!echoHandPayload.empty())
-                {
-                    // Create or update Raylib scene
-                    if (!isRaylibInit)
-                    {
-                        // Create scene once and never again
-                        isRaylibInit = true;
-                        initializeWindow();
-                        drawGloveObject();
-                    }
-                    else
-                    {
-                        // Only break if user wants to close window(either alt-f4, ESC or close button)
-                        if (userAttemptedClose())
-                        {
-                            break;
-                        }
-                        // Update glove object with new payload data
-                        updateGloveObject(echoHandPayload);
-                        // Draw the updated scene (MUST be called every frame!)
-                        drawGloveObject();
-                    }
-                }
+                return 1;
             }
+            return serialDevice.isConnected() ? 0 : -1;
+        };
+        link.start(nextLine);
+        runRenderLoop(link, targetFps, handCount);
+        link.stop();
+        if (serialDevice.isConnected())
+        {
             serialDevice.close();
-            return 0;
         }
     }
-    // Close Raylib window if open
-    if (isRaylibInit)
-    {
-        CloseWindow();
-    }
+
     // Exit program
     printf("Exiting OpenGloves Echo Hand Simulator...\n");
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#include "opengloves.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Powers of ten a float holds exactly(5^10 < 2^24), for the exact fast path of decimal fields
+static const float exactPowersOfTen[11] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+// Letters start a field, same set as isalpha() in the C locale
+static inline bool isKey(char c)
+{
+    return (unsigned char)((c | 0x20) - 'a') < 26;
+}
+
+static inline bool isDigit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+// Value of a field's digits and dots, what strtof() makes of them: the leading number, 0 if there is none
+// Integers and short decimals are decoded by hand and rounded once like strtof(), anything longer goes through
+// strtof() from a stack copy
+static float parseValue(std::string_view text)
+{
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int fractionDigits = 0;
+    size_t pos = 0;
+    while (pos < text.size() && isDigit(text[pos]))
+    {
+        mantissa = mantissa * 10 + (text[pos++] - '0');
+        digits++;
+    }
+    if (pos < text.size() && text[pos] == '.')
+    {
+        pos++;
+        while (pos < text.size() && isDigit(text[pos]))
+        {
+            mantissa = mantissa * 10 + (text[pos++] - '0');
+            digits++;
+            fractionDigits++;
+        }
+    }
+    if (digits == 0)
+    {
+        return 0.0f;
+    }
+
+    // Both operands exact in a float, the one division rounds like strtof()
+    if (digits <= 19 && mantissa < (1u << 24) && fractionDigits < 11)
+    {
+        return (float)mantissa / exactPowersOfTen[fractionDigits];
+    }
+
+    // Long number, rare enough that strtof() on a copy doesn't matter(only a number of 64+ characters allocates)
+    char copy[64];
+    if (pos < sizeof(copy))
+    {
+        memcpy(copy, text.data(), pos);
+        copy[pos] = '\0';
+        return strtof(copy, nullptr);
+    }
+    return strtof(std::string(text.substr(0, pos)).c_str(), nullptr);
+}
+
+void parseOpenGlovesPayload(std::string_view payload, OpenGlovesData &data)
+{
+    if (payload.empty()) return;
+
+    // Reset buttons to false before parsing
+    data.joystickButton = false;
+    data.buttonTrigger = false;
+    data.buttonA = false;
+    data.buttonB = false;
+    data.buttonGrab = false;
+    data.buttonSystem = false;
+    data.buttonCalibrate = false;
+
+    // One pass: skip to a letter, take the digits and dots after it as its value
+    size_t pos = 0;
+    while (pos < payload.size())
+    {
+        while (pos < payload.size() && !isKey(payload[pos])) pos++;
+        if (pos >= payload.size()) break;
+
+        char key = payload[pos++];
+
+        size_t valueStart = pos;
+        while (pos < payload.size() && (isDigit(payload[pos]) || payload[pos] == '.')) pos++;
+
+        // A key without digits is a pressed button
+        bool bare = valueStart == pos;
+        float value = bare ? 0.0f : parseValue(payload.substr(valueStart, pos - valueStart));
+
+        switch (key)
+        {
+        case 'A': data.fingerCurl[0] = value / 4095.0f; break;
+        case 'B': data.fingerCurl[1] = value / 4095.0f; break;
+        case 'C': data.fingerCurl[2] = value / 4095.0f; break;
+        case 'D': data.fingerCurl[3] = value / 4095.0f; break;
+        case 'E': data.fingerCurl[4] = value / 4095.0f; break;
+        case 'F': data.joystickX = value / 4095.0f * 2.0f - 1.0f; break;
+        case 'G': data.joystickY = value / 4095.0f * 2.0f - 1.0f; break;
+        case 'H': data.joystickButton = value > 0 || bare; break;
+        case 'I': data.buttonTrigger = value > 0 || bare; break;
+        case 'J': data.buttonA = value > 0 || bare; break;
+        case 'K': data.buttonB = value > 0 || bare; break;
+        case 'L': data.buttonGrab = value > 0 || bare; break;
+        case 'N': data.buttonSystem = value > 0 || bare; break;
+        case 'O': data.buttonCalibrate = value > 0 || bare; break;
+        case 'P': data.triggerAnalog = value / 4095.0f; break;
+        default: break;
+        }
+    }
+}
+
+void parseOpenGlovesPayload(const char *payload, OpenGlovesData &data)
+{
+    if (!payload) return;
+    parseOpenGlovesPayload(std::string_view(payload), data);
+}
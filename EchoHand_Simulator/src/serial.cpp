@@ -1,4 +1,12 @@
 #include "serial.h"
+#include <cstring>
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
 
 SerialDevice::SerialDevice(const std::string &portName, unsigned int baudRate, bool parity, int databits, int stopbits, bool flowcontrol)
 {
@@ -8,14 +16,20 @@ SerialDevice::SerialDevice(const std::string &portName, unsigned int baudRate, b
     this->databits = databits;
     this->stopbits = stopbits;
     this->flowcontrol = flowcontrol;
+#ifdef _WIN32
     hSerial = INVALID_HANDLE_VALUE;
+#endif
 }
 
 SerialDevice::~SerialDevice()
 {
     // Destructor implementation(simple making sure port is closed)
-    close();
+    if (isConnected())
+    {
+        close();
+    }
 }
+#ifdef _WIN32
 bool SerialDevice::connect()
 {
     // Open serial port using windows stuff
@@ -67,10 +81,11 @@ bool SerialDevice::connect()
         }
     }
 
-    // Set timeouts
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
+    // Set timeouts, a read returns as soon as any bytes are in and waits at most SERIAL_READ_TIMEOUT_MS for the
+    // first one(MAXDWORD interval and multiplier is the documented "return what's there" combination)
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant = SERIAL_READ_TIMEOUT_MS;
+    timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
     timeouts.WriteTotalTimeoutConstant = 50;
     timeouts.WriteTotalTimeoutMultiplier = 10;
 
@@ -86,36 +101,28 @@ bool SerialDevice::connect()
     return true;
 }
 
-std::string SerialDevice::readLine()
+bool SerialDevice::fill()
 {
-    // Read a line from the serial port
-    std::string line;
-    char ch;
+    // Read whatever arrived into the free part of the ring up to its end
     DWORD bytesRead;
-
-    // Read character until we reach a null terminator or error/no data
-    // Else we keep adding to our running string line
-    while (true)
+    uint32_t start = head & (SERIAL_RING_BYTES - 1);
+    uint32_t space = SERIAL_RING_BYTES - (head - tail);
+    DWORD length = space < SERIAL_RING_BYTES - start ? space : SERIAL_RING_BYTES - start;
+    if (!ReadFile(hSerial, ring + start, length, &bytesRead, NULL) || bytesRead == 0)
     {
-        if (!ReadFile(hSerial, &ch, 1, &bytesRead, NULL) || bytesRead == 0)
-        {
-            // Error or no data
-            break;
-        }
-        if (ch == '\n')
-        {
-            // End of line(TRON)
-            break;
-        }
-        line += ch;
+        // Error or no data
+        return false;
     }
-    return line;
+    head += bytesRead;
+    return true;
 }
+
 bool SerialDevice::close()
 {
     // Close the serial port
     if (isConnected() && CloseHandle(hSerial))
     {
+        hSerial = INVALID_HANDLE_VALUE;
         std::cout << "Serial port closed successfully" << std::endl;
         return true;
     }
@@ -129,4 +136,188 @@ bool SerialDevice::isConnected()
 {
     // Check if the serial port is connected
     return hSerial != INVALID_HANDLE_VALUE;
-}
\ No newline at end of file
+}
+#else
+bool SerialDevice::connect()
+{
+    // Open the tty without it becoming our controlling terminal, reads never block(epoll does the waiting)
+    fd = open(portName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        std::cerr << "Error opening serial port: " << portName << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    std::cout << "Serial port opened successfully: " << portName << std::endl;
+
+    // Raw mode: no line editing, echo or translation of '\r'/'\n', the firmware's bytes as they are
+    termios tty;
+    if (tcgetattr(fd, &tty) != 0)
+    {
+        std::cerr << "Error getting current serial parameters" << std::endl;
+    }
+    else
+    {
+        cfmakeraw(&tty);
+
+        // Same meaning as the DCB fields on Windows: parity on is odd parity, 2 stop bits sets two
+        speed_t speed;
+        switch (baudRate)
+        {
+        case 9600: speed = B9600; break;
+        case 19200: speed = B19200; break;
+        case 38400: speed = B38400; break;
+        case 57600: speed = B57600; break;
+        case 230400: speed = B230400; break;
+        case 460800: speed = B460800; break;
+        case 921600: speed = B921600; break;
+        default: speed = B115200; break;
+        }
+        cfsetispeed(&tty, speed);
+        cfsetospeed(&tty, speed);
+        tty.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+        tty.c_cflag |= (databits == 7 ? CS7 : CS8) | CLOCAL | CREAD;
+        tty.c_cflag |= parity ? PARENB | PARODD : 0;
+        tty.c_cflag |= stopbits == 2 ? CSTOPB : 0;
+        tty.c_cflag |= flowcontrol ? CRTSCTS : 0;
+
+        // cfmakeraw's VMIN 1 makes an empty non-blocking read fail with EAGAIN, VMIN 0 would return 0 like a hang up
+        tty.c_cc[VMIN] = 1;
+        tty.c_cc[VTIME] = 0;
+
+        if (tcsetattr(fd, TCSANOW, &tty) != 0)
+        {
+            std::cerr << "Error setting serial port parameters" << std::endl;
+            close();
+            return false;
+        }
+        std::cout << "Serial port parameters set successfully" << std::endl;
+    }
+
+    // Wait for input with epoll, readLine only sleeps when the ring has no complete line
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        std::cerr << "Error watching serial port" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SerialDevice::fill()
+{
+    uint32_t start = head & (SERIAL_RING_BYTES - 1);
+    uint32_t space = SERIAL_RING_BYTES - (head - tail);
+    size_t length = space < SERIAL_RING_BYTES - start ? space : SERIAL_RING_BYTES - start;
+
+    // Try the read first, while data is streaming that's the only syscall per burst
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        ssize_t bytesRead = read(fd, ring + start, length);
+        if (bytesRead > 0)
+        {
+            head += bytesRead;
+            return true;
+        }
+        if (bytesRead == 0 || (errno != EAGAIN && errno != EINTR))
+        {
+            // Port went away(unplugged glove, closed pty)
+            std::cerr << "Serial port disconnected: " << portName << std::endl;
+            close();
+            return false;
+        }
+
+        // Nothing there yet, wait for some
+        epoll_event event;
+        if (attempt == 0 && epoll_wait(epollFd, &event, 1, SERIAL_READ_TIMEOUT_MS) <= 0)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool SerialDevice::close()
+{
+    // Close the serial port
+    if (!isConnected())
+    {
+        std::cerr << "Error closing serial port" << std::endl;
+        return false;
+    }
+    if (epollFd >= 0)
+    {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+    ::close(fd);
+    fd = -1;
+    std::cout << "Serial port closed successfully" << std::endl;
+    return true;
+}
+
+bool SerialDevice::isConnected()
+{
+    // Check if the serial port is connected
+    return fd >= 0;
+}
+#endif
+
+bool SerialDevice::readLine(std::string &line)
+{
+    // Read a line from the serial port, without its '\n'
+    // False if no complete line came in within the timeout, a partial line stays buffered for the next call
+    while (true)
+    {
+        // Look for the end of line(TRON) in the bytes not searched yet, the ring may wrap once
+        uint32_t buffered = head - tail;
+        while (scanned < buffered)
+        {
+            uint32_t start = (tail + scanned) & (SERIAL_RING_BYTES - 1);
+            uint32_t length = buffered - scanned < SERIAL_RING_BYTES - start ? buffered - scanned : SERIAL_RING_BYTES - start;
+            const char *end = static_cast<const char *>(memchr(ring + start, '\n', length));
+            if (end == NULL)
+            {
+                scanned += length;
+                continue;
+            }
+
+            // Copy the line out in up to two pieces and drop it and its '\n' from the ring
+            uint32_t lineLength = scanned + (uint32_t)(end - (ring + start));
+            uint32_t first = tail & (SERIAL_RING_BYTES - 1);
+            uint32_t firstLength = lineLength < SERIAL_RING_BYTES - first ? lineLength : SERIAL_RING_BYTES - first;
+            line.assign(ring + first, firstLength);
+            line.append(ring, lineLength - firstLength);
+            tail += lineLength + 1;
+            scanned = 0;
+            return true;
+        }
+
+        // A full ring without a new line isn't OpenGloves data, hand it over as one line so it gets rejected
+        if (buffered == SERIAL_RING_BYTES)
+        {
+            uint32_t first = tail & (SERIAL_RING_BYTES - 1);
+            line.assign(ring + first, SERIAL_RING_BYTES - first);
+            line.append(ring, first);
+            tail = head;
+            scanned = 0;
+            return true;
+        }
+
+        if (!isConnected() || !fill())
+        {
+            return false;
+        }
+    }
+}
+
+std::string SerialDevice::readLine()
+{
+    // Empty if no line came in within the timeout
+    std::string line;
+    readLine(line);
+    return line;
+}
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# Compares two microbenchmark runs(Google Benchmark JSON from host/HotPathBench or the glove's HOT_PATH_BENCHMARK
+# log, the JSON is taken from between the BENCH JSON lines) and flags benchmarks that got slower.
+# Usage: bench_compare.py baseline.json|log candidate.json|log [threshold %]
+import json, sys
+
+BEGIN, END = "--- BENCH JSON BEGIN ---", "--- BENCH JSON END ---"
+
+def load(path):
+    text = open(path, encoding='utf-8', errors='ignore').read()
+    if BEGIN in text:
+        text = text.split(BEGIN, 1)[1].split(END, 1)[0]
+    doc = json.loads(text)
+    return doc.get('context', {}), {b['name']: b for b in doc['benchmarks']}
+
+def main():
+    if len(sys.argv) < 3:
+        print("usage: bench_compare.py baseline.json|log candidate.json|log [threshold %]")
+        sys.exit(2)
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 5.0
+    base_ctx, base = load(sys.argv[1])
+    cand_ctx, cand = load(sys.argv[2])
+    if base_ctx.get('target') != cand_ctx.get('target'):
+        print(f"Note: comparing {base_ctx.get('target')} against {cand_ctx.get('target')}")
+
+    ticks = base_ctx.get('clock') == cand_ctx.get('clock') == 'cpu_cycles'
+    unit = 'cycles' if ticks else 'ns'
+    key = 'ticks_per_iteration' if ticks else 'real_time'
+    print(f"{'benchmark':36} {'base ' + unit:>14} {'new ' + unit:>14} {'change':>9}")
+    slower = 0
+    for name in list(base) + [n for n in cand if n not in base]:
+        if name not in base or name not in cand:
+            print(f"{name:36} {'-' if name not in base else base[name][key]:>14} {'-' if name not in cand else cand[name][key]:>14}")
+            continue
+        old, new = base[name][key], cand[name][key]
+        change = (new - old) / old * 100 if old else 0.0
+        flag = "  SLOWER" if change > threshold else ("  faster" if change < -threshold else "")
+        slower += change > threshold
+        print(f"{name:36} {old:14.1f} {new:14.1f} {change:+8.1f}%{flag}")
+
+    print(f"\n{slower} benchmark(s) more than {threshold:.0f}% slower")
+    sys.exit(1 if slower else 0)
+
+if __name__ == "__main__":
+    main()